@@ -0,0 +1,159 @@
+#include "DualGPS.h"
+#include <math.h>
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+DualGPS::DualGPS(Ublox_GPS *primary, Ublox_GPS *secondary) {
+  _gps[0] = primary;
+  _gps[1] = secondary;
+  for (int i = 0; i < 2; i++) {
+    memset(&_state[i], 0, sizeof(GPSReceiverState));
+    _configured[i] = false;
+    _lastPVT[i] = 0s;
+    _lastConfigure[i] = 0s;
+  }
+  _blend = true;
+  _source = DGPS_NO_FIX;
+  _failovers = 0;
+  _clock.start();
+}
+
+DualGPS::~DualGPS() {
+
+}
+
+// Status: Ready for testing
+int DualGPS::begin() {
+  int n = 0;
+  for (int i = 0; i < 2; i++)
+    if (configure(i)) n++;
+  return n;
+}
+
+/* Neither read() blocks: with autoPVT on, getPVT only drains what the
+ * receiver has already queued, and an absent receiver fails on the first
+ * NAK. So a dead receiver costs microseconds and the other one's fix is
+ * used in the same epoch.
+ */
+// Status: Ready for testing
+int DualGPS::update(GPSFix &fix) {
+  read(0);
+  read(1);
+  int source = choose(_state[0], _state[1], _blend, fix);
+  if ((source != DGPS_NO_FIX) && (_source != DGPS_NO_FIX) && (source != _source))
+    _failovers++;
+  if (source != DGPS_NO_FIX) _source = source;
+  return source;
+}
+
+void DualGPS::set_blending(bool blend) {
+  _blend = blend;
+}
+
+bool DualGPS::receiver(int index, GPSReceiverState &state) {
+  if ((index < 0) || (index > 1)) return false;
+  state = _state[index];
+  return true;
+}
+
+uint32_t DualGPS::failovers() {
+  return _failovers;
+}
+
+bool DualGPS::configure(int index) {
+  _lastConfigure[index] = _clock.elapsed_time();
+  _configured[index] = _gps[index]->setAutoPVT(true);
+  return _configured[index];
+}
+
+void DualGPS::read(int index) {
+  Ublox_GPS *gps = _gps[index];
+  GPSReceiverState &s = _state[index];
+  std::chrono::microseconds now = _clock.elapsed_time();
+
+  if (!_configured[index] && (now - _lastConfigure[index] >= std::chrono::seconds(DGPS_RETRY_S)))
+    configure(index);
+
+  if (_configured[index] && gps->getPVT(0)) {
+    s.fixType = gps->getFixType();
+    s.pDOP = gps->getPDOP();
+    s.hAcc = gps->getHorizontalAccEst();
+    s.vAcc = gps->getVerticalAccEst();
+    FixHistory::from_receiver(gps, s.fix);
+    _lastPVT[index] = now;
+  }
+  s.fresh = _configured[index] && (_lastPVT[index] > 0s) &&
+    (now - _lastPVT[index] < std::chrono::milliseconds(DGPS_STALE_MS));
+
+  // A receiver that browns out comes back without autoPVT, so one that has
+  // sent nothing for DGPS_STALE_MS since it was last configured is
+  // configured again (every DGPS_RETRY_S until it answers).
+  std::chrono::microseconds last = (_lastPVT[index] > _lastConfigure[index]) ? _lastPVT[index] : _lastConfigure[index];
+  if (_configured[index] && (now - last >= std::chrono::milliseconds(DGPS_STALE_MS)))
+    _configured[index] = false;
+}
+
+bool DualGPS::usable(const GPSReceiverState &r) {
+  return r.fresh && r.fix.positionFix && (r.fix.SIV >= DGPS_MIN_SIV);
+}
+
+/* Blending weights are inverse variances, written as the other receiver's
+ * variance over the sum so equal accuracies give an even split. The blend
+ * is applied to the difference between the two fixes so nothing overflows.
+ */
+// Status: Ready for testing
+int DualGPS::choose(const GPSReceiverState &a, const GPSReceiverState &b, bool blend, GPSFix &fix) {
+  bool useA = usable(a);
+  bool useB = usable(b);
+  if (!useA && !useB) {
+    fix = b.fresh && !a.fresh ? b.fix : a.fix;
+    fix.positionFix = false;
+    return DGPS_NO_FIX;
+  }
+  if (!useB) {
+    fix = a.fix;
+    return DGPS_PRIMARY;
+  }
+  if (!useA) {
+    fix = b.fix;
+    return DGPS_SECONDARY;
+  }
+
+  bool bBetter = (b.hAcc < a.hAcc) ||
+    ((b.hAcc == a.hAcc) && ((b.fix.SIV > a.fix.SIV) || ((b.fix.SIV == a.fix.SIV) && (b.pDOP < a.pDOP))));
+  const GPSReceiverState &best = bBetter ? b : a;
+  fix = best.fix;
+  int source = bBetter ? DGPS_SECONDARY : DGPS_PRIMARY;
+  if (!blend) return source;
+
+  // 1e-7 degree of latitude is 11.132 mm
+  float dLat = (float)((int64_t)b.fix.latitude - a.fix.latitude);
+  float dLon = (float)((int64_t)b.fix.longitude - a.fix.longitude);
+  float dN = dLat * 11.132f;
+  float dE = dLon * 11.132f * cosf(a.fix.latitude * 1.0e-7f * 0.017453293f);
+  float dH = (float)((int64_t)b.fix.altitudeMSL - a.fix.altitudeMSL);
+  float hGate = DGPS_GATE * ((float)a.hAcc + (float)b.hAcc);
+  float vGate = DGPS_GATE * ((float)a.vAcc + (float)b.vAcc);
+  if ((sqrtf(dN * dN + dE * dE) > hGate) || (fabsf(dH) > vGate)) return source;
+
+  float ha2 = (float)a.hAcc * a.hAcc;
+  float hb2 = (float)b.hAcc * b.hAcc;
+  float va2 = (float)a.vAcc * a.vAcc;
+  float vb2 = (float)b.vAcc * b.vAcc;
+  float wH = (ha2 + hb2 > 0) ? ha2 / (ha2 + hb2) : 0.5f;    // weight of b
+  float wV = (va2 + vb2 > 0) ? va2 / (va2 + vb2) : 0.5f;
+  fix.latitude = a.fix.latitude + (int32_t)lroundf(dLat * wH);
+  fix.longitude = a.fix.longitude + (int32_t)lroundf(dLon * wH);
+  fix.altitudeMSL = a.fix.altitudeMSL + (int32_t)lroundf(dH * wV);
+  fix.verticalVelocity = a.fix.verticalVelocity +
+    (int32_t)lroundf((float)(b.fix.verticalVelocity - a.fix.verticalVelocity) * wV);
+  return DGPS_BLENDED;
+}
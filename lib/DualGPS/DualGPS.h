@@ -0,0 +1,121 @@
+/** Two GPS receivers on the shared I2C bus with failover and blending
+ *
+ * One receiver dropping out at altitude (cold antenna connector, brownout,
+ * a receiver lock-up) used to blank the track until it recovered. DualGPS
+ * runs two receivers with periodic NAV-PVT output (autoPVT), so reading
+ * either one never waits on a poll, and picks the fix each epoch:
+ *
+ *  - a receiver is usable if its last NAV-PVT is under DGPS_STALE_MS old,
+ *    it has a 3D (or GNSS + dead reckoning) fix and at least DGPS_MIN_SIV
+ *    satellites
+ *  - if only one is usable its fix is used, so failover takes effect on
+ *    the first epoch after the other stops answering; a receiver that has
+ *    stopped answering is configured again every DGPS_RETRY_S, in case a
+ *    brownout reset its autoPVT setting
+ *  - if both are usable and agree within their accuracy estimates, the
+ *    positions are blended by inverse variance (hAcc for latitude and
+ *    longitude, vAcc for altitude and vertical velocity); otherwise the one
+ *    with the smaller hAcc (then more satellites, then lower PDOP) wins
+ *
+ * The receivers need different I2C addresses. The second receiver's address
+ * is changed once on the bench with Ublox_GPS::setI2CAddress (e.g. to 0x43)
+ * and saved to its flash.
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef DualGPS_H
+#define DualGPS_H
+
+#include <mbed.h>
+#include "SBDmessage.h"
+#include "ublox.h"
+#include "FixHistory.h"
+
+#define DGPS_STALE_MS 1500          // NAV-PVT older than this is not used (1.5 epochs at 1 Hz)
+#define DGPS_MIN_SIV 4              // fewer satellites than this is not a usable fix
+#define DGPS_GATE 3                 // blend only if the fixes agree within this many (summed) accuracy estimates
+#define DGPS_RETRY_S 10             // how often a receiver that failed to configure or went stale is retried
+
+// update() results
+#define DGPS_PRIMARY 0
+#define DGPS_SECONDARY 1
+#define DGPS_BLENDED 2
+#define DGPS_NO_FIX -1
+
+/** Latest navigation solution from one receiver
+ */
+struct GPSReceiverState {
+  GPSFix fix;
+  uint8_t fixType;          // as getFixType
+  uint16_t pDOP;            // * 0.01
+  uint32_t hAcc;            // mm
+  uint32_t vAcc;            // mm
+  bool fresh;               // NAV-PVT received within DGPS_STALE_MS
+};
+
+class DualGPS {
+
+public:
+  /** Create a manager for two receivers
+   *
+   * @param primary Receiver preferred when the two are equally good
+   * @param secondary Second receiver (different I2C address)
+   */
+  DualGPS(Ublox_GPS *primary, Ublox_GPS *secondary);
+
+  ~DualGPS();
+
+  /** Turn on periodic NAV-PVT output on both receivers
+   *
+   * @returns number of receivers configured (0, 1 or 2)
+   */
+  int begin();
+
+  /** Read whatever both receivers have sent and choose this epoch's fix
+   *
+   * @param fix Filled in with the chosen (or blended) fix; positionFix is
+   *    false if neither receiver is usable
+   * @returns DGPS_PRIMARY, DGPS_SECONDARY, DGPS_BLENDED or DGPS_NO_FIX
+   */
+  int update(GPSFix &fix);
+
+  /** Allow or prevent blending (selection only when off) */
+  void set_blending(bool blend);
+
+  /** Latest state of one receiver (0 = primary, 1 = secondary) */
+  bool receiver(int index, GPSReceiverState &state);
+
+  /** Number of times the chosen source changed between primary, secondary
+   * and blended (in either direction; epochs with no fix are skipped)
+   */
+  uint32_t failovers();
+
+  /** True if a receiver's state is good enough to use */
+  static bool usable(const GPSReceiverState &r);
+
+  /** Choose or blend two receiver states (the decision made by update)
+   *
+   * @returns DGPS_PRIMARY, DGPS_SECONDARY, DGPS_BLENDED or DGPS_NO_FIX
+   */
+  static int choose(const GPSReceiverState &a, const GPSReceiverState &b, bool blend, GPSFix &fix);
+
+private:
+  Ublox_GPS *_gps[2];
+  GPSReceiverState _state[2];
+  bool _configured[2];
+  Timer _clock;
+  std::chrono::microseconds _lastPVT[2];
+  std::chrono::microseconds _lastConfigure[2];
+  bool _blend;
+  int _source;
+  uint32_t _failovers;
+
+  bool configure(int index);
+  void read(int index);
+};
+
+#endif
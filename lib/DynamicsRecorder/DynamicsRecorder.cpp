@@ -0,0 +1,135 @@
+#include "DynamicsRecorder.h"
+#include <math.h>
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+DynamicsRecorder::DynamicsRecorder(Ublox_GPS *gps) {
+  _gps = gps;
+  _recording = false;
+  _pollingWait = 0ms;
+  _newest = DYN_RING_SIZE - 1;
+  _count = 0;
+  _summary = {0, 0, 0};
+}
+
+DynamicsRecorder::~DynamicsRecorder() {
+
+}
+
+// Status: Ready for testing
+bool DynamicsRecorder::start(uint8_t rate) {
+  if (!_recording) _pollingWait = _gps->getI2CpollingWait();
+  if (!_gps->setHNRNavigationRate(rate)) return false;
+  _recording = _gps->subscribe(UBX_CLASS_HNR, UBX_HNR_PVT, callback(this, &DynamicsRecorder::packet_received));
+  if (!_recording) _gps->setI2CpollingWait(_pollingWait);
+  return _recording;
+}
+
+// Status: Ready for testing
+bool DynamicsRecorder::stop() {
+  if (_recording) _gps->setI2CpollingWait(_pollingWait);
+  _recording = false;
+  return _gps->unsubscribe(UBX_CLASS_HNR, UBX_HNR_PVT);
+}
+
+bool DynamicsRecorder::recording() {
+  return _recording;
+}
+
+// Status: Ready for testing
+DynamicsSummary DynamicsRecorder::take_summary() {
+  _mutex.lock();
+  DynamicsSummary summary = _summary;
+  _summary = {0, 0, 0};
+  _mutex.unlock();
+  return summary;
+}
+
+// Status: Ready for testing
+bool DynamicsRecorder::get(int age, DynamicsSample &s) {
+  _mutex.lock();
+  const DynamicsSample *p = sample(age);
+  if (p) s = *p;
+  _mutex.unlock();
+  return p != NULL;
+}
+
+int DynamicsRecorder::count() {
+  return _count;
+}
+
+const DynamicsSample *DynamicsRecorder::sample(int age) {
+  if ((age < 0) || (age >= _count)) return NULL;
+  return &_ring[(_newest - age + DYN_RING_SIZE) % DYN_RING_SIZE];
+}
+
+void DynamicsRecorder::packet_received(const ubxPacket *msg) {
+  UBX_HNR_PVT_data_t pvt;
+  if (msg->len < sizeof(pvt)) return;
+  memcpy(&pvt, msg->payload, sizeof(pvt));
+  add(pvt);
+}
+
+/* HNR-PVT has no vertical velocity. Its size comes from the 3D and ground
+ * speeds and its sign from the height change over the last DYN_SIGN_SPAN
+ * solutions. Near the top of the flight the height-change rate is smaller
+ * than the speeds suggest, so it is used instead; otherwise the sign would
+ * flip late and show up as a false acceleration spike. Acceleration is the change in velocity over DYN_ACCEL_SPAN
+ * solutions, which keeps solution-to-solution noise out of the peak.
+ */
+// Status: Ready for testing
+void DynamicsRecorder::add(const UBX_HNR_PVT_data_t &pvt) {
+  if (!(pvt.flags & 0x01)) return;   // gpsFixOK
+
+  DynamicsSample s;
+  s.iTOW = pvt.iTOW;
+  s.hMSL = pvt.hMSL;
+  float heading = pvt.headMot * 1.0e-5f * 0.017453293f;
+  s.velN = (int16_t)(pvt.gSpeed * cosf(heading) / 10);
+  s.velE = (int16_t)(pvt.gSpeed * sinf(heading) / 10);
+  int64_t vz2 = (int64_t)pvt.speed * pvt.speed - (int64_t)pvt.gSpeed * pvt.gSpeed;
+  int32_t vz = (vz2 > 0) ? (int32_t)sqrtf((float)vz2) : 0;
+
+  _mutex.lock();
+  const DynamicsSample *back = sample(_count < DYN_SIGN_SPAN ? _count - 1 : DYN_SIGN_SPAN - 1);
+  int32_t velD = -vz;
+  if (back != NULL) {
+    uint32_t dt = s.iTOW - back->iTOW;
+    if ((dt > 0) && (dt < DYN_MAX_GAP_MS)) {
+      int32_t rate = (int32_t)(((int64_t)back->hMSL - s.hMSL) * 1000 / (int32_t)dt);   // mm/s, positive down
+      if (rate > vz) velD = vz;
+      else if (rate < -vz) velD = -vz;
+      else velD = rate;
+    }
+  }
+  bool descending = velD > 0;
+  s.velD = (int16_t)(velD / 10);
+
+  const DynamicsSample *prev = sample(_count < DYN_ACCEL_SPAN ? _count - 1 : DYN_ACCEL_SPAN - 1);
+  if (prev != NULL) {
+    uint32_t dt = s.iTOW - prev->iTOW;   // ms (wraps correctly at the end of the week)
+    if ((dt > 0) && (dt < DYN_MAX_GAP_MS)) {
+      float dN = s.velN - prev->velN;
+      float dE = s.velE - prev->velE;
+      float dD = s.velD - prev->velD;
+      // cm/s per ms --> mm/s^2 is a factor of 10 * 1000
+      uint32_t accel = (uint32_t)(sqrtf(dN * dN + dE * dE + dD * dD) * 10000.0f / dt);
+      if (accel > _summary.peakAcceleration) _summary.peakAcceleration = accel;
+    }
+  }
+  if (descending && (velD > _summary.maxDescentRate)) _summary.maxDescentRate = velD;
+  if (_summary.samples < 0xFFFF) _summary.samples++;
+
+  _newest = (_newest + 1) % DYN_RING_SIZE;
+  _ring[_newest] = s;
+  if (_count < DYN_RING_SIZE) _count++;
+  _mutex.unlock();
+}
@@ -0,0 +1,107 @@
+/** High rate navigation (HNR) recorder for burst and descent
+ *
+ * 1 Hz PVT misses most of what happens at burst and in the first minutes of
+ * descent. During those phases the recorder turns on HNR-PVT (up to 30 Hz
+ * on ADR/UDR receivers), keeps the latest solutions in a small RAM ring and
+ * tracks the peak acceleration and fastest descent. Only that summary goes
+ * into the next SBD frame (see SBDmessage::generateDynamicsBytes), so the
+ * high rate data never has to be sent over Iridium.
+ *
+ * Typical use:
+ *    recorder.start(30);                 // at burst
+ *    ...
+ *    msg->generateDynamicsBytes(recorder.take_summary());   // each frame
+ *    ...
+ *    recorder.stop();                    // a few minutes into descent
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef DynamicsRecorder_H
+#define DynamicsRecorder_H
+
+#include <mbed.h>
+#include "SBDmessage.h"
+#include "ublox.h"
+
+#ifndef DYN_RING_SIZE
+#define DYN_RING_SIZE 64            // solutions kept (about 2 s at 30 Hz)
+#endif
+#define DYN_ACCEL_SPAN 3            // acceleration is taken over this many solutions
+#define DYN_SIGN_SPAN 6             // climb/descent is decided over this many solutions
+#define DYN_MAX_GAP_MS 1000         // solutions further apart are not differenced
+
+/** One high rate solution (velocities in cm/s to keep the ring small)
+ */
+struct DynamicsSample {
+  uint32_t iTOW;      // GPS time of week (ms)
+  int32_t hMSL;       // mm above mean sea level
+  int16_t velN;       // cm/s
+  int16_t velE;       // cm/s
+  int16_t velD;       // cm/s (positive downward)
+};
+
+class DynamicsRecorder {
+
+public:
+  /** Create a recorder for the given receiver
+   *
+   * @param gps Pointer to the receiver (must support HNR-PVT)
+   */
+  DynamicsRecorder(Ublox_GPS *gps);
+
+  ~DynamicsRecorder();
+
+  /** Start high rate output and recording
+   *
+   * @param rate HNR-PVT rate in Hz (1-30)
+   * @returns true if the receiver accepted the rate and the message
+   */
+  bool start(uint8_t rate = 30);
+
+  /** Stop HNR-PVT output (the ring and summary are kept)
+   *
+   * The I2C polling wait the receiver had before start() is put back, since
+   * setHNRNavigationRate shortens it to keep up with the high rate.
+   */
+  bool stop();
+
+  /** True between start() and stop() */
+  bool recording();
+
+  /** Return the summary since the last call and start a new one
+   */
+  DynamicsSummary take_summary();
+
+  /** Get a solution from the ring
+   *
+   * @param age 0 for the newest solution, 1 for the one before, ...
+   * @returns true if there is a solution of that age
+   */
+  bool get(int age, DynamicsSample &sample);
+
+  /** Number of solutions in the ring */
+  int count();
+
+  /** Add one HNR-PVT solution (called from Ublox_GPS::checkUblox)
+   */
+  void add(const UBX_HNR_PVT_data_t &pvt);
+
+private:
+  Ublox_GPS *_gps;
+  Mutex _mutex;
+  bool _recording;
+  std::chrono::milliseconds _pollingWait;   // receiver's I2C polling wait before start()
+  DynamicsSample _ring[DYN_RING_SIZE];
+  int _newest;
+  int _count;
+  DynamicsSummary _summary;
+
+  void packet_received(const ubxPacket *msg);
+  const DynamicsSample *sample(int age);
+};
+
+#endif
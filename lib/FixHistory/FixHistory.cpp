@@ -0,0 +1,111 @@
+#include "FixHistory.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+FixHistory::FixHistory() {
+  clear();
+}
+
+FixHistory::~FixHistory() {
+
+}
+
+// Status: Ready for testing
+void FixHistory::add(const GPSFix &fix) {
+  _newest = (_newest + 1) % FIX_HISTORY_SIZE;
+  _fixes[_newest] = fix;
+  if (_count < FIX_HISTORY_SIZE) _count++;
+  _total++;
+}
+
+// Status: Ready for testing
+void FixHistory::add_batch_entry(const UBX_LOG_BATCH_data_t &entry) {
+  GPSFix fix;
+  from_batch(entry, fix);
+  add(fix);
+}
+
+// Status: Ready for testing
+int FixHistory::drain(Ublox_GPS *gps, uint16_t maxWait) {
+  return gps->retrieveBatch(callback(this, &FixHistory::add_batch_entry), maxWait);
+}
+
+// Status: Ready for testing
+bool FixHistory::get(int age, GPSFix &fix) {
+  if ((age < 0) || (age >= _count)) return false;
+  fix = _fixes[(_newest - age + FIX_HISTORY_SIZE) % FIX_HISTORY_SIZE];
+  return true;
+}
+
+int FixHistory::count() {
+  return _count;
+}
+
+uint32_t FixHistory::total() {
+  return _total;
+}
+
+void FixHistory::clear() {
+  _newest = FIX_HISTORY_SIZE - 1;
+  _count = 0;
+  _total = 0;
+}
+
+// Status: Ready for testing
+bool FixHistory::position_fix(uint8_t fixType, bool gnssFixOk) {
+  return gnssFixOk && ((fixType == 3) || (fixType == 4));
+}
+
+// Status: Ready for testing
+void FixHistory::from_batch(const UBX_LOG_BATCH_data_t &entry, GPSFix &fix) {
+  fix.positionFix = position_fix(entry.fixType, entry.flags & 0x01);
+  fix.SIV = entry.numSV;
+  fix.syncTime = 0;
+  if ((entry.valid & 0x03) == 0x03) {
+    struct tm t;
+    t.tm_year = entry.year - 1900;
+    t.tm_mon = entry.month - 1;
+    t.tm_mday = entry.day;
+    t.tm_hour = entry.hour;
+    t.tm_min = entry.min;
+    t.tm_sec = entry.sec;
+    if (!_rtc_maketime(&t, &fix.syncTime, RTC_FULL_LEAP_YEAR_SUPPORT))
+      fix.syncTime = 0;
+  }
+  fix.latitude = entry.lat;
+  fix.longitude = entry.lon;
+  fix.altitudeMSL = entry.hMSL;
+  fix.verticalVelocity = entry.velD;
+  fix.groundSpeed = entry.gSpeed;
+  fix.heading = entry.headMot;
+}
+
+// Status: Ready for testing
+void FixHistory::from_receiver(Ublox_GPS *gps, GPSFix &fix) {
+  uint8_t fixType = gps->getFixType();
+  fix.positionFix = position_fix(fixType, gps->getGnssFixOk());
+  fix.SIV = gps->getSIV();
+  fix.latitude = gps->getLatitude();
+  fix.longitude = gps->getLongitude();
+  fix.altitudeMSL = gps->getAltitudeMSL();
+  fix.verticalVelocity = gps->getVerticalVelocity();
+  fix.groundSpeed = gps->getGroundSpeed();
+  fix.heading = gps->getHeading();
+  struct tm t;
+  t.tm_year = gps->getYear() - 1900;
+  t.tm_mon = gps->getMonth() - 1;
+  t.tm_mday = gps->getDay();
+  t.tm_hour = gps->getHour();
+  t.tm_min = gps->getMinute();
+  t.tm_sec = gps->getSecond();
+  if (!_rtc_maketime(&t, &fix.syncTime, RTC_FULL_LEAP_YEAR_SUPPORT))
+    fix.syncTime = 0;
+}
@@ -0,0 +1,97 @@
+/** Recent GPS fixes kept in RAM
+ *
+ * A ring buffer of GPSFix snapshots, newest first. Fixes are added one at a
+ * time from live navigation solutions, or in bulk from the receiver's batch
+ * buffer (UBX-CFG-BATCH): the receiver stores an entry every navigation
+ * epoch while the LPC1768 sleeps and drain() decodes the whole batch into
+ * the history, giving a dense ascent track without waking at the navigation
+ * rate.
+ *
+ * Typical use:
+ *    gps.setNavigationFrequency(2);
+ *    gps.setBatching(true, 128);
+ *    ...                       // sleep
+ *    history.drain(&gps);      // one bulk read of everything buffered
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef FixHistory_H
+#define FixHistory_H
+
+#include <mbed.h>
+#include "SBDmessage.h"
+#include "ublox.h"
+
+#ifndef FIX_HISTORY_SIZE
+#define FIX_HISTORY_SIZE 32         // fixes kept (about 40 bytes each)
+#endif
+
+class FixHistory {
+
+public:
+  FixHistory();
+
+  ~FixHistory();
+
+  /** Add a fix (it becomes the newest entry, replacing the oldest if full)
+   */
+  void add(const GPSFix &fix);
+
+  /** Add one batched epoch from the receiver
+   */
+  void add_batch_entry(const UBX_LOG_BATCH_data_t &entry);
+
+  /** Drain the receiver's batch buffer into the history
+   *
+   * @param gps Receiver with batching enabled (see Ublox_GPS::setBatching)
+   * @param maxWait Timeout (ms) for the whole batch
+   * @returns number of fixes added or -1 if the receiver did not answer
+   */
+  int drain(Ublox_GPS *gps, uint16_t maxWait = 2000);
+
+  /** Get a fix from the history
+   *
+   * @param age 0 for the newest fix, 1 for the one before, ...
+   * @param fix Filled in if the fix exists
+   * @returns true if there is a fix of that age
+   */
+  bool get(int age, GPSFix &fix);
+
+  /** Number of fixes in the history */
+  int count();
+
+  /** Number of fixes added since the history was created or cleared */
+  uint32_t total();
+
+  /** Forget every fix */
+  void clear();
+
+  /** Whether a receiver solution counts as a position fix
+   *
+   * Used for both batched and live fixes: a 3D (or GNSS + dead reckoning)
+   * solution with gnssFixOK set. 2D fixes have no usable altitude.
+   */
+  static bool position_fix(uint8_t fixType, bool gnssFixOk);
+
+  /** Convert a batched epoch to a fix snapshot
+   */
+  static void from_batch(const UBX_LOG_BATCH_data_t &entry, GPSFix &fix);
+
+  /** Fill a fix snapshot from the receiver's latest NAV-PVT fields
+   *
+   * Uses the Ublox_GPS getters, so it polls only if those fields are stale.
+   */
+  static void from_receiver(Ublox_GPS *gps, GPSFix &fix);
+
+private:
+  GPSFix _fixes[FIX_HISTORY_SIZE];
+  int _newest;
+  int _count;
+  uint32_t _total;
+};
+
+#endif
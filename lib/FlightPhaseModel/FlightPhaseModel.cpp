@@ -0,0 +1,216 @@
+#include "FlightPhaseModel.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+FlightPhaseModel::FlightPhaseModel(Ublox_GPS *gps) {
+  _gps = gps;
+  for (int i = 0; i < FPM_PHASE_COUNT; i++) {
+    _model[i] = default_model((FlightPhase)i);
+    _measRate[i] = 0;
+  }
+  _measRate[FPM_PHASE_BURST] = 250;   // 4 Hz through burst
+  _measRate[FPM_PHASE_DESCENT] = 1000;
+  _measRate[FPM_PHASE_LANDED] = 1000;
+  _phase = FPM_PHASE_PAD;
+  _applied = false;
+  _qualityCount = 0;
+  _qualityNext = 0;
+  _scoring = false;
+  _padHeight = INT32_MIN;
+  _peakHeight = INT32_MIN;
+  _burstTime = 0;
+  _confirm = 0;
+  for (int i = 0; i < FPM_PHASE_COUNT; i++) _switched[i] = false;
+}
+
+FlightPhaseModel::~FlightPhaseModel() {
+
+}
+
+DynamicModel_e FlightPhaseModel::default_model(FlightPhase phase) {
+  switch (phase) {
+    case FPM_PHASE_PAD:
+      return DYN_MODEL_STATIONARY;
+    case FPM_PHASE_ASCENT:
+    case FPM_PHASE_DESCENT:
+      return DYN_MODEL_AIRBORNE1g;
+    case FPM_PHASE_BURST:
+      return DYN_MODEL_AIRBORNE4g;
+    default:
+      return DYN_MODEL_PORTABLE;
+  }
+}
+
+void FlightPhaseModel::configure(FlightPhase phase, DynamicModel_e model, uint16_t measRate) {
+  if ((phase < 0) || (phase >= FPM_PHASE_COUNT)) return;
+  _model[phase] = model;
+  _measRate[phase] = measRate;
+}
+
+// Status: Ready for testing
+bool FlightPhaseModel::begin() {
+  _phase = FPM_PHASE_PAD;
+  _qualityCount = 0;
+  _qualityNext = 0;
+  _scoring = false;
+  _padHeight = INT32_MIN;
+  _peakHeight = INT32_MIN;
+  _burstTime = 0;
+  _confirm = 0;
+  for (int i = 0; i < FPM_PHASE_COUNT; i++) _switched[i] = false;
+  return apply();
+}
+
+// Status: Ready for testing
+bool FlightPhaseModel::update(const GPSFix &fix) {
+  uint32_t hAcc = 0;
+  uint32_t vAcc = 0;
+  if (_gps != NULL) {
+    hAcc = _gps->getHorizontalAccEst();
+    vAcc = _gps->getVerticalAccEst();
+  }
+  return update(fix, hAcc, vAcc);
+}
+
+// Status: Ready for testing
+bool FlightPhaseModel::update(const GPSFix &fix, uint32_t hAcc, uint32_t vAcc) {
+  if (!fix.positionFix) return false;
+  if (!_applied) apply();
+  add_quality(hAcc, vAcc);
+  FlightPhase next = detect(fix);
+  if (next == _phase) return false;
+  set_phase(next, fix.syncTime);
+  return true;
+}
+
+// Status: Ready for testing
+bool FlightPhaseModel::set_phase(FlightPhase phase, time_t time) {
+  if ((phase < 0) || (phase >= FPM_PHASE_COUNT)) return false;
+  if (phase == _phase) return _applied || apply();
+  _phase = phase;
+  _confirm = 0;
+  if (phase == FPM_PHASE_BURST) _burstTime = time;
+  start_report(time);
+  return apply();
+}
+
+FlightPhase FlightPhaseModel::phase() {
+  return _phase;
+}
+
+bool FlightPhaseModel::applied() {
+  return _applied;
+}
+
+bool FlightPhaseModel::report(FlightPhase phase, ModelSwitchReport &r) {
+  if ((phase < 0) || (phase >= FPM_PHASE_COUNT) || !_switched[phase]) return false;
+  r = _reports[phase];
+  return true;
+}
+
+void FlightPhaseModel::attach(Callback<void(FlightPhase, const ModelSwitchReport &)> cb) {
+  _cb = cb;
+}
+
+bool FlightPhaseModel::apply() {
+  if (_gps == NULL) {
+    _applied = true;
+    return true;
+  }
+  _applied = _gps->setNavigationModel(_model[_phase], _measRate[_phase]);
+  return _applied;
+}
+
+/* The fixes before the switch are whatever is in the rolling window (fewer
+ * than FPM_QUALITY_WINDOW right after a previous switch). The after window
+ * only counts fixes made once the receiver has accepted the new model.
+ */
+void FlightPhaseModel::start_report(time_t time) {
+  ModelSwitchReport &r = _reports[_phase];
+  uint64_t hSum = 0;
+  uint64_t vSum = 0;
+  for (int i = 0; i < _qualityCount; i++) {
+    hSum += _hAcc[i];
+    vSum += _vAcc[i];
+  }
+  r.model = _model[_phase];
+  r.time = time;
+  r.hAccBefore = _qualityCount ? hSum / _qualityCount : 0;
+  r.vAccBefore = _qualityCount ? vSum / _qualityCount : 0;
+  r.hAccAfter = 0;
+  r.vAccAfter = 0;
+  r.complete = false;
+  _switched[_phase] = true;
+  _qualityCount = 0;
+  _qualityNext = 0;
+  _scoring = true;
+}
+
+void FlightPhaseModel::add_quality(uint32_t hAcc, uint32_t vAcc) {
+  if (_scoring && !_applied) return;
+  _hAcc[_qualityNext] = hAcc;
+  _vAcc[_qualityNext] = vAcc;
+  _qualityNext = (_qualityNext + 1) % FPM_QUALITY_WINDOW;
+  if (_qualityCount < FPM_QUALITY_WINDOW) _qualityCount++;
+  if (!_scoring || (_qualityCount < FPM_QUALITY_WINDOW)) return;
+
+  ModelSwitchReport &r = _reports[_phase];
+  uint64_t hSum = 0;
+  uint64_t vSum = 0;
+  for (int i = 0; i < FPM_QUALITY_WINDOW; i++) {
+    hSum += _hAcc[i];
+    vSum += _vAcc[i];
+  }
+  r.hAccAfter = hSum / FPM_QUALITY_WINDOW;
+  r.vAccAfter = vSum / FPM_QUALITY_WINDOW;
+  r.complete = true;
+  _scoring = false;
+  if (_cb) _cb(_phase, r);
+}
+
+/* Stationary assumes zero velocity, so on the pad lift-off is mostly seen
+ * as height gained. Every change except leaving the burst model (which is
+ * timed) must hold for several fixes so one bad solution cannot switch.
+ */
+// Status: Ready for testing
+FlightPhase FlightPhaseModel::detect(const GPSFix &fix) {
+  bool condition = false;
+  switch (_phase) {
+    case FPM_PHASE_PAD:
+      if (_padHeight == INT32_MIN) _padHeight = fix.altitudeMSL;
+      condition = (fix.altitudeMSL - _padHeight > FPM_LIFTOFF_HEIGHT) ||
+        (fix.verticalVelocity < -FPM_LIFTOFF_CLIMB);
+      if (!condition) break;
+      if (++_confirm >= FPM_CONFIRM_FIXES) return FPM_PHASE_ASCENT;
+      return _phase;
+    case FPM_PHASE_ASCENT:
+      if (fix.altitudeMSL > _peakHeight) _peakHeight = fix.altitudeMSL;
+      condition = (fix.verticalVelocity > FPM_BURST_DESCENT) ||
+        (_peakHeight - fix.altitudeMSL > FPM_BURST_DROP);
+      if (!condition) break;
+      if (++_confirm >= FPM_CONFIRM_FIXES) return FPM_PHASE_BURST;
+      return _phase;
+    case FPM_PHASE_BURST:
+      if (_burstTime == 0) _burstTime = fix.syncTime;
+      if (fix.syncTime - _burstTime >= FPM_BURST_HOLD) return FPM_PHASE_DESCENT;
+      return _phase;
+    case FPM_PHASE_DESCENT:
+      condition = (abs(fix.verticalVelocity) < FPM_LANDED_SPEED) &&
+        (fix.groundSpeed < FPM_LANDED_SPEED);
+      if (!condition) break;
+      if (++_confirm >= FPM_LANDED_FIXES) return FPM_PHASE_LANDED;
+      return _phase;
+    default:
+      return _phase;
+  }
+  _confirm = 0;
+  return _phase;
+}
@@ -0,0 +1,158 @@
+/** Automatic GPS dynamic model switching by flight phase
+ *
+ * No single dynamic platform model suits a whole flight. Stationary gives
+ * the tightest position on the pad (a better launch height), airborne <1g
+ * tracks the ascent, airborne <4g survives the jolt of burst and portable
+ * is right once the payload is on the ground. FlightPhaseModel follows the
+ * flight from the fixes it is given and changes the receiver's model (and
+ * navigation rate) at each phase change with Ublox_GPS::setNavigationModel,
+ * a single CFG-VALSET on newer receivers.
+ *
+ * Each switch is scored: the mean NAV-PVT accuracy estimates over
+ * FPM_QUALITY_WINDOW fixes before and after the switch are kept in a
+ * ModelSwitchReport, so the fix-quality gain of every switch can be logged
+ * or sent down.
+ *
+ * Typical use (once per fix):
+ *    phases.update(fix);       // reads hAcc/vAcc from the receiver
+ *    if (phases.report(FPM_PHASE_ASCENT, r) && r.complete) ...
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef FlightPhaseModel_H
+#define FlightPhaseModel_H
+
+#include <mbed.h>
+#include "SBDmessage.h"
+#include "ublox.h"
+
+#define FPM_QUALITY_WINDOW 10       // fixes averaged before and after a switch
+#define FPM_LIFTOFF_HEIGHT 30000    // mm above the pad that means lift-off
+#define FPM_LIFTOFF_CLIMB 2000      // mm/s sustained climb that also means lift-off
+#define FPM_BURST_DESCENT 5000      // mm/s of descent that means burst
+#define FPM_BURST_DROP 200000       // mm below the peak that also means burst
+#define FPM_BURST_HOLD 180          // s to stay in the burst model
+#define FPM_LANDED_SPEED 1000       // mm/s (vertical and ground) counted as stopped
+#define FPM_CONFIRM_FIXES 3         // fixes a lift-off or burst condition must hold
+#define FPM_LANDED_FIXES 30         // stopped fixes before declaring landed
+
+enum FlightPhase {
+  FPM_PHASE_PAD = 0,
+  FPM_PHASE_ASCENT,
+  FPM_PHASE_BURST,
+  FPM_PHASE_DESCENT,
+  FPM_PHASE_LANDED,
+  FPM_PHASE_COUNT
+};
+
+/** Score of one model switch (accuracy estimates in mm, smaller is better)
+ */
+struct ModelSwitchReport {
+  DynamicModel_e model;     // model switched to
+  time_t time;              // fix time of the switch
+  uint32_t hAccBefore;      // mean over the fixes before the switch
+  uint32_t vAccBefore;
+  uint32_t hAccAfter;       // mean over FPM_QUALITY_WINDOW fixes after it
+  uint32_t vAccAfter;
+  bool complete;            // false until the after window has filled
+};
+
+class FlightPhaseModel {
+
+public:
+  /** Create a switcher for the given receiver
+   *
+   * @param gps Pointer to the receiver (NULL tracks phases without
+   *    configuring anything, e.g. to replay a flight log)
+   */
+  FlightPhaseModel(Ublox_GPS *gps);
+
+  ~FlightPhaseModel();
+
+  /** Change the model and navigation rate used for a phase
+   *
+   * @param phase Flight phase
+   * @param model Dynamic platform model for that phase
+   * @param measRate Measurement period (ms) or 0 to leave the rate alone
+   */
+  void configure(FlightPhase phase, DynamicModel_e model, uint16_t measRate = 0);
+
+  /** Apply the pad model and forget the flight so far
+   *
+   * @returns true if the receiver accepted the model
+   */
+  bool begin();
+
+  /** Feed the latest fix, reading the accuracy estimates from the receiver
+   *
+   * @returns true if the phase changed on this fix
+   */
+  bool update(const GPSFix &fix);
+
+  /** Feed the latest fix with its accuracy estimates
+   *
+   * @param fix Latest fix
+   * @param hAcc Horizontal accuracy estimate (mm)
+   * @param vAcc Vertical accuracy estimate (mm)
+   * @returns true if the phase changed on this fix
+   */
+  bool update(const GPSFix &fix, uint32_t hAcc, uint32_t vAcc);
+
+  /** Force a phase (e.g. landed when the flight computer knows better)
+   *
+   * @returns true if the receiver accepted the phase's model
+   */
+  bool set_phase(FlightPhase phase, time_t time = 0);
+
+  /** Current phase */
+  FlightPhase phase();
+
+  /** True once the receiver has accepted the current phase's model */
+  bool applied();
+
+  /** Get the report for the switch into a phase
+   *
+   * @returns true if that switch has happened
+   */
+  bool report(FlightPhase phase, ModelSwitchReport &r);
+
+  /** Called with each report once its after window has filled */
+  void attach(Callback<void(FlightPhase, const ModelSwitchReport &)> cb);
+
+  /** Default model for each phase */
+  static DynamicModel_e default_model(FlightPhase phase);
+
+private:
+  Ublox_GPS *_gps;
+  FlightPhase _phase;
+  bool _applied;
+  DynamicModel_e _model[FPM_PHASE_COUNT];
+  uint16_t _measRate[FPM_PHASE_COUNT];
+  ModelSwitchReport _reports[FPM_PHASE_COUNT];
+  bool _switched[FPM_PHASE_COUNT];
+  Callback<void(FlightPhase, const ModelSwitchReport &)> _cb;
+
+  // Accuracy window (before a switch it rolls; after it fills once)
+  uint32_t _hAcc[FPM_QUALITY_WINDOW];
+  uint32_t _vAcc[FPM_QUALITY_WINDOW];
+  int _qualityCount;
+  int _qualityNext;
+  bool _scoring;
+
+  // Detection state
+  int32_t _padHeight;
+  int32_t _peakHeight;
+  time_t _burstTime;
+  int _confirm;
+
+  bool apply();
+  void start_report(time_t time);
+  void add_quality(uint32_t hAcc, uint32_t vAcc);
+  FlightPhase detect(const GPSFix &fix);
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include "GPSCapabilityCache.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+/* Entry layout in FRAM (see docs/FRAM.adoc)
+ *   0     state (GPSC_ENTRY_VALID if in use)
+ *   1-6   chip ID from SEC-UNIQID
+ *   7     protocol version (high)
+ *   8     protocol version (low)
+ *   9     flags (GPSC_FLAG_)
+ *   10-11 supported messages (UBX_CAP_ bits)
+ *   12-14 reserved
+ *   15    checksum (8-bit sum of bytes 1-14)
+ */
+
+// Status: Ready for testing
+GPSCapabilityCache::GPSCapabilityCache(Cypress_FRAM *fram, Ublox_GPS *gps) {
+  _fram = fram;
+  _gps = gps;
+  _cached = false;
+  _entry = -1;
+}
+
+GPSCapabilityCache::~GPSCapabilityCache() {
+
+}
+
+uint16_t GPSCapabilityCache::entry_address(int entry) {
+  return GPSC_ENTRY_ADDRESS + entry * GPSC_ENTRY_SIZE;
+}
+
+uint8_t GPSCapabilityCache::checksum(const char *entry) {
+  uint8_t sum = 0;
+  for (int i = 1; i < GPSC_ENTRY_SIZE - 1; i++)
+    sum += (uint8_t)entry[i];
+  return sum;
+}
+
+// Status: Ready for testing
+int GPSCapabilityCache::begin() {
+  FRAM_Response_Read_Uint16 magic = _fram->read_uint16(GPSC_BASE_ADDRESS);
+  if (magic.status != FRAM_SUCCESS) return magic.status;
+  char info[2];
+  int status = _fram->read(GPSC_BASE_ADDRESS + 2, info, 2);
+  if (status != FRAM_SUCCESS) return status;
+  if ((magic.data != GPSC_MAGIC) || (info[0] != GPSC_VERSION) || (info[1] != GPSC_MAX_ENTRIES))
+    return format();
+  return GPSC_SUCCESS;
+}
+
+// Status: Ready for testing
+int GPSCapabilityCache::format() {
+  int status;
+  for (int i = 0; i < GPSC_MAX_ENTRIES; i++) {
+    status = _fram->write(entry_address(i), (char)0);
+    if (status != FRAM_SUCCESS) return status;
+  }
+  char header[5];
+  header[0] = GPSC_MAGIC >> 8;
+  header[1] = GPSC_MAGIC & 0xFF;
+  header[2] = GPSC_VERSION;
+  header[3] = GPSC_MAX_ENTRIES;
+  header[4] = 0;   // next entry to replace
+  _entry = -1;
+  return _fram->write(GPSC_BASE_ADDRESS, header, 5);
+}
+
+// Status: Ready for testing
+int GPSCapabilityCache::load(uint16_t maxWait) {
+  _cached = false;
+  uint8_t id[UBX_UNIQID_LENGTH];
+  if (!_gps->getUniqueChipId(id, maxWait)) return GPSC_ERROR_NO_ID;
+
+  int entry = find(id, &_caps);
+  if ((entry < 0) && (entry != GPSC_NOT_CACHED)) return entry;   // FRAM error
+  if (entry >= 0) {
+    _entry = entry;
+    _cached = true;
+    _gps->setCapabilities(_caps);
+    return GPSC_SUCCESS;
+  }
+
+  if (!_gps->probeCapabilities(_caps, maxWait)) return GPSC_ERROR_PROBE;
+  return store(_caps);
+}
+
+// Status: Ready for testing
+int GPSCapabilityCache::forget() {
+  if (_entry < 0) return GPSC_SUCCESS;
+  int status = _fram->write(entry_address(_entry), (char)0);
+  if (status == FRAM_SUCCESS) _entry = -1;
+  return status;
+}
+
+bool GPSCapabilityCache::cached() {
+  return _cached;
+}
+
+// Returns entry number, GPSC_NOT_CACHED or FRAM error code
+// Status: Ready for testing
+int GPSCapabilityCache::find(const uint8_t id[UBX_UNIQID_LENGTH], UbloxCapabilities *caps) {
+  char entry[GPSC_ENTRY_SIZE];
+  for (int i = 0; i < GPSC_MAX_ENTRIES; i++) {
+    int status = _fram->read(entry_address(i), entry, GPSC_ENTRY_SIZE);
+    if (status != FRAM_SUCCESS) return status;
+    if ((uint8_t)entry[0] != GPSC_ENTRY_VALID) continue;
+    if (memcmp(entry + 1, id, UBX_UNIQID_LENGTH) != 0) continue;
+    if ((uint8_t)entry[GPSC_ENTRY_SIZE - 1] != checksum(entry)) continue;
+    memcpy(caps->uniqueId, id, UBX_UNIQID_LENGTH);
+    caps->protocolHigh = entry[7];
+    caps->protocolLow = entry[8];
+    caps->highPrecision = (entry[9] & GPSC_FLAG_HIGH_PRECISION) != 0;
+    caps->valset = (entry[9] & GPSC_FLAG_VALSET) != 0;
+    caps->messages = ((uint8_t)entry[10] << 8) | (uint8_t)entry[11];
+    return i;
+  }
+  return GPSC_NOT_CACHED;
+}
+
+// Save a probe result, reusing a free entry or replacing the oldest one
+// Status: Ready for testing
+int GPSCapabilityCache::store(const UbloxCapabilities &caps) {
+  char entry[GPSC_ENTRY_SIZE];
+  int slot = -1;
+  int status;
+  for (int i = 0; i < GPSC_MAX_ENTRIES && slot < 0; i++) {
+    FRAM_Response_Read_Byte state = _fram->read(entry_address(i));
+    if (state.status != FRAM_SUCCESS) return state.status;
+    if ((uint8_t)state.data != GPSC_ENTRY_VALID) slot = i;
+  }
+  if (slot < 0) {
+    FRAM_Response_Read_Byte next = _fram->read(GPSC_BASE_ADDRESS + 4);
+    if (next.status != FRAM_SUCCESS) return next.status;
+    slot = (uint8_t)next.data % GPSC_MAX_ENTRIES;
+    status = _fram->write(GPSC_BASE_ADDRESS + 4, (char)((slot + 1) % GPSC_MAX_ENTRIES));
+    if (status != FRAM_SUCCESS) return status;
+  }
+
+  memset(entry, 0, GPSC_ENTRY_SIZE);
+  memcpy(entry + 1, caps.uniqueId, UBX_UNIQID_LENGTH);
+  entry[7] = caps.protocolHigh;
+  entry[8] = caps.protocolLow;
+  entry[9] = (caps.highPrecision ? GPSC_FLAG_HIGH_PRECISION : 0) | (caps.valset ? GPSC_FLAG_VALSET : 0);
+  entry[10] = caps.messages >> 8;
+  entry[11] = caps.messages;
+  entry[GPSC_ENTRY_SIZE - 1] = checksum(entry);
+  // Invalidate, write the body, then mark the entry valid
+  status = _fram->write(entry_address(slot), (char)0);
+  if (status != FRAM_SUCCESS) return status;
+  status = _fram->write(entry_address(slot) + 1, entry + 1, GPSC_ENTRY_SIZE - 1);
+  if (status != FRAM_SUCCESS) return status;
+  status = _fram->write(entry_address(slot), (char)GPSC_ENTRY_VALID);
+  if (status == FRAM_SUCCESS) _entry = slot;
+  return status;
+}
@@ -0,0 +1,95 @@
+/** Receiver capability cache stored in the command module FRAM
+ *
+ * Probing a u-blox receiver (protocol version, high precision firmware,
+ * which optional messages it answers) takes several round-trips. The result
+ * only changes when the receiver does, so it is kept in FRAM (see
+ * docs/FRAM.adoc) keyed by the chip ID from UBX-SEC-UNIQID. At boot a known
+ * receiver costs one SEC-UNIQID poll; an unknown one is probed once and
+ * remembered. Call forget() after a receiver firmware update.
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef GPSCapabilityCache_H
+#define GPSCapabilityCache_H
+
+#include <mbed.h>
+#include "cypress_fm24w256.h"
+#include "ublox.h"
+
+#define GPSC_BASE_ADDRESS 0x5C20    // cache header (see docs/FRAM.adoc)
+#define GPSC_HEADER_SIZE 16
+#define GPSC_ENTRY_ADDRESS (GPSC_BASE_ADDRESS + GPSC_HEADER_SIZE)
+#define GPSC_ENTRY_SIZE 16
+#define GPSC_MAX_ENTRIES 4          // receivers remembered (oldest replaced first)
+
+#define GPSC_MAGIC 0x4743           // "GC"
+#define GPSC_VERSION 1
+#define GPSC_ENTRY_VALID 0xA5
+
+#define GPSC_FLAG_HIGH_PRECISION 0x01
+#define GPSC_FLAG_VALSET 0x02
+
+#define GPSC_SUCCESS 0
+#define GPSC_ERROR_NO_ID -20        // receiver did not answer SEC-UNIQID
+#define GPSC_ERROR_PROBE -21        // receiver did not answer the capability probe
+#define GPSC_NOT_CACHED -22
+
+class GPSCapabilityCache {
+
+public:
+  /** Create a cache on the given FRAM for one receiver
+   *
+   * @param fram Pointer to the shared FRAM object
+   * @param gps Pointer to the receiver
+   */
+  GPSCapabilityCache(Cypress_FRAM *fram, Ublox_GPS *gps);
+
+  ~GPSCapabilityCache();
+
+  /** Check the cache region in FRAM, formatting it if it is blank
+   *
+   * @returns GPSC_SUCCESS or FRAM error code
+   */
+  int begin();
+
+  /** Erase every cached receiver */
+  int format();
+
+  /** Give the receiver its capabilities, probing it only if it is not cached
+   *
+   * Reads the chip ID, then either hands the cached entry to
+   * Ublox_GPS::setCapabilities or runs Ublox_GPS::probeCapabilities and
+   * stores the result.
+   *
+   * @param maxWait Timeout (ms) for each poll
+   * @returns GPSC_SUCCESS, GPSC_ERROR_NO_ID, GPSC_ERROR_PROBE or FRAM error code
+   */
+  int load(uint16_t maxWait = 1100);
+
+  /** Remove the current receiver from the cache so the next load() probes it
+   *
+   * @returns GPSC_SUCCESS or FRAM error code
+   */
+  int forget();
+
+  /** True if the last load() used a cached entry (no probe) */
+  bool cached();
+
+private:
+  Cypress_FRAM *_fram;
+  Ublox_GPS *_gps;
+  UbloxCapabilities _caps;
+  bool _cached;
+  int _entry;               // entry holding the current receiver, or -1
+
+  uint16_t entry_address(int entry);
+  int find(const uint8_t id[UBX_UNIQID_LENGTH], UbloxCapabilities *caps);
+  int store(const UbloxCapabilities &caps);
+  uint8_t checksum(const char *entry);
+};
+
+#endif
@@ -0,0 +1,202 @@
+#include "GeofenceMonitor.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+GeofenceMonitor::GeofenceMonitor(Ublox_GPS *gps, PinName pioPin, uint8_t receiverPIO) {
+  _gps = gps;
+  _pio = (pioPin == NC) ? NULL : new InterruptIn(pioPin);
+  _receiverPIO = receiverPIO;
+  _numZones = 0;
+  for (int i = 0; i < GEOFENCE_MAX_FENCES; i++)
+    _state[i] = GEOFENCE_UNKNOWN;
+  _active = false;
+  _pioChanged = false;
+  _reportPending = false;
+  memset(&_report, 0, sizeof(_report));
+  _crossed = 0;
+  _queue = NULL;
+  _msg = NULL;
+  _eventIndex = 0;
+  _crossings = 0;
+}
+
+GeofenceMonitor::~GeofenceMonitor() {
+  delete _pio;
+}
+
+int GeofenceMonitor::add_fence(GeofenceRole role, int32_t latitude, int32_t longitude, uint32_t radius) {
+  if (_numZones >= GEOFENCE_MAX_FENCES) return -1;
+  _zones[_numZones].role = role;
+  _zones[_numZones].latitude = latitude;
+  _zones[_numZones].longitude = longitude;
+  _zones[_numZones].radius = radius;
+  _state[_numZones] = GEOFENCE_UNKNOWN;
+  return _numZones++;
+}
+
+void GeofenceMonitor::set_report(SBDqueue *queue, SBDmessage *msg) {
+  _queue = queue;
+  _msg = msg;
+}
+
+void GeofenceMonitor::attach(Callback<void(const GeofenceEvent &)> callback) {
+  _callback = callback;
+}
+
+/* addGeofence resends the whole list each time and the confidence and PIO
+ * settings of the last call apply to all fences, so every call gets the same
+ * ones.
+ */
+// Status: Ready for testing
+int GeofenceMonitor::begin() {
+  if (_numZones == 0) return GEOFENCE_ERROR_NO_FENCES;
+  if (!_gps->clearGeofences()) return GEOFENCE_ERROR_CONFIGURE;
+  for (int i = 0; i < _numZones; i++) {
+    // polarity 0: low means inside (any fence), high means outside all of them
+    if (!_gps->addGeofence(_zones[i].latitude, _zones[i].longitude, _zones[i].radius * 100,
+        GEOFENCE_CONFIDENCE, 0, (_pio == NULL) ? 0 : _receiverPIO))
+      return GEOFENCE_ERROR_CONFIGURE;
+  }
+  if (!_gps->subscribe(UBX_CLASS_NAV, UBX_NAV_GEOFENCE, callback(this, &GeofenceMonitor::geofence_received)))
+    return GEOFENCE_ERROR_SUBSCRIBE;
+  if (_pio != NULL) {
+    _pio->rise(callback(this, &GeofenceMonitor::pio_edge));
+    _pio->fall(callback(this, &GeofenceMonitor::pio_edge));
+  }
+  return GEOFENCE_SUCCESS;
+}
+
+/* The reports are applied here rather than in geofence_received because a
+ * crossing reads a fresh NAV-PVT for the message, and that cannot be done
+ * from inside checkUblox. A PIO edge only sends a poll; its answer is
+ * applied by a later update(), after checkUblox has read it.
+ */
+// Status: Ready for testing
+int GeofenceMonitor::update() {
+  int found = 0;
+  if (_pioChanged) {
+    _pioChanged = false;
+    // The answer is a NAV-GEOFENCE like the periodic ones, so it goes to
+    // geofence_received; waiting for it here (getGeofenceState) would time out
+    _gps->sendFrame(UBX_CLASS_NAV, UBX_NAV_GEOFENCE, NULL, 0);
+  }
+
+  UBX_NAV_GEOFENCE_data_t report;
+  bool pending;
+  {
+    CriticalSectionLock lock;
+    pending = _reportPending;
+    _reportPending = false;
+    if (pending) report = _report;
+  }
+  if (pending) found += add_report(report, Kernel::Clock::now());
+  return found;
+}
+
+uint8_t GeofenceMonitor::state(int fence) {
+  if ((fence < 0) || (fence >= _numZones)) return GEOFENCE_UNKNOWN;
+  return _state[fence];
+}
+
+bool GeofenceMonitor::active() {
+  return _active;
+}
+
+int GeofenceMonitor::fences() {
+  return _numZones;
+}
+
+uint32_t GeofenceMonitor::crossings() {
+  return _crossings;
+}
+
+bool GeofenceMonitor::event(int age, GeofenceEvent &e) {
+  if ((age < 0) || (age >= GEOFENCE_EVENTS) || ((uint32_t)age >= _crossings)) return false;
+  e = _events[(_eventIndex - 1 - age + GEOFENCE_EVENTS) % GEOFENCE_EVENTS];
+  return true;
+}
+
+// Status: Ready for testing
+int GeofenceMonitor::add_report(const UBX_NAV_GEOFENCE_data_t &report, Kernel::Clock::time_point t) {
+  _active = (report.status == 1);
+  if (!_active) return 0;     // states are not reliable
+
+  int found = 0;
+  _crossed = 0;
+  int n = (report.numFences < _numZones) ? report.numFences : _numZones;
+  for (int i = 0; i < n; i++) {
+    uint8_t now = report.fences[i].state;
+    if ((now != GEOFENCE_INSIDE) && (now != GEOFENCE_OUTSIDE)) continue;
+    uint8_t before = _state[i];
+    _state[i] = now;
+    if ((before == GEOFENCE_UNKNOWN) || (before == now)) continue;
+
+    GeofenceEvent &e = _events[_eventIndex];
+    _eventIndex = (_eventIndex + 1) % GEOFENCE_EVENTS;
+    e.fence = i;
+    e.role = _zones[i].role;
+    e.from = before;
+    e.to = now;
+    e.time = t;
+    _crossings++;
+    _crossed |= 1 << i;
+    found++;
+    if (_callback) _callback(e);
+  }
+  if (found > 0) send_report();
+  return found;
+}
+
+void GeofenceMonitor::pio_edge() {
+  _pioChanged = true;
+}
+
+void GeofenceMonitor::geofence_received(const ubxPacket *msg) {
+  if (msg->len < 8) return;
+  CriticalSectionLock lock;
+  memset(&_report, 0, sizeof(_report));
+  memcpy(&_report, msg->payload, (msg->len < sizeof(_report)) ? msg->len : sizeof(_report));
+  _reportPending = true;
+}
+
+/* One message covers every crossing found in the same report. */
+// Status: Ready for testing
+void GeofenceMonitor::send_report() {
+  if ((_queue == NULL) || (_msg == NULL)) return;
+  GPSFix fix;
+  bool fresh = _gps->getPVT(GEOFENCE_SNAPSHOT_WAIT_MS);
+  if (fresh) FixHistory::from_receiver(_gps, fix);
+  char data[GEOFENCE_REPORT_LENGTH];
+  int length = build_report(fresh ? &fix : NULL, data);
+  _queue->push(data, length, SBD_PRIORITY_URGENT);
+}
+
+/* The frame is built in _frame so the caller's message, which the routine
+ * track is built from, keeps its own GPS bytes and pods.
+ */
+// Status: Ready for testing
+int GeofenceMonitor::build_report(const GPSFix *fix, char *data) {
+  if (_msg == NULL) return 0;
+  _frame = *_msg;
+  if (fix != NULL) _frame.generateGPSBytes(*fix);
+  memcpy(data, _frame.data(), SBD_CM_LENGTH);
+  data[2] = data[2] & 0x03;     // pod bits: the report has no pods
+
+  int b = SBD_CM_LENGTH;
+  data[b++] = (char)_numZones;
+  for (int i = 0; i < _numZones; i++) {
+    char fence = _state[i] & 0x03;
+    fence |= (char)(_zones[i].role & 0x03) << 2;
+    if (_crossed & (1 << i)) fence |= 0x10;
+    data[b++] = fence;
+  }
+  return b;
+}
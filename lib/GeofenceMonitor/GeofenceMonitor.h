@@ -0,0 +1,203 @@
+/** Geofences kept by the GPS receiver, with urgent messages on crossings
+ *
+ * The receiver can hold up to four circular geofences (UBX-CFG-GEOFENCE) and
+ * works out each epoch whether it is inside or outside every one of them.
+ * GeofenceMonitor programs the fences we care about (launch site radius,
+ * restricted airspace, recovery zone) and only looks at the result:
+ *
+ *  - NAV-GEOFENCE is subscribed to, so the state arrives with the other
+ *    periodic output and is read by checkUblox (no polls, no distances
+ *    computed on the LPC1768)
+ *  - optionally the receiver's combined fence state is also driven onto a
+ *    PIO wired to an MCU pin; an edge there makes update() poll NAV-GEOFENCE
+ *    at once instead of waiting for the next periodic message (the answer
+ *    arrives through the subscription, so update() does not block)
+ *
+ * A crossing is a fence going from inside to outside or back (unknown
+ * states in between are skipped over). Each crossing is passed to the
+ * attached callback, and if a queue and message were given with
+ * set_report() a separate report frame is queued as an urgent SBD message,
+ * so it goes out ahead of the routine track. The report carries the given
+ * message's mission ID and command module bytes, a fresh GPS fix and the
+ * state of every fence (see build_report); the message itself is not
+ * changed.
+ *
+ * Typical use:
+ *    monitor.add_fence(GEOFENCE_LAUNCH_SITE, lat, lon, 5000);   // 5 km
+ *    monitor.add_fence(GEOFENCE_RECOVERY, lat2, lon2, 20000);
+ *    monitor.set_report(&queue, msg);
+ *    monitor.begin();
+ *    ...
+ *    if (monitor.update() > 0) ...   // in the main loop; start a session now
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef GeofenceMonitor_H
+#define GeofenceMonitor_H
+
+#include <mbed.h>
+#include "ublox.h"
+#include "SBDmessage.h"
+#include "SBDqueue.h"
+#include "FixHistory.h"
+
+#define GEOFENCE_MAX_FENCES 4
+#define GEOFENCE_CONFIDENCE 2         // confLvl: 0 none, 1 68%, 2 95%, 3 99.7%, 4 99.99%
+#define GEOFENCE_RECEIVER_PIO 0       // receiver PIO driven with the combined state (0 = none)
+#define GEOFENCE_SNAPSHOT_WAIT_MS 1100
+#define GEOFENCE_EVENTS 8             // crossings kept for event()
+#define GEOFENCE_REPORT_LENGTH (SBD_CM_LENGTH + 1 + GEOFENCE_MAX_FENCES)   // longest report frame
+
+// Fence states, as reported in NAV-GEOFENCE
+#define GEOFENCE_UNKNOWN 0
+#define GEOFENCE_INSIDE 1
+#define GEOFENCE_OUTSIDE 2
+
+// begin() results
+#define GEOFENCE_SUCCESS 0
+#define GEOFENCE_ERROR_NO_FENCES -40
+#define GEOFENCE_ERROR_CONFIGURE -41  // receiver refused CFG-GEOFENCE
+#define GEOFENCE_ERROR_SUBSCRIBE -42  // could not turn on NAV-GEOFENCE
+
+enum GeofenceRole {
+  GEOFENCE_LAUNCH_SITE = 0,
+  GEOFENCE_AIRSPACE,
+  GEOFENCE_RECOVERY,
+  GEOFENCE_OTHER
+};
+
+/** One fence as programmed into the receiver
+ */
+struct GeofenceZone {
+  GeofenceRole role;
+  int32_t latitude;           // Degrees * 10^-7
+  int32_t longitude;          // Degrees * 10^-7
+  uint32_t radius;            // m
+};
+
+/** A fence crossing
+ */
+struct GeofenceEvent {
+  uint8_t fence;              // index in the order the fences were added
+  GeofenceRole role;
+  uint8_t from;               // GEOFENCE_INSIDE or GEOFENCE_OUTSIDE
+  uint8_t to;
+  Kernel::Clock::time_point time;
+};
+
+class GeofenceMonitor {
+
+public:
+  /** Create a monitor
+   *
+   * @param gps Receiver that holds the fences
+   * @param pioPin MCU pin on the receiver's geofence PIO (NC to rely on NAV-GEOFENCE only)
+   * @param receiverPIO Receiver PIO number wired to pioPin
+   */
+  GeofenceMonitor(Ublox_GPS *gps, PinName pioPin = NC, uint8_t receiverPIO = GEOFENCE_RECEIVER_PIO);
+
+  ~GeofenceMonitor();
+
+  /** Add a fence (programmed by begin)
+   *
+   * @param role What the fence is for
+   * @param latitude Centre (degrees * 10^-7)
+   * @param longitude Centre (degrees * 10^-7)
+   * @param radius Radius in m
+   * @returns fence index or -1 if there are already GEOFENCE_MAX_FENCES
+   */
+  int add_fence(GeofenceRole role, int32_t latitude, int32_t longitude, uint32_t radius);
+
+  /** Queue an urgent SBD message on every crossing
+   *
+   * @param queue Outbound queue (NULL to stop)
+   * @param msg Message whose mission ID and command module bytes are copied into each report
+   */
+  void set_report(SBDqueue *queue, SBDmessage *msg);
+
+  /** Build the report frame for the most recent crossings
+   *
+   * Bytes 0 to SBD_CM_LENGTH-1 are those of the message given to set_report,
+   * with the GPS bytes taken from fix and no pods. Byte SBD_CM_LENGTH is the
+   * number of fences, followed by one byte per fence in index order: bits
+   * 0-1 state (GEOFENCE_UNKNOWN, INSIDE or OUTSIDE), bits 2-3 role, bit 4
+   * set if the fence was crossed in the latest report.
+   *
+   * @param fix Position for the frame (NULL keeps the message's GPS bytes)
+   * @param data Buffer of at least GEOFENCE_REPORT_LENGTH bytes
+   * @returns frame length, or 0 if set_report has not been given a message
+   */
+  int build_report(const GPSFix *fix, char *data);
+
+  /** Call a function on every crossing (from update) */
+  void attach(Callback<void(const GeofenceEvent &)> callback);
+
+  /** Program the fences, turn on NAV-GEOFENCE and attach the PIO interrupt
+   *
+   * @returns GEOFENCE_SUCCESS or a GEOFENCE_ERROR code
+   */
+  int begin();
+
+  /** Act on any new fence state (main loop)
+   *
+   * @returns number of crossings found
+   */
+  int update();
+
+  /** Last known state of a fence (GEOFENCE_UNKNOWN, INSIDE or OUTSIDE) */
+  uint8_t state(int fence);
+
+  /** True if the receiver says geofencing is active and reliable */
+  bool active();
+
+  /** Number of fences added */
+  int fences();
+
+  /** Crossings since the monitor was created */
+  uint32_t crossings();
+
+  /** Most recent crossing
+   *
+   * @param age 0 for the newest, 1 for the one before, ...
+   * @returns true if there is a crossing of that age
+   */
+  bool event(int age, GeofenceEvent &e);
+
+  /** Apply a NAV-GEOFENCE report (normally called from update)
+   *
+   * @param report Message payload
+   * @param t Time the report arrived
+   * @returns number of crossings found
+   */
+  int add_report(const UBX_NAV_GEOFENCE_data_t &report, Kernel::Clock::time_point t);
+
+private:
+  Ublox_GPS *_gps;
+  InterruptIn *_pio;
+  uint8_t _receiverPIO;
+  GeofenceZone _zones[GEOFENCE_MAX_FENCES];
+  int _numZones;
+  uint8_t _state[GEOFENCE_MAX_FENCES];  // last known state (unknown is not stored over it)
+  bool _active;
+  volatile bool _pioChanged;
+  bool _reportPending;                  // _report and _reportPending are shared with checkUblox
+  UBX_NAV_GEOFENCE_data_t _report;      // (critical section)
+  uint8_t _crossed;                     // bit i: fence i crossed in the latest report
+  SBDqueue *_queue;
+  SBDmessage *_msg;
+  SBDmessage _frame;                    // report frame, built from *_msg
+  Callback<void(const GeofenceEvent &)> _callback;
+  GeofenceEvent _events[GEOFENCE_EVENTS];
+  int _eventIndex;
+  uint32_t _crossings;
+
+  void pio_edge();
+  void geofence_received(const ubxPacket *msg);
+  void send_report();
+};
+
+#endif
@@ -0,0 +1,152 @@
+#include "IridiumScheduler.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with 9603
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+IridiumScheduler::IridiumScheduler(RockBlock9603 *modem) {
+  _modem = modem;
+  _period = 300s;
+  _slack = 75s;
+  _lastSession = Kernel::Clock::now();
+  _sampleCount = 0;
+  _sampleIndex = 0;
+  _sessionCount = 0;
+  _sessionIndex = 0;
+  _totalSessions = 0;
+  _totalSuccesses = 0;
+  _totalSessionMs = 0;
+  _totalBytes = 0;
+}
+
+IridiumScheduler::~IridiumScheduler() {
+
+}
+
+// Status: Ready for testing
+void IridiumScheduler::set_period(seconds period, seconds slack) {
+  _period = period;
+  if (slack < 0s)
+    _slack = _period / 4;
+  else if (slack > period)
+    _slack = period;
+  else
+    _slack = slack;
+}
+
+// Status: Ready for testing
+int IridiumScheduler::sample() {
+  int bars = _modem->get_last_signal_quality();
+  if (bars >= 0) add_sample(bars);
+  return bars;
+}
+
+void IridiumScheduler::add_sample(int bars) {
+  if ((bars < 0) || (bars > SCHED_MAX_BARS)) return;
+  _samples[_sampleIndex] = bars;
+  _sampleIndex = (_sampleIndex + 1) % SCHED_SAMPLE_HISTORY;
+  if (_sampleCount < SCHED_SAMPLE_HISTORY) _sampleCount++;
+}
+
+int IridiumScheduler::current_bars() {
+  if (_sampleCount == 0) return -1;
+  // Average the last few samples since CSQF jumps around as satellites pass
+  int n = (_sampleCount < 3) ? _sampleCount : 3;
+  int sum = 0;
+  for (int i = 1; i <= n; i++)
+    sum += _samples[(_sampleIndex - i + SCHED_SAMPLE_HISTORY) % SCHED_SAMPLE_HISTORY];
+  return (sum + n/2) / n;
+}
+
+// Status: Ready for testing
+float IridiumScheduler::success_estimate(int bars) {
+  if (bars < 0) bars = 0;
+  if (bars > SCHED_MAX_BARS) bars = SCHED_MAX_BARS;
+  // Prior belief (more bars is better), updated by sessions at the same signal
+  float prior = (bars + 0.5f) / (SCHED_MAX_BARS + 1);
+  int attempts = 0;
+  int successes = 0;
+  for (int i = 0; i < _sessionCount; i++) {
+    if (_sessionBars[i] == bars) {
+      attempts++;
+      if (_sessionSuccess[i]) successes++;
+    }
+  }
+  return (successes + 2*prior) / (attempts + 2);
+}
+
+// Status: Ready for testing
+bool IridiumScheduler::should_transmit() {
+  milliseconds sinceLast = duration_cast<milliseconds>(Kernel::Clock::now() - _lastSession);
+  if (sinceLast < _period - _slack) return false;  // window not open yet
+  if (sinceLast >= _period) return true;           // deadline reached
+
+  // Deferral is capped at the transmit period, so the window ends at the deadline
+  milliseconds middle = _period - _slack / 2;
+  int bars = current_bars();
+  if (bars < 0) return (sinceLast >= middle); // no samples, so go halfway through the window
+  float p = success_estimate(bars);
+  if (p >= SCHED_PULL_FORWARD_PROB) return true;
+  if ((sinceLast >= middle) && (p >= SCHED_DEFER_PROB)) return true;
+  return false;
+}
+
+milliseconds IridiumScheduler::time_to_deadline() {
+  milliseconds sinceLast = duration_cast<milliseconds>(Kernel::Clock::now() - _lastSession);
+  milliseconds remaining = _period - sinceLast;
+  return (remaining > 0ms) ? remaining : 0ms;
+}
+
+milliseconds IridiumScheduler::time_to_window() {
+  milliseconds sinceLast = duration_cast<milliseconds>(Kernel::Clock::now() - _lastSession);
+  milliseconds remaining = _period - _slack - sinceLast;
+  return (remaining > 0ms) ? remaining : 0ms;
+}
+
+// Status: Ready for testing
+void IridiumScheduler::record_session(bool success, int bars, milliseconds duration, int bytes) {
+  // Bars are sampled before the session; the transmission itself disturbs CSQF
+  if (bars < 0) bars = 0;
+  if (bars > SCHED_MAX_BARS) bars = SCHED_MAX_BARS;
+  _sessionBars[_sessionIndex] = bars;
+  _sessionSuccess[_sessionIndex] = success;
+  _sessionIndex = (_sessionIndex + 1) % SCHED_SESSION_HISTORY;
+  if (_sessionCount < SCHED_SESSION_HISTORY) _sessionCount++;
+
+  _totalSessions++;
+  _totalSessionMs += duration.count();
+  if (success) {
+    _totalSuccesses++;
+    if (bytes > 0) _totalBytes += bytes;
+  }
+  _lastSession = Kernel::Clock::now();
+}
+
+// Status: Ready for testing
+SchedulerMetrics IridiumScheduler::get_metrics() {
+  SchedulerMetrics m;
+  m.sessions = _totalSessions;
+  m.successes = _totalSuccesses;
+  m.successRate = (_totalSessions > 0) ? (float)_totalSuccesses / _totalSessions : 0;
+  m.avgSessionMs = (_totalSessions > 0) ? _totalSessionMs / _totalSessions : 0;
+  m.bytesDelivered = _totalBytes;
+  // mW * ms = uJ, so divide by 1000 for mJ
+  float energy = (float)IRIDIUM_SESSION_POWER_MW * _totalSessionMs / 1000.0f;
+  m.energyPerByte = (_totalBytes > 0) ? energy / _totalBytes : 0;
+  return m;
+}
+
+void IridiumScheduler::print_metrics() {
+  SchedulerMetrics m = get_metrics();
+  printf("Iridium sessions: %lu (%lu successful, %d%%)\r\n", (unsigned long)m.sessions,
+    (unsigned long)m.successes, (int)(m.successRate*100));
+  printf("Average session time: %lu ms\r\n", (unsigned long)m.avgSessionMs);
+  printf("Delivered %lu bytes at %d mJ per byte\r\n", (unsigned long)m.bytesDelivered,
+    (int)m.energyPerByte);
+}
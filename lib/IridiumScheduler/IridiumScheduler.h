@@ -0,0 +1,141 @@
+/** Signal-quality-aware scheduler for Iridium SBD sessions
+ *
+ * Samples the cached signal strength (AT+CSQF) and keeps a short history of
+ * signal bars and session outcomes. Each session has a window that closes
+ * at the flight mode's transmit period, so a session is never deferred past
+ * the period:
+ *   - before the window opens: never transmit
+ *   - first half of the window: transmit only if conditions look good
+ *   - second half of the window: transmit unless a failure is very likely
+ *   - at the deadline (one transmit period after the last session): always
+ *     transmit
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef IRIDIUMSCHEDULER_H
+#define IRIDIUMSCHEDULER_H
+
+#include <mbed.h>
+#include "RockBlock9603.h"
+
+#define SCHED_SAMPLE_HISTORY 8     // CSQF samples kept
+#define SCHED_SESSION_HISTORY 16   // session outcomes kept
+#define SCHED_MAX_BARS 5
+
+#define SCHED_PULL_FORWARD_PROB 0.8f  // success estimate needed to go early
+#define SCHED_DEFER_PROB 0.3f         // below this, wait for deadline
+
+// RockBLOCK 9603 supply power (5 V), from the RockBLOCK 9603 datasheet
+#define IRIDIUM_SESSION_POWER_MW 725  // average during an SBD session (145 mA)
+
+struct SchedulerMetrics {
+  uint32_t sessions;          // number of +SBDIX sessions recorded
+  uint32_t successes;         // sessions with MO status 0-4
+  float successRate;          // successes / sessions
+  uint32_t avgSessionMs;      // average session duration
+  uint32_t bytesDelivered;    // total MO bytes delivered
+  float energyPerByte;        // modem energy per delivered byte (mJ)
+};
+
+class IridiumScheduler {
+
+public:
+  /** Create a scheduler for the given modem
+   *
+   * @param modem Pointer to the RockBLOCK 9603 interface
+   */
+  IridiumScheduler(RockBlock9603 *modem);
+
+  ~IridiumScheduler();
+
+  /** Set the transmit period for the current flight mode
+   *
+   * @param period Longest time between sessions
+   * @param slack Length of the window before the deadline in which a session
+   *   may go early (default is a quarter of the period, at most the period)
+   */
+  void set_period(seconds period, seconds slack = -1s);
+
+  /** Take a cheap signal sample (AT+CSQF)
+   *
+   * @returns number of bars (0-5) or negative on error
+   */
+  int sample();
+
+  /** Record a signal sample obtained elsewhere (e.g. AT+CSQ)
+   */
+  void add_sample(int bars);
+
+  /** Decide whether a session should be started now
+   */
+  bool should_transmit();
+
+  /** Time remaining until a session must be attempted regardless of signal
+   */
+  milliseconds time_to_deadline();
+
+  /** Time remaining until the window opens (the earliest the next session can start)
+   */
+  milliseconds time_to_window();
+
+  /** Signal bars the next session would start with
+   *
+   * Average of the most recent samples, to be read just before a session and
+   * passed to record_session afterwards.
+   *
+   * @returns number of bars (0-5) or -1 if there are no samples
+   */
+  int current_bars();
+
+  /** Record the outcome of a session
+   *
+   * Also restarts the window for the next session.
+   *
+   * @param success True if the MO message was delivered
+   * @param bars Signal bars at the start of the session (from current_bars)
+   * @param duration Time taken by the session
+   * @param bytes Number of MO bytes delivered
+   */
+  void record_session(bool success, int bars, milliseconds duration, int bytes);
+
+  /** Estimated probability that a session succeeds at the given signal
+   *
+   * @param bars Signal bars (0-5)
+   */
+  float success_estimate(int bars);
+
+  /** Summary of session statistics
+   */
+  SchedulerMetrics get_metrics();
+
+  /** Print summary of session statistics to the console
+   */
+  void print_metrics();
+
+private:
+  RockBlock9603 *_modem;
+  milliseconds _period;
+  milliseconds _slack;
+  Kernel::Clock::time_point _lastSession;
+
+  int _samples[SCHED_SAMPLE_HISTORY];
+  int _sampleCount;
+  int _sampleIndex;
+
+  // Outcome history by signal bars at the start of the session
+  uint8_t _sessionBars[SCHED_SESSION_HISTORY];
+  bool _sessionSuccess[SCHED_SESSION_HISTORY];
+  int _sessionCount;
+  int _sessionIndex;
+
+  uint32_t _totalSessions;
+  uint32_t _totalSuccesses;
+  uint64_t _totalSessionMs;
+  uint32_t _totalBytes;
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include "PPSClock.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+PPSClock::PPSClock(Ublox_GPS *gps, PinName ppsPin) {
+  _gps = gps;
+  _pps = new InterruptIn(ppsPin);
+  _anchorLocal = 0;
+  _anchorUtc = 0;
+  _rateError = 0;
+  _rateKnown = false;
+  _anchors = 0;
+  _lastReturned = 0;
+  _mismatches = 0;
+  _mismatchOffset = 0;
+  _pendingValid = false;
+  _pendingUtc = 0;
+  _pendingLocal = 0;
+  _ticker.start();
+}
+
+PPSClock::~PPSClock() {
+  delete _pps;
+}
+
+// Status: Ready for testing
+int PPSClock::begin() {
+  if (!_gps->setTimePulse(1000000, 100000, true)) return PPS_ERROR_TIMEPULSE;
+  if (!_gps->subscribe(UBX_CLASS_TIM, UBX_TIM_TP, callback(this, &PPSClock::timepulse_received)))
+    return PPS_ERROR_SUBSCRIBE;
+  _pps->rise(callback(this, &PPSClock::pps_rise));
+  return PPS_SUCCESS;
+}
+
+uint64_t PPSClock::monotonic() {
+  return (uint64_t)_ticker.elapsed_time().count();
+}
+
+// Status: Ready for testing
+uint64_t PPSClock::now() {
+  CriticalSectionLock lock;
+  uint64_t utc = utc_at(monotonic());
+  if (utc == 0) return 0;
+  if (utc <= _lastReturned) utc = _lastReturned + 1;
+  _lastReturned = utc;
+  return utc;
+}
+
+uint64_t PPSClock::to_utc(uint64_t local) {
+  CriticalSectionLock lock;
+  return utc_at(local);
+}
+
+bool PPSClock::synced() {
+  return (_anchors > 0) && (holdover() < PPS_HOLDOVER_S);
+}
+
+uint32_t PPSClock::holdover() {
+  CriticalSectionLock lock;
+  if (_anchors == 0) return 0xFFFFFFFF;
+  return (uint32_t)((monotonic() - _anchorLocal) / 1000000);
+}
+
+int32_t PPSClock::rate_error() {
+  return _rateError;
+}
+
+uint32_t PPSClock::anchors() {
+  return _anchors;
+}
+
+void PPSClock::pps_rise() {
+  add_pulse(monotonic());
+}
+
+void PPSClock::timepulse_received(const ubxPacket *msg) {
+  UBX_TIM_TP_data_t tp;
+  if (msg->len < sizeof(tp)) return;
+  memcpy(&tp, msg->payload, sizeof(tp));
+  add_timepulse(tp, monotonic());
+}
+
+// Status: Ready for testing
+void PPSClock::add_timepulse(const UBX_TIM_TP_data_t &tp, uint64_t local) {
+  CriticalSectionLock lock;
+  uint64_t utc = timepulse_utc(tp);
+  if ((_anchors > 0) && (utc_at(local) >= utc)) return;   // its pulse has been and gone
+  _pendingUtc = utc;
+  _pendingLocal = local;
+  _pendingValid = true;
+}
+
+/* Runs in the interrupt. A pulse with no TIM-TP in the last
+ * PPS_MATCH_WINDOW_US is not used: its time would be a guess. Neither is a
+ * pair that disagrees with the running clock by half a second or more,
+ * unless the clock has been in holdover too long to be trusted or a run of
+ * such pairs all put it off by the same amount.
+ */
+// Status: Ready for testing
+void PPSClock::add_pulse(uint64_t local) {
+  if (!_pendingValid) return;
+  _pendingValid = false;
+  if (local - _pendingLocal > PPS_MATCH_WINDOW_US) return;
+
+  uint64_t utc = _pendingUtc;
+  if (_anchors > 0) {
+    int64_t offset = (int64_t)(utc_at(local) - utc);
+    bool agrees = (offset > -PPS_MATCH_TOLERANCE_US) && (offset < PPS_MATCH_TOLERANCE_US);
+    if (!agrees && (local - _anchorLocal < (uint64_t)PPS_HOLDOVER_S * 1000000)) {
+      int64_t spread = offset - _mismatchOffset;
+      if ((_mismatches > 0) && (spread > -PPS_MATCH_TOLERANCE_US) && (spread < PPS_MATCH_TOLERANCE_US)) {
+        _mismatches++;
+      } else {
+        _mismatches = 1;
+        _mismatchOffset = offset;
+      }
+      if (_mismatches < PPS_RELOCK_PAIRS) return;
+    }
+    _mismatches = 0;
+
+    int64_t dLocal = (int64_t)(local - _anchorLocal);
+    int64_t dUtc = (int64_t)(utc - _anchorUtc);
+    if (agrees && (dLocal > 0) && (dUtc > 0) && (dUtc <= (int64_t)PPS_MAX_RATE_GAP_S * 1000000)) {
+      int32_t measured = (int32_t)((dUtc - dLocal) * 1000000000LL / dLocal);
+      if (_rateKnown)
+        _rateError += (measured - _rateError) / PPS_RATE_SMOOTHING;
+      else
+        _rateError = measured;
+      _rateKnown = true;
+    }
+  }
+  _anchorLocal = local;
+  _anchorUtc = utc;
+  _anchors++;
+}
+
+uint64_t PPSClock::utc_at(uint64_t local) {
+  if (_anchors == 0) return 0;
+  int64_t elapsed = (int64_t)(local - _anchorLocal);
+  return _anchorUtc + elapsed + elapsed * _rateError / 1000000000LL;
+}
+
+// Status: Ready for testing
+uint64_t PPSClock::timepulse_utc(const UBX_TIM_TP_data_t &tp) {
+  uint64_t seconds = PPS_GPS_EPOCH + (uint64_t)tp.week * 604800 + tp.towMS / 1000;
+  if (!(tp.flags & 0x01)) seconds -= PPS_LEAP_SECONDS;     // GPS time base
+  uint64_t us = (uint64_t)(tp.towMS % 1000) * 1000 + (((uint64_t)tp.towSubMS * 1000) >> 32);
+  return seconds * 1000000 + us;
+}
@@ -0,0 +1,145 @@
+/** Microsecond UTC clock disciplined by the GPS time pulse
+ *
+ * Telemetry time has been a whole-second syncTime, and anything finer meant
+ * polling the receiver. PPSClock keeps a 64-bit microsecond count from the
+ * LPC1768's free-running microsecond ticker and ties it to UTC using the
+ * receiver's TIMEPULSE output:
+ *
+ *  - TIM-TP (read by checkUblox) gives the UTC time of the next pulse
+ *  - the pulse's rising edge on an InterruptIn captures the local count
+ *  - each such pair is an anchor; successive anchors give the ticker's
+ *    rate error, which is smoothed and kept
+ *
+ * now() is then the last anchor plus the elapsed local time corrected for
+ * the rate error, which needs no GPS traffic at all. During a GPS outage
+ * the clock keeps running on the last rate estimate (holdover), so it
+ * drifts by roughly the change in crystal rate rather than the full crystal
+ * error. The value returned never goes backwards.
+ *
+ * Typical use:
+ *    PPSClock clock(&gps, p12);
+ *    clock.begin();
+ *    ...
+ *    record.time = clock.now();      // us since 1970-01-01 UTC
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef PPSClock_H
+#define PPSClock_H
+
+#include <mbed.h>
+#include "ublox.h"
+
+#define PPS_GPS_EPOCH 315964800ULL   // 1980-01-06 in seconds since 1970-01-01
+#define PPS_LEAP_SECONDS 18          // GPS - UTC, used only if TIM-TP is in GPS time
+#define PPS_MATCH_WINDOW_US 950000   // a pulse this soon after its TIM-TP is the one it announced (under 1 s, so never the pulse after)
+#define PPS_MATCH_TOLERANCE_US 500000 // once synced, a pair this far from the clock's own time is a mismatch
+#define PPS_MAX_RATE_GAP_S 3600      // anchors further apart than this are not used for the rate
+#define PPS_RATE_SMOOTHING 8         // rate estimate moves 1/8 of the way to each new measurement
+#define PPS_HOLDOVER_S 600           // synced() turns false after this long without an anchor
+#define PPS_RELOCK_PAIRS 3           // consecutive mismatched pairs, consistent with each other, that re-anchor the clock
+
+// begin() results
+#define PPS_SUCCESS 0
+#define PPS_ERROR_TIMEPULSE -30      // receiver refused CFG-TP5
+#define PPS_ERROR_SUBSCRIBE -31      // could not turn on TIM-TP
+
+class PPSClock {
+
+public:
+  /** Create a clock
+   *
+   * @param gps Receiver whose TIMEPULSE output is wired to ppsPin
+   * @param ppsPin MCU pin on the TIMEPULSE line
+   */
+  PPSClock(Ublox_GPS *gps, PinName ppsPin);
+
+  ~PPSClock();
+
+  /** Configure a 1 Hz UTC time pulse, turn on TIM-TP and attach the interrupt
+   *
+   * @returns PPS_SUCCESS or a PPS_ERROR code
+   */
+  int begin();
+
+  /** Current UTC time
+   *
+   * @returns microseconds since 1970-01-01 UTC, or 0 before the first anchor
+   */
+  uint64_t now();
+
+  /** Local monotonic time (microseconds since the clock was created) */
+  uint64_t monotonic();
+
+  /** Convert a local monotonic time to UTC (0 before the first anchor) */
+  uint64_t to_utc(uint64_t local);
+
+  /** True if there has been an anchor within PPS_HOLDOVER_S */
+  bool synced();
+
+  /** Seconds since the last anchor (holdover time) */
+  uint32_t holdover();
+
+  /** Ticker rate error (parts per billion, positive if the ticker is slow) */
+  int32_t rate_error();
+
+  /** Number of anchors (pulses matched to their TIM-TP) */
+  uint32_t anchors();
+
+  /** Record a TIM-TP message (normally called from checkUblox)
+   *
+   * Once anchored, a TIM-TP whose pulse time the clock has already passed
+   * is ignored: it was read after its pulse and would pair with the next
+   * one, a second off.
+   *
+   * @param tp Message payload
+   * @param local Local time at which it arrived
+   */
+  void add_timepulse(const UBX_TIM_TP_data_t &tp, uint64_t local);
+
+  /** Record a pulse edge (normally called from the interrupt)
+   *
+   * While synced, a pulse whose TIM-TP time is PPS_MATCH_TOLERANCE_US or
+   * more from the clock's own time is dropped (a lost pulse or message
+   * paired the wrong second). PPS_RELOCK_PAIRS such pairs in a row that
+   * agree with each other mean the clock is the one that is wrong (a bad
+   * first anchor), and the last of them becomes the anchor. After
+   * PPS_HOLDOVER_S without an anchor any pair is taken again.
+   *
+   * @param local Local time of the edge
+   */
+  void add_pulse(uint64_t local);
+
+  /** Convert TIM-TP time to microseconds since 1970-01-01 UTC */
+  static uint64_t timepulse_utc(const UBX_TIM_TP_data_t &tp);
+
+private:
+  Ublox_GPS *_gps;
+  InterruptIn *_pps;
+  Timer _ticker;
+
+  // Anchor and rate (written in the interrupt, read under a critical section)
+  uint64_t _anchorLocal;
+  uint64_t _anchorUtc;
+  int32_t _rateError;
+  bool _rateKnown;
+  uint32_t _anchors;
+  uint64_t _lastReturned;
+  uint8_t _mismatches;       // consecutive pairs that disagree with the clock
+  int64_t _mismatchOffset;   // clock - TIM-TP time of the first of them
+
+  // TIM-TP waiting for its pulse
+  volatile bool _pendingValid;
+  uint64_t _pendingUtc;
+  uint64_t _pendingLocal;
+
+  void pps_rise();
+  void timepulse_received(const ubxPacket *msg);
+  uint64_t utc_at(uint64_t local);
+};
+
+#endif
@@ -0,0 +1,144 @@
+#include "RadioCoordinator.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS and 9603
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+RadioCoordinator::RadioCoordinator(Ublox_GPS *gps, RockBlock9603 *modem) {
+  _gps = gps;
+  _modem = modem;
+  _busy = false;
+  _window = false;
+  _baseRateMs = RADIO_BASE_RATE_MS;
+  _recovering = false;
+  _recoveryMs = 0;
+  _recoveries = 0;
+  memset(&_metrics, 0, sizeof(_metrics));
+}
+
+RadioCoordinator::~RadioCoordinator() {
+
+}
+
+/* The snapshot is taken before the radio is marked busy: the receiver has
+ * not been disturbed yet, and this is the position the message will carry.
+ */
+// Status: Ready for testing
+bool RadioCoordinator::prepare(GPSFix &fix) {
+  bool fresh = false;
+  if ((_gps != NULL) && _gps->getPVT(RADIO_SNAPSHOT_WAIT_MS)) {
+    FixHistory::from_receiver(_gps, fix);
+    fresh = fix.positionFix;
+  } else {
+    fix.positionFix = false;
+  }
+  if (fresh) _metrics.snapshots++;
+  session_started(Kernel::Clock::now());
+  return fresh;
+}
+
+// Status: Ready for testing
+SessionStatus RadioCoordinator::transmit() {
+  if (!_busy) session_started(Kernel::Clock::now());
+  SessionStatus status = _modem->transmit_message();
+  session_ended(Kernel::Clock::now());
+  return status;
+}
+
+/* A period other than the window's means someone else set the rate while
+ * the window was open, and theirs is the one to keep.
+ */
+// Status: Ready for testing
+void RadioCoordinator::update() {
+  if (!_window || _busy) return;
+  if (Kernel::Clock::now() - _sessionEnd < seconds(RADIO_WINDOW_S)) return;
+  if (_gps == NULL) {
+    _window = false;
+    return;
+  }
+  uint16_t current = _gps->getMeasurementRate();
+  if (((current != 0) && (current != 1000 / RADIO_WINDOW_RATE)) || _gps->setMeasurementRate(_baseRateMs))
+    _window = false;
+}
+
+void RadioCoordinator::session_started(Kernel::Clock::time_point t) {
+  _busy = true;
+  _recovering = false;
+  _metrics.sessions++;
+}
+
+/* The period is read (in ms, so rates below 1 Hz survive) before the window
+ * opens so update() can put it back. A session that ends inside an open
+ * window keeps the period saved first.
+ */
+// Status: Ready for testing
+void RadioCoordinator::session_ended(Kernel::Clock::time_point t) {
+  _busy = false;
+  _sessionEnd = t;
+  _recovering = true;
+  if (_gps == NULL) {
+    _window = true;
+    return;
+  }
+  if (!_window) {
+    _baseRateMs = _gps->getMeasurementRate();
+    if (_baseRateMs == 0) _baseRateMs = RADIO_BASE_RATE_MS;
+  }
+  if (_gps->setMeasurementRate(1000 / RADIO_WINDOW_RATE))
+    _window = true;
+}
+
+RadioFixPeriod RadioCoordinator::period(Kernel::Clock::time_point t) {
+  if (_busy) return RADIO_DURING;
+  if ((_metrics.sessions > 0) && (t - _sessionEnd < milliseconds(RADIO_GUARD_MS))) return RADIO_AFTER;
+  return RADIO_QUIET;
+}
+
+bool RadioCoordinator::record_fix(const GPSFix &fix) {
+  return record_fix(fix, Kernel::Clock::now());
+}
+
+// Status: Ready for testing
+bool RadioCoordinator::record_fix(const GPSFix &fix, Kernel::Clock::time_point t) {
+  RadioFixPeriod p = period(t);
+  _metrics.fixes[p]++;
+  if (!fix.positionFix) {
+    _metrics.lost[p]++;
+  } else if (_recovering) {
+    _recoveryMs += duration_cast<milliseconds>(t - _sessionEnd).count();
+    _recoveries++;
+    _recovering = false;
+  }
+  return p == RADIO_QUIET;
+}
+
+bool RadioCoordinator::busy() {
+  return _busy;
+}
+
+bool RadioCoordinator::window_open() {
+  return _window;
+}
+
+RadioMetrics RadioCoordinator::get_metrics() {
+  RadioMetrics m = _metrics;
+  m.avgRecoveryMs = _recoveries ? (uint32_t)(_recoveryMs / _recoveries) : 0;
+  return m;
+}
+
+void RadioCoordinator::print_metrics() {
+  RadioMetrics m = get_metrics();
+  printf("Coordinated sessions: %lu (%lu with a fresh fix)\r\n", (unsigned long)m.sessions,
+    (unsigned long)m.snapshots);
+  printf("Fixes lost: quiet %lu/%lu, during %lu/%lu, after %lu/%lu\r\n",
+    (unsigned long)m.lost[RADIO_QUIET], (unsigned long)m.fixes[RADIO_QUIET],
+    (unsigned long)m.lost[RADIO_DURING], (unsigned long)m.fixes[RADIO_DURING],
+    (unsigned long)m.lost[RADIO_AFTER], (unsigned long)m.fixes[RADIO_AFTER]);
+  printf("Average recovery after a session: %lu ms\r\n", (unsigned long)m.avgRecoveryMs);
+}
@@ -0,0 +1,140 @@
+/** Coordination of GPS use around Iridium sessions
+ *
+ * The RockBLOCK transmits at up to 1.6 W a few centimetres from the GPS
+ * antenna, and during an SBD session the receiver can lose lock. Until now
+ * GPS reads and +SBDIX sessions overlapped at random, so a message could
+ * carry a position from before a dropout and a fix lost to our own
+ * transmitter looked like a GPS fault. The coordinator orders things:
+ *
+ *  - prepare() takes a fresh NAV-PVT snapshot for the message about to go
+ *  - from then until RADIO_GUARD_MS after the session, fixes are recorded
+ *    but not judged (record_fix returns false)
+ *  - transmit() runs the session and opens a high rate GPS window so the
+ *    receiver's recovery is tracked closely; update() closes it again and
+ *    puts back the measurement period the receiver had before, unless
+ *    something else (e.g. FlightPhaseModel) changed it in the meantime
+ *
+ * Fix outcomes are counted separately while the radio is quiet, during a
+ * session and in the guard time after it, so the loss to interference can be
+ * compared with the background rate.
+ *
+ * Typical use:
+ *    coordinator.prepare(fix);               // just before the session
+ *    msg.generateGPSBytes(fix);
+ *    modem.write_binary_message(msg.data(), msg.msgLength);
+ *    int bars = scheduler.current_bars();
+ *    SessionStatus status = coordinator.transmit();
+ *    bool sent = (status.moStatus >= 0) && (status.moStatus <= 4);
+ *    scheduler.record_session(sent, bars, status.duration, sent ? msg.msgLength : 0);
+ *    ...
+ *    coordinator.update();                   // in the main loop
+ *    if (coordinator.record_fix(fix)) ...    // judge fix quality
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef RADIOCOORDINATOR_H
+#define RADIOCOORDINATOR_H
+
+#include <mbed.h>
+#include "ublox.h"
+#include "RockBlock9603.h"
+#include "SBDmessage.h"
+#include "FixHistory.h"
+
+#define RADIO_SNAPSHOT_WAIT_MS 1100   // longest wait for the pre-session NAV-PVT
+#define RADIO_GUARD_MS 5000           // fixes this soon after a session are not judged
+#define RADIO_WINDOW_RATE 4           // navigation rate (Hz) in the window after a session
+#define RADIO_WINDOW_S 30             // length of that window
+#define RADIO_BASE_RATE_MS 1000       // measurement period (ms) put back if the receiver's own could not be read
+
+enum RadioFixPeriod {
+  RADIO_QUIET = 0,                    // no session in progress or just finished
+  RADIO_DURING,                       // between prepare() and the end of the session
+  RADIO_AFTER,                        // within RADIO_GUARD_MS of the end
+  RADIO_PERIODS
+};
+
+struct RadioMetrics {
+  uint32_t sessions;                  // sessions coordinated
+  uint32_t snapshots;                 // sessions that went out with a fresh fix
+  uint32_t fixes[RADIO_PERIODS];      // fixes recorded in each period
+  uint32_t lost[RADIO_PERIODS];       // of those, fixes without a position
+  uint32_t avgRecoveryMs;             // session end to first good fix
+};
+
+class RadioCoordinator {
+
+public:
+  /** Create a coordinator
+   *
+   * @param gps Receiver next to the modem (NULL records fixes only)
+   * @param modem Iridium modem
+   */
+  RadioCoordinator(Ublox_GPS *gps, RockBlock9603 *modem);
+
+  ~RadioCoordinator();
+
+  /** Take a fresh fix for the next message and mark the radio busy
+   *
+   * @param fix Filled in from a new NAV-PVT
+   * @returns true if the receiver answered with a position fix
+   */
+  bool prepare(GPSFix &fix);
+
+  /** Run the session (AT+SBDIX) and open the post-session GPS window
+   *
+   * @returns the modem's session result
+   */
+  SessionStatus transmit();
+
+  /** Close the post-session window once it has run its course (main loop) */
+  void update();
+
+  /** Record a fix outcome
+   *
+   * @returns true if the fix should be judged (the radio is quiet)
+   */
+  bool record_fix(const GPSFix &fix);
+
+  /** Record a fix outcome at a given time (for sessions run elsewhere and tests) */
+  bool record_fix(const GPSFix &fix, Kernel::Clock::time_point t);
+
+  /** Mark the start of a session run elsewhere */
+  void session_started(Kernel::Clock::time_point t);
+
+  /** Mark the end of a session run elsewhere */
+  void session_ended(Kernel::Clock::time_point t);
+
+  /** Period a time falls in */
+  RadioFixPeriod period(Kernel::Clock::time_point t);
+
+  /** True while a session is being prepared or run */
+  bool busy();
+
+  /** True while the high rate window is open */
+  bool window_open();
+
+  /** Counters since the coordinator was created */
+  RadioMetrics get_metrics();
+
+  /** Print the counters to the console */
+  void print_metrics();
+
+private:
+  Ublox_GPS *_gps;
+  RockBlock9603 *_modem;
+  bool _busy;
+  bool _window;
+  uint16_t _baseRateMs;               // receiver's measurement period before the window
+  bool _recovering;
+  Kernel::Clock::time_point _sessionEnd;
+  uint64_t _recoveryMs;
+  uint32_t _recoveries;
+  RadioMetrics _metrics;
+};
+
+#endif
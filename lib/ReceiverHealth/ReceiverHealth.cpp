@@ -0,0 +1,123 @@
+#include "ReceiverHealth.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+ReceiverHealth::ReceiverHealth(Ublox_GPS *gps) {
+  _gps = gps;
+  _period = seconds(RH_PERIOD_S);
+  _sampled = false;
+  _lastSample = 0s;
+  clear();
+  _clock.start();
+}
+
+ReceiverHealth::~ReceiverHealth() {
+
+}
+
+bool ReceiverHealth::begin() {
+  return _gps->setJammingMonitor(true);
+}
+
+void ReceiverHealth::set_period(seconds period) {
+  _period = period;
+}
+
+// Status: Ready for testing
+bool ReceiverHealth::update() {
+  std::chrono::microseconds now = _clock.elapsed_time();
+  if (_sampled && (now - _lastSample < _period)) return false;
+  _sampled = true;
+  _lastSample = now;
+  sample();
+  return true;
+}
+
+/* MON-RF is tried first unless the receiver is known to lack it, since
+ * protocol 27 and above no longer report jamming in MON-HW.
+ */
+// Status: Ready for testing
+bool ReceiverHealth::sample() {
+  bool read = false;
+  if (!_gps->capabilitiesKnown() || _gps->hasCapability(UBX_CAP_MON_RF)) {
+    UBX_MON_RF_data_t rf;
+    if (_gps->getRFStatus(rf, RH_POLL_WAIT_MS) && (rf.nBlocks > 0)) {
+      add_rf(rf);
+      read = true;
+    }
+  }
+  if (!read && (!_gps->capabilitiesKnown() || _gps->hasCapability(UBX_CAP_MON_HW))) {
+    UBX_MON_HW_data_t hw;
+    if (_gps->getHardwareStatus(hw, RH_POLL_WAIT_MS)) {
+      add_hardware(hw);
+      read = true;
+    }
+  }
+
+  UBX_MON_TXBUF_data_t tx;
+  UBX_MON_RXBUF_data_t rx;
+  if (_gps->getTxBufferStatus(tx, RH_POLL_WAIT_MS)) {
+    if (!_gps->getRxBufferStatus(rx, RH_POLL_WAIT_MS))
+      memset(&rx, 0, sizeof(rx));
+    add_buffers(tx, rx);
+  }
+  return read;
+}
+
+// Status: Ready for testing
+ReceiverHealthSummary ReceiverHealth::take_summary() {
+  ReceiverHealthSummary summary = _summary;
+  clear();
+  return summary;
+}
+
+void ReceiverHealth::add_hardware(const UBX_MON_HW_data_t &hw) {
+  add(hw.jamInd, hw.agcCnt, hw.noisePerMS, hw.aStatus, (hw.flags >> 2) & 0x03);
+}
+
+void ReceiverHealth::add_rf(const UBX_MON_RF_data_t &rf) {
+  for (int i = 0; (i < rf.nBlocks) && (i < UBX_MON_RF_MAX_BLOCKS); i++)
+    add(rf.blocks[i].jamInd, rf.blocks[i].agcCnt, rf.blocks[i].noisePerMS, rf.blocks[i].antStatus,
+      rf.blocks[i].flags & 0x03);
+}
+
+// Status: Ready for testing
+void ReceiverHealth::add_buffers(const UBX_MON_TXBUF_data_t &tx, const UBX_MON_RXBUF_data_t &rx) {
+  // Port 0 is I2C (DDC). Bit 0 of errors is its limit, bit 7 means an allocation failed.
+  if (tx.peakUsage[0] > _summary.txPeakUsage) _summary.txPeakUsage = tx.peakUsage[0];
+  if (rx.peakUsage[0] > _summary.rxPeakUsage) _summary.rxPeakUsage = rx.peakUsage[0];
+  if (tx.errors & 0x81) _summary.outputLost = true;
+}
+
+// Status: Ready for testing
+void ReceiverHealth::add(uint8_t jamInd, uint16_t agcCnt, uint16_t noisePerMS, uint8_t antStatus, uint8_t jammingState) {
+  if (_summary.samples == 0) {
+    _summary.agcCnt = agcCnt;
+    _summary.antStatus = antStatus;
+  }
+  _summary.samples++;
+  if (jamInd > _summary.jamInd) _summary.jamInd = jamInd;
+  if (agcCnt < _summary.agcCnt) _summary.agcCnt = agcCnt;
+  if (noisePerMS > _summary.noisePerMS) _summary.noisePerMS = noisePerMS;
+  if (jammingState > _summary.jammingState) _summary.jammingState = jammingState;
+  if (antenna_rank(antStatus) >= antenna_rank(_summary.antStatus)) _summary.antStatus = antStatus;
+}
+
+// OK is best, then init and unknown, then short and open
+int ReceiverHealth::antenna_rank(uint8_t antStatus) {
+  if (antStatus == RH_ANTENNA_OK) return 0;
+  if ((antStatus == RH_ANTENNA_SHORT) || (antStatus == RH_ANTENNA_OPEN)) return 2;
+  return 1;
+}
+
+void ReceiverHealth::clear() {
+  memset(&_summary, 0, sizeof(_summary));
+}
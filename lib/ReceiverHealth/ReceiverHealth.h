@@ -0,0 +1,103 @@
+/** Low rate collection of GPS receiver health for the SBD frame
+ *
+ * A gap in the track can come from RF interference, from the antenna, or
+ * from the command module not reading the receiver fast enough over I2C.
+ * Every RH_PERIOD_S the receiver is polled for:
+ *
+ *  - jamming indicator, noise floor, AGC, antenna status and jamming state
+ *    (MON-RF on protocol 27 and above, MON-HW on older receivers)
+ *  - peak usage of its I2C transmit and receive buffers, and whether output
+ *    was lost because the transmit buffer filled (MON-TXBUF, MON-RXBUF)
+ *
+ * The worst readings since the previous frame are kept and go into the
+ * frame's health block (see SBDmessage::generateHealthBytes), 7 bytes per
+ * message.
+ *
+ * Typical use:
+ *    health.begin();                     // turn on the interference monitor
+ *    ...
+ *    health.update();                    // in the main loop
+ *    msg->generateHealthBytes(health.take_summary());   // each frame
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef ReceiverHealth_H
+#define ReceiverHealth_H
+
+#include <mbed.h>
+#include "SBDmessage.h"
+#include "ublox.h"
+
+#define RH_PERIOD_S 60              // time between health polls
+#define RH_POLL_WAIT_MS 500         // timeout for each poll
+
+// Antenna status, as reported in MON-HW and MON-RF
+#define RH_ANTENNA_INIT 0
+#define RH_ANTENNA_UNKNOWN 1
+#define RH_ANTENNA_OK 2
+#define RH_ANTENNA_SHORT 3
+#define RH_ANTENNA_OPEN 4
+
+class ReceiverHealth {
+
+public:
+  /** Create a collector for the given receiver
+   *
+   * @param gps Pointer to the receiver
+   */
+  ReceiverHealth(Ublox_GPS *gps);
+
+  ~ReceiverHealth();
+
+  /** Turn on the receiver's interference monitor (CFG-ITFM)
+   *
+   * @returns false if the receiver refused (jamming state then stays 0)
+   */
+  bool begin();
+
+  /** Set the time between polls */
+  void set_period(seconds period);
+
+  /** Poll the receiver if a period has passed since the last poll (main loop)
+   *
+   * @returns true if the receiver was polled
+   */
+  bool update();
+
+  /** Poll the receiver now
+   *
+   * @returns true if the hardware or RF status was read
+   */
+  bool sample();
+
+  /** Return the summary since the last call and start a new one
+   */
+  ReceiverHealthSummary take_summary();
+
+  /** Add a MON-HW reading */
+  void add_hardware(const UBX_MON_HW_data_t &hw);
+
+  /** Add a MON-RF reading (all RF blocks) */
+  void add_rf(const UBX_MON_RF_data_t &rf);
+
+  /** Add I2C buffer readings */
+  void add_buffers(const UBX_MON_TXBUF_data_t &tx, const UBX_MON_RXBUF_data_t &rx);
+
+private:
+  Ublox_GPS *_gps;
+  Timer _clock;
+  seconds _period;
+  bool _sampled;
+  std::chrono::microseconds _lastSample;
+  ReceiverHealthSummary _summary;
+
+  void add(uint8_t jamInd, uint16_t agcCnt, uint16_t noisePerMS, uint8_t antStatus, uint8_t jammingState);
+  static int antenna_rank(uint8_t antStatus);
+  void clear();
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "ATLineReader.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Tested with terminal
+ *  - Lab tested with 9603
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+ATLineReader::ATLineReader(FileHandle *fh) {
+  _fh = fh;
+  _timeout = milliseconds(5000);
+  _rxHead = 0;
+  _rxTail = 0;
+  _lineLength = 0;
+}
+
+void ATLineReader::set_timeout(milliseconds timeout) {
+  _timeout = timeout;
+}
+
+// Status: Ready for testing
+bool ATLineReader::fill(milliseconds timeout) {
+  pollfh fhs;
+  fhs.fh = _fh;
+  fhs.events = POLLIN;
+  if (poll(&fhs, 1, timeout.count()) <= 0) return false;
+  // Take everything available (up to a chunk) in one call
+  ssize_t n = _fh->read(_rx, AT_RX_CHUNK);
+  if (n <= 0) return false;
+  _rxHead = 0;
+  _rxTail = n;
+  return true;
+}
+
+// Status: Ready for testing
+const char* ATLineReader::read_line() {
+  Timer t;
+  t.start();
+  while (true) {
+    while (_rxHead < _rxTail) {
+      char c = _rx[_rxHead++];
+      if ((c == '\r') || (c == '\n')) {
+        if (_lineLength > 0) { // end of a non-empty line
+          _line[_lineLength] = 0;
+          _lineLength = 0;
+          return _line;
+        }
+      } else if (_lineLength < AT_LINE_LENGTH - 1) {
+        _line[_lineLength++] = c;
+      }
+    }
+    milliseconds elapsed = duration_cast<milliseconds>(t.elapsed_time());
+    if ((elapsed >= _timeout) || !fill(_timeout - elapsed))
+      return NULL;
+  }
+}
+
+// Status: Ready for testing
+const char* ATLineReader::wait_for(const char *prefix) {
+  const char *line;
+  size_t n = strlen(prefix);
+  while ((line = read_line()) != NULL) {
+    if (strncmp(line, prefix, n) == 0) {
+      line += n;
+      while (*line == ' ') line++;
+      return line;
+    }
+    if (starts_with(line, "ERROR")) return NULL;
+  }
+  return NULL;
+}
+
+// Status: Ready for testing
+bool ATLineReader::wait_for_OK() {
+  const char *line;
+  while ((line = read_line()) != NULL) {
+    if (starts_with(line, "OK")) return true;
+    if (starts_with(line, "ERROR")) return false;
+  }
+  return false;
+}
+
+void ATLineReader::flush() {
+  _rxHead = _rxTail;
+  _lineLength = 0;
+  // Bounded so a modem that keeps talking cannot hold the caller here
+  int discarded = 0;
+  while ((discarded < AT_FLUSH_LIMIT) && _fh->readable()) {
+    ssize_t n = _fh->read(_rx, AT_RX_CHUNK);
+    if (n <= 0) break;
+    discarded += n;
+  }
+  _rxHead = 0;
+  _rxTail = 0;
+}
+
+bool ATLineReader::starts_with(const char *s, const char *prefix) {
+  while (*prefix) {
+    if (*s++ != *prefix++) return false;
+  }
+  return true;
+}
+
+// Status: Ready for testing
+int ATLineReader::parse_ints(const char *s, int *values, int maxValues) {
+  int count = 0;
+  while (*s && (count < maxValues)) {
+    while ((*s == ' ') || (*s == ',')) s++;
+    bool negative = false;
+    if (*s == '-') {
+      negative = true;
+      s++;
+    }
+    if ((*s < '0') || (*s > '9')) break;
+    int v = 0;
+    while ((*s >= '0') && (*s <= '9')) {
+      v = 10*v + (*s - '0');
+      s++;
+    }
+    values[count++] = negative ? -v : v;
+  }
+  return count;
+}
+
+// Status: Ready for testing
+bool ATLineReader::parse_uint64(const char *s, uint64_t *value) {
+  uint64_t v = 0;
+  bool found = false;
+  while (*s == ' ') s++;
+  while ((*s >= '0') && (*s <= '9')) {
+    v = 10*v + (*s - '0');
+    s++;
+    found = true;
+  }
+  if (found) *value = v;
+  return found;
+}
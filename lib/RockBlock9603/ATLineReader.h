@@ -0,0 +1,92 @@
+/** Lightweight line reader and tokenizer for AT command responses
+ *
+ * Reads directly from the serial FileHandle in chunks, splits the stream into
+ * lines in a fixed buffer and parses numeric fields without scanf. Nothing is
+ * allocated after construction.
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 1.0
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef ATLINEREADER_H
+#define ATLINEREADER_H
+
+#include <mbed.h>
+#include "platform/mbed_poll.h"
+
+using namespace std::chrono;
+
+#define AT_RX_CHUNK 64        // bytes pulled from serial buffer per read
+#define AT_LINE_LENGTH 128    // longest line kept (extra chars are dropped)
+#define AT_FLUSH_LIMIT 1024   // most bytes discarded by one flush
+
+class ATLineReader {
+
+public:
+  /** Create a line reader on an open serial FileHandle
+   *
+   * @param fh Serial port (e.g. BufferedSerial)
+   */
+  ATLineReader(FileHandle *fh);
+
+  /** Set the timeout used when waiting for a line
+   */
+  void set_timeout(milliseconds timeout);
+
+  /** Read the next non-empty line
+   *
+   * @returns pointer to null-terminated line (valid until next read) or
+   *   NULL on timeout
+   */
+  const char* read_line();
+
+  /** Read lines until one starts with prefix
+   *
+   * @param prefix Expected start of line (e.g. "+CSQ:")
+   * @returns pointer to the text after prefix (leading spaces skipped) or
+   *   NULL on timeout or if the modem reports ERROR
+   */
+  const char* wait_for(const char *prefix);
+
+  /** Read lines until OK (true) or ERROR/timeout (false)
+   */
+  bool wait_for_OK();
+
+  /** Discard any bytes already received (at most AT_FLUSH_LIMIT)
+   */
+  void flush();
+
+  /** Parse comma/space separated signed integers
+   *
+   * @param s Text to parse
+   * @param values Array to store the numbers
+   * @param maxValues Size of values
+   * @returns number of values parsed
+   */
+  static int parse_ints(const char *s, int *values, int maxValues);
+
+  /** Parse an unsigned 64-bit decimal number (e.g. IMEI)
+   *
+   * @returns true if at least one digit was found
+   */
+  static bool parse_uint64(const char *s, uint64_t *value);
+
+  /** True if s begins with prefix */
+  static bool starts_with(const char *s, const char *prefix);
+
+private:
+  FileHandle *_fh;
+  milliseconds _timeout;
+  char _rx[AT_RX_CHUNK];
+  int _rxHead;
+  int _rxTail;
+  char _line[AT_LINE_LENGTH];
+  int _lineLength;
+
+  /** Wait for more serial bytes (false on timeout) */
+  bool fill(milliseconds timeout);
+};
+
+#endif
@@ -14,6 +14,7 @@
 RockBlock9603::RockBlock9603(PinName tx_pin, PinName rx_pin, PinName ri_pin) {
   _serial = new BufferedSerial(tx_pin, rx_pin, 19200);
   _at = new ATCmdParser(_serial, "\r");
+  _reader = new ATLineReader(_serial);
   _RI = new InterruptIn(ri_pin);
   // Set initial state of flags
   ringAlert = false;
@@ -22,9 +23,13 @@ RockBlock9603::RockBlock9603(PinName tx_pin, PinName rx_pin, PinName ri_pin) {
   verboseLogging = false;
   iridiumStatus = true;
   startLogLength = 0;
+  _loadedLength = 0;
+  memset(&_counters, 0, sizeof(_counters));
   _at->set_timeout(AT_TIMEOUT_NORMAL);
+  _reader->set_timeout(milliseconds(AT_TIMEOUT_NORMAL));
+  _reader->flush();
   _at->send("AT&K0");
-  _at->recv("OK");
+  _reader->wait_for_OK();
   // at.oob("Invalid Position Fix", callback(this, &NAL9602::_oob_invalid_fix));
 }
 
@@ -36,79 +41,50 @@ RockBlock9603::~RockBlock9603(void) {
 
 // Status: Tested with terminal
 void RockBlock9603::radio_on(void) {
+  _reader->flush();
   _at->send("AT*R1");
-  iridiumStatus = _at->recv("OK");
+  iridiumStatus = _reader->wait_for_OK();
 }
 
 // Status: Tested with terminal
 void RockBlock9603::radio_off(void) {
+  _reader->flush();
   _at->send("AT*R0");
-  iridiumStatus = !_at->recv("OK");
+  iridiumStatus = !_reader->wait_for_OK();
 }
 
 // Status: Ready for testing
 void RockBlock9603::echo_until_timeout(milliseconds listenTime) {
+  // Read through _reader so bytes it has already buffered are not skipped
   Timer t;
-  char buff[BUFFLENGTH];
-  unsigned int i = 0;
-  unsigned int j = 0;
+  milliseconds elapsed;
   t.start();
-  while (t.elapsed_time() <listenTime) {  // Be patient and listen for listenTime
-    while ((_serial->readable()) && (i<BUFFLENGTH)) {
-      buff[i] = _at->getc();
-      i++;
-    }
-    while ((j<i) && (!_serial->readable())) {
-      printf("%c",buff[j]);
-      j++;
-    }
-    for (unsigned int k = 0; k<j; k++) {
-      buff[k] = buff[j+k];
-      i = i - j;
-      j = 0;
-    }
+  while ((elapsed = duration_cast<milliseconds>(t.elapsed_time())) < listenTime) {  // Be patient and listen for listenTime
+    _reader->set_timeout(listenTime - elapsed);
+    const char *line = _reader->read_line();
+    if (line) printf("%s\n", line);
   }
+  _reader->set_timeout(milliseconds(AT_TIMEOUT_NORMAL));
 }
 
 void RockBlock9603::echo_until_OK() {
-  char buf[80] = {0};
-  unsigned int i = 0;
-  char c;
-  bool doneLeadingWS = false;
-  bool done = false;
-  while ((buf[0] != 'O') && (buf[1] != 'K')) { // does buf start "OK"?
-    while (!done) { // "line" is defined to be printable-char surrounded by non-printable
-      c = _at->getc();
-      if (!doneLeadingWS) { // ignore leading non-printables
-        if ((c >= 0x20) && (c <= 0x7E)) { // printable char range
-          doneLeadingWS = true;
-        }
-      } else if (c < 0x20) { // done if find trailing non-printables
-        done = true;
-      }
-      if ((c >= 0x20) && (c <= 0x7E)) {
-        if (i < sizeof(buf)-1) { // don't overflow the buffer!
-          buf[i] = c;
-          i++;
-        }
-      }
-    }
-    buf[i] = 0; // terminate the string
-    if ((buf[0] != 'O') && (buf[1] != 'K')) printf("\t%s\n", buf);
-    doneLeadingWS = false;
-    done =false;
-    i = 0;
+  const char *line;
+  while ((line = _reader->read_line()) != NULL) {
+    if (ATLineReader::starts_with(line, "OK")) break;
+    printf("\t%s\n", line);
   }
 }
 
 // Status: Tested with terminal
 void RockBlock9603::dump_manufacturer() {
-  char buf[80];
+  const char *line = NULL;
+  _reader->flush();
   _at->send("AT+GMI");
-  if (_at->recv("AT+GMI")) {
-    _at->recv("%79s\r\n", buf);
-    _at->recv("OK");
-    printf("Manufacturer = %s\n", buf);
+  if (_reader->wait_for("AT+GMI"))
+    line = _reader->read_line();
+  if (line) {
+    printf("Manufacturer = %s\n", line);
+    _reader->wait_for_OK();
   } else {
     printf("Error reading manufacturer from RockBlock\n");
   }
@@ -117,8 +93,9 @@ void RockBlock9603::dump_manufacturer() {
 // // Status: Tested with terminal
 void RockBlock9603::dump_model() {
   printf("Model:");
+  _reader->flush();
   _at->send("AT+GMM");
-  _at->recv("AT+GMM");
+  _reader->wait_for("AT+GMM");
   // Normal recv doesn't work for some reason on model string
   echo_until_OK();
 }
@@ -126,39 +103,44 @@ void RockBlock9603::dump_model() {
 // // Status: Tested with terminal
 void RockBlock9603::dump_revision() {
   printf("Iridium revision info\n");
+  _reader->flush();
   _at->send("AT+GMR");
-  _at->recv("AT+GMR");
+  _reader->wait_for("AT+GMR");
   echo_until_OK();
 }
 
 // Status: Tested with terminal
 void RockBlock9603::dump_IMEI() {
-  uint64_t imei;
-  _at->send("AT+GSN");
-  _at->recv("AT+GSN");
-  _at->recv("%llu\r\n", &imei);
-  _at->recv("OK");
+  uint64_t imei = get_IMEI();
   printf("IMEI = %llu\n", imei);
 }
 
 // Status: Tested with terminal
 uint64_t RockBlock9603::get_IMEI() {
-  uint64_t imei;
+  uint64_t imei = 0;
+  _reader->flush();
   _at->send("AT+GSN");
-  _at->recv("AT+GSN");
-  _at->recv("%llu\r\n", &imei);
-  _at->recv("OK");
+  if (_reader->wait_for("AT+GSN")) {
+    const char *line = _reader->read_line();
+    if (line) ATLineReader::parse_uint64(line, &imei);
+    _reader->wait_for_OK();
+  }
   return imei;
 }
 
 // Status: Ready for testing
 int RockBlock9603::get_last_signal_quality() {
   int bars;
-  bool argFilled;
+  bool argFilled = false;
+  const char *field;
+  _reader->flush();
   _at->send("AT+CSQF");
   // Expected response has form: +CSQF:<rssi>
-  _at->recv("AT+CSQF");
-  argFilled = _at->recv("+CSQF:%d\r\n", &bars);
+  field = _reader->wait_for("+CSQF:");
+  if (field) {
+    argFilled = (ATLineReader::parse_ints(field, &bars, 1) == 1);
+    _reader->wait_for_OK();
+  }
   if (argFilled) {
     if ((bars>=0) && (bars<=5))
       return bars;
@@ -171,11 +153,16 @@ int RockBlock9603::get_last_signal_quality() {
 // Status: Ready for testing
 int RockBlock9603::get_new_signal_quality() {
   int bars;
-  bool argFilled;
+  bool argFilled = false;
+  const char *field;
+  _reader->flush();
   _at->send("AT+CSQ");
   // Expected response has form: +CSQ:<rssi>
-  _at->recv("AT+CSQ");
-  argFilled = _at->recv("+CSQ:%d\r\n", &bars);
+  field = _reader->wait_for("+CSQ:");
+  if (field) {
+    argFilled = (ATLineReader::parse_ints(field, &bars, 1) == 1);
+    _reader->wait_for_OK();
+  }
   if (argFilled) {
     if ((bars>=0) && (bars<=5))
       return bars;
@@ -188,14 +175,116 @@ int RockBlock9603::get_new_signal_quality() {
 // Status:  Ready for testing
 BufferStatus RockBlock9603::get_buffer_status() {
   BufferStatus bs;
+  int v[6] = {0};
+  _reader->flush();
   _at->send("AT+SBDSX");
-  _at->recv("AT+SBDSX");
-  _at->recv("+SBDSX: %d,%d,%d,%d,%d,%d\r\n", &bs.outgoingFlag, &bs.outgoingMsgNum,
-    &bs.incomingFlag, &bs.incomingMsgNum, &bs.raFlag, &bs.numMsgWaiting);
-  _at->recv("OK");
+  // Expected response has form: +SBDSX: <MO flag>, <MOMSN>, <MT flag>, <MTMSN>, <RA flag>, <msg waiting>
+  const char *field = _reader->wait_for("+SBDSX:");
+  if (field) {
+    ATLineReader::parse_ints(field, v, 6);
+    _reader->wait_for_OK();
+  }
+  bs.outgoingFlag = v[0];
+  bs.outgoingMsgNum = v[1];
+  bs.incomingFlag = v[2];
+  bs.incomingMsgNum = v[3];
+  bs.raFlag = v[4];
+  bs.numMsgWaiting = v[5];
   return bs;
 }
 
+// Status: Ready for testing
+int RockBlock9603::write_binary_message(const char* data, int length) {
+  int err;
+  if ((length < 1) || (length > SBD_MO_MAX_LENGTH))
+    return -1;
+  _reader->flush();
+  _at->send("AT+SBDWB=%d", length);
+  if (!_reader->wait_for("READY")) {
+    _counters.writeErrors++;
+    return -2;
+  }
+  // Stream message straight from caller's buffer, then 2-byte sum
+  unsigned short checksum = 0;
+  for (int i = 0; i < length; i++)
+    checksum += (unsigned char)data[i];
+  _at->write(data, length);
+  _at->putc((char)(checksum >> 8));
+  _at->putc((char)(checksum & 0xFF));
+  /* Status codes
+   *   0 = SBD message successfully written
+   *   1 = SBD message write timeout
+   *   2 = SBD message checksum does not match
+   *   3 = SBD message size is not correct
+   */
+  const char *line = _reader->read_line();
+  if (!line || (ATLineReader::parse_ints(line, &err, 1) != 1)) {
+    _counters.writeErrors++;
+    return -3;
+  }
+  _reader->wait_for_OK();
+  if (err == 0) {
+    _loadedLength = length;
+    _counters.writes++;
+  } else {
+    _counters.writeErrors++;
+  }
+  return err;
+}
+
+// Status: Ready for testing
+SessionStatus RockBlock9603::transmit_message() {
+  SessionStatus ss;
+  Timer t;
+  ss.moStatus = -1;
+  ss.momsn = 0;
+  ss.mtStatus = 0;
+  ss.mtmsn = 0;
+  ss.mtLength = 0;
+  ss.mtQueued = 0;
+  _reader->set_timeout(milliseconds(AT_TIMEOUT_SESSION));
+  _reader->flush();
+  t.start();
+  _at->send("AT+SBDIX");
+  // Expected response has form +SBDIX: <MO status>, <MOMSN>, <MT status>, <MTMSN>, <MT length>, <MT queued>
+  const char *field = _reader->wait_for("+SBDIX:");
+  if (field) {
+    int v[6];
+    if (ATLineReader::parse_ints(field, v, 6) == 6) {
+      ss.moStatus = v[0];
+      ss.momsn = v[1];
+      ss.mtStatus = v[2];
+      ss.mtmsn = v[3];
+      ss.mtLength = v[4];
+      ss.mtQueued = v[5];
+    }
+    _reader->wait_for_OK();
+  }
+  t.stop();
+  _reader->set_timeout(milliseconds(AT_TIMEOUT_NORMAL));
+  ss.duration = duration_cast<milliseconds>(t.elapsed_time());
+
+  if (ss.mtStatus == 1) {
+    messageAvailable = true;
+    incomingMessageLength = ss.mtLength;
+  }
+  if (ss.mtQueued == 0)
+    ringAlert = false;
+
+  _counters.sessions++;
+  _counters.lastSessionMs = ss.duration.count();
+  _counters.sessionTimeMs += ss.duration.count();
+  if ((ss.moStatus >= 0) && (ss.moStatus <= 4)) {
+    _counters.moSuccesses++;
+    _counters.bytesDelivered += _loadedLength;
+  }
+  return ss;
+}
+
+SessionCounters RockBlock9603::get_session_counters() {
+  return _counters;
+}
+
 
 
 
@@ -14,6 +14,7 @@
 #define ROCKBLOCK9603_H
 
 #include "mbed.h"
+#include "ATLineReader.h"
 // #include "SBDmessage.h"
 // #include "FlightParameters.h"
 
@@ -27,6 +28,9 @@ using namespace std::chrono;
 
 #define AT_TIMEOUT_NORMAL 5000
 #define AT_TIMEOUT_LONG   30000
+#define AT_TIMEOUT_SESSION 60000  // +SBDIX can take most of a minute
+
+#define SBD_MO_MAX_LENGTH 340
 
 struct NetworkRegistration
 {
@@ -34,6 +38,35 @@ struct NetworkRegistration
   int err;
 };
 
+/** Result of an SBD session (+SBDIX)
+ *
+ * MO status 0-4 means the MO message was transferred; 5 and up are failures
+ * (see Iridium ISU AT Command Reference for the full list).
+ */
+struct SessionStatus
+{
+  int moStatus;     // -1 if no +SBDIX response was parsed
+  int momsn;        // MO message sequence number
+  int mtStatus;     // 0 = no MT message, 1 = MT message received, 2 = error
+  int mtmsn;        // MT message sequence number
+  int mtLength;     // length of received MT message (bytes)
+  int mtQueued;     // MT messages still waiting at the gateway
+  milliseconds duration;  // time from AT+SBDIX to final response
+};
+
+/** Running totals of SBD write and session activity
+ */
+struct SessionCounters
+{
+  uint32_t writes;          // binary messages loaded into the MO buffer
+  uint32_t writeErrors;     // +SBDWB failures
+  uint32_t sessions;        // +SBDIX sessions attempted
+  uint32_t moSuccesses;     // sessions that delivered the MO message
+  uint32_t bytesDelivered;  // MO bytes in successful sessions
+  uint64_t sessionTimeMs;   // total time spent in sessions
+  uint32_t lastSessionMs;   // duration of most recent session
+};
+
 struct BufferStatus
 {
   int outgoingFlag;
@@ -65,7 +98,7 @@ public:
   ~RockBlock9603();
 
   /** Listen to 9603
-  * Forward output of 9603 char-by-char to console
+  * Forward output of 9603 line-by-line to console
   */
   void echo_until_timeout(milliseconds listenTime = 3s);
   void echo_until_OK();
@@ -102,6 +135,28 @@ public:
   */
   BufferStatus get_buffer_status();
 
+  /** Load binary message into MO buffer (AT+SBDWB)
+  *
+  * @param data Message bytes
+  * @param length Number of bytes (1 to 340)
+  * @returns 0 = success, 1 = write timeout, 2 = checksum mismatch,
+  *   3 = wrong size, -1 = invalid length, -2 = no READY from modem,
+  *   -3 = no status code from modem
+  */
+  int write_binary_message(const char* data, int length);
+
+  /** Start an SBD session (AT+SBDIX) to send the MO buffer
+  *
+  * Also checks for an incoming MT message (sets messageAvailable)
+  *
+  * @returns parsed +SBDIX response and session duration
+  */
+  SessionStatus transmit_message();
+
+  /** Get running totals of writes and sessions
+  */
+  SessionCounters get_session_counters();
+
   // /** Check for incoming message
   // *
   // * @returns 1 if there is an incoming SBD message available or 0 if none
@@ -164,12 +219,15 @@ public:
 
 private:
   BufferedSerial* _serial;
-  ATCmdParser* _at;
+  ATCmdParser* _at;       // used for sending commands
+  ATLineReader* _reader;  // used for parsing responses
   InterruptIn* _RI;
   // GPSCoordinates coord;
   int incomingMessageLength;
   char modemStartLog[LOG_BUFF_LENGTH];
   unsigned int startLogLength;
+  int _loadedLength;  // bytes currently in MO buffer
+  SessionCounters _counters;
 
   void _oob_invalid_fix();
 };
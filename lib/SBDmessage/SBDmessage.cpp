@@ -0,0 +1,264 @@
+#include "SBDmessage.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with 9603
+ *  - Flight tested
+ */
+
+// Status: Flight tested (with 9602)
+SBDmessage::SBDmessage() {
+  clearMessage();
+  for (int i = 0; i < MAXPODS; i++)
+    podLengths[i] = 0;
+  missionID = 0;
+  msgLength = SBD_CM_LENGTH;
+}
+
+SBDmessage::~SBDmessage() {
+
+}
+
+void SBDmessage::clearMessage() {
+  for (int i = 0; i<SBD_LENGTH; i++)
+    sbd[i] = 0;
+}
+
+// Status: Ready for testing
+void SBDmessage::setMissionID(int flightMode) {
+  if (flightMode==SBD_FLIGHT_MODE_FLIGHT) {
+    store_int16(0, missionID);
+  } else {
+    store_int16(0, -missionID);
+  }
+}
+
+// Status: Ready for testing
+char SBDmessage::getByte(uint32_t i) {
+  char val = 0;
+  if (i<SBD_LENGTH)
+    val = sbd[i];
+  else
+    MBED_ERROR( MBED_MAKE_ERROR(MBED_MODULE_APPLICATION, MBED_ERROR_CODE_INVALID_INDEX), "SBD index for getByte function must be between 0 and 339");
+  return val;
+}
+
+const char* SBDmessage::data() const {
+  return sbd;
+}
+
+// Status: Ready for testing
+void SBDmessage::store_int16(uint32_t startIndex, int16_t data) {
+  if (startIndex < SBD_LENGTH-1) {
+    sbd[startIndex] = data >> 8;
+    sbd[startIndex+1] = data;
+  } else
+    MBED_ERROR( MBED_MAKE_ERROR(MBED_MODULE_APPLICATION, MBED_ERROR_CODE_INVALID_INDEX), "SBD index for store_int16 function must be between 0 and 338");
+}
+
+// Status: Ready for testing
+void SBDmessage::store_uint16(uint32_t startIndex, uint16_t data) {
+  if (startIndex < SBD_LENGTH - 1) {
+    sbd[startIndex] = data >> 8;
+    sbd[startIndex+1] = data;
+  } else
+    MBED_ERROR( MBED_MAKE_ERROR(MBED_MODULE_APPLICATION, MBED_ERROR_CODE_INVALID_INDEX), "SBD index for store_uint16 function must be between 0 and 338");
+}
+
+// Status: Ready for testing
+void SBDmessage::store_int32(uint32_t startIndex, int32_t data) {
+  if (startIndex < SBD_LENGTH - 3) {
+    sbd[startIndex] = data >> 24;
+    sbd[startIndex+1] = data >> 16;
+    sbd[startIndex+2] = data >> 8;
+    sbd[startIndex+3] = data;
+  } else
+    MBED_ERROR( MBED_MAKE_ERROR(MBED_MODULE_APPLICATION, MBED_ERROR_CODE_INVALID_INDEX), "SBD index for store_int32 function must be between 0 and 336");
+}
+
+// Status: Ready for testing
+void SBDmessage::generateGPSBytes(const GPSFix &fix) {
+  int heading = fix.heading / 100000; // degrees * 10^-5 --> degrees
+  bool headPos = true;
+  if (heading>180) {
+    heading = 360-heading;
+    headPos = false;
+  }
+  // bitByte is a bit collection stored in byte 2 of the SBD
+  char bitByte = sbd[2] & ~0x03;  // load in current value (pod bits), dropping any earlier fix
+  bitByte |= (fix.positionFix); // bit 0 is GPS fix
+  bitByte |= (char)(headPos)<<1; // bit 1 is heading sign
+  sbd[2] = bitByte;
+  sbd[36] = sbd[36] & ~SBD_STATUS_EXTRAPOLATED;  // a real fix (generatePredictedGPSBytes sets it again)
+
+  // Time of GPS update is bytes 3-6
+  store_int32(3, fix.syncTime);
+
+  // Latitude (in 100,000th of a minute) is bytes 7-10
+  // degrees * 10^-7 --> minutes * 10^-5 is a factor of 60/100
+  store_int32(7, (int32_t)(((int64_t)fix.latitude * 3) / 5));
+
+  // Longitude (in 100,000th of a minute) is bytes 11-14
+  store_int32(11, (int32_t)(((int64_t)fix.longitude * 3) / 5));
+
+  // Altitude (in meters) is bytes 15-16
+  int32_t alt = fix.altitudeMSL / 1000;
+  if (alt < 0) alt = 0;
+  if (alt > 0xFFFF) alt = 0xFFFF;
+  store_uint16(15, (uint16_t)alt);
+
+  // Vertical velocity (in tenths of m/s, positive upward) is bytes 17-18
+  store_int16(17, (int16_t)(-fix.verticalVelocity / 100));
+
+  // Ground speed (in tenths of km/h) is bytes 19-20
+  store_uint16(19, (uint16_t)(((int64_t)fix.groundSpeed * 36) / 1000));
+
+  // Heading relative to true north (0-180 deg, sign in bitByte)
+  sbd[21] = (char)(heading);
+}
+
+// Status: Ready for testing
+void SBDmessage::generatePredictedGPSBytes(const GPSFix &fix) {
+  GPSFix predicted = fix;
+  predicted.positionFix = false;
+  generateGPSBytes(predicted);
+  sbd[36] = sbd[36] | SBD_STATUS_EXTRAPOLATED;
+}
+
+// Status: Ready for testing
+void SBDmessage::generateCommandModuleBytes(float voltage, float intTemp, float extTemp, float capacity) {
+  // Store battery voltage in units of 0.05 V in byte 22
+  sbd[22] = (char)(voltage*20);
+
+  // Store internal temperature in units of 0.01 deg C in bytes 23-24
+  store_int16(23, (int16_t)(intTemp*100));
+
+  // Store external temperature in units of 0.01 deg C in bytes 25-26
+  store_int16(25, (int16_t)(extTemp*100));
+
+  // Store battery capacity in units of 0.5% in byte 27
+  sbd[27] = (char)(capacity*2);
+}
+
+// Status: Ready for testing
+void SBDmessage::generateDynamicsBytes(const DynamicsSummary &summary) {
+  if (summary.samples == 0) return;
+
+  // Peak acceleration (in tenths of m/s^2) is bytes 28-29
+  uint32_t accel = summary.peakAcceleration / 100;
+  if (accel > 0xFFFF) accel = 0xFFFF;
+  store_uint16(28, (uint16_t)accel);
+
+  // Maximum descent rate (in tenths of m/s) is bytes 30-31
+  int32_t descent = summary.maxDescentRate / 100;
+  if (descent < 0) descent = 0;
+  if (descent > 0xFFFF) descent = 0xFFFF;
+  store_uint16(30, (uint16_t)descent);
+}
+
+// Status: Ready for testing
+void SBDmessage::generateHealthBytes(const ReceiverHealthSummary &summary) {
+  if (summary.samples == 0) return;
+
+  // CW jamming indicator is byte 32
+  sbd[32] = (char)summary.jamInd;
+
+  // AGC (in units of 0.5% of full scale) is byte 33
+  sbd[33] = (char)(((uint32_t)summary.agcCnt * 200) / 8191);
+
+  // Noise level is bytes 34-35
+  store_uint16(34, summary.noisePerMS);
+
+  // healthByte: bits 0-2 antenna status, bits 3-4 jamming state, bit 5 output lost
+  // (bit 6 belongs to generatePredictedGPSBytes)
+  char healthByte = sbd[36] & SBD_STATUS_EXTRAPOLATED;
+  healthByte |= summary.antStatus & 0x07;
+  healthByte |= (char)(summary.jammingState & 0x03) << 3;
+  healthByte |= (char)(summary.outputLost) << 5;
+  sbd[36] = healthByte;
+
+  // Peak I2C TX and RX buffer usage (in percent) are bytes 37 and 38
+  sbd[37] = (char)summary.txPeakUsage;
+  sbd[38] = (char)summary.rxPeakUsage;
+}
+
+void SBDmessage::updateMsgLength() {
+  // Same cutoff as generatePodBytes so the length matches what was stored
+  msgLength = SBD_CM_LENGTH;
+  for (int i = 0; i < MAXPODS; i++) {
+    if (podLengths[i] > POD_LENGTH) podLengths[i] = POD_LENGTH;
+    if (podLengths[i]>0) {
+      if (msgLength + podLengths[i] + 1 > SBD_LENGTH) break;
+      msgLength = msgLength + podLengths[i] + 1;
+    }
+  }
+}
+
+// Status: Flight tested (with 9602)
+unsigned short SBDmessage::generateChecksum() {
+  unsigned short cs = 0;
+  for (uint32_t i = 0; i<msgLength; i++) {
+    cs += (unsigned char)sbd[i];
+  }
+  checksum[0] = cs/256;
+  checksum[1] = cs%256;
+  return cs;
+}
+
+// Status: Ready for testing
+int SBDmessage::loadPodBuffer(int podID, const char* data) {
+  if ((podID < 1) || (podID > MAXPODS)) return -1;
+  if (podLengths[podID-1] > POD_LENGTH) podLengths[podID-1] = POD_LENGTH;
+  char numBytes = podLengths[podID-1];
+  for (int i = 0; i<numBytes; i++)
+    podData[podID-1][i] = data[i];
+  return 0;
+}
+
+// Status: Ready for testing
+void SBDmessage::generatePodBytes() {
+  /* Data format:
+   *  First byte = number of bytes of data for pod i
+   *  Data bytes follow
+   */
+  int b = SBD_CM_LENGTH;
+  for (int i = 0; i<MAXPODS; i++) {
+    if (podLengths[i] > POD_LENGTH) podLengths[i] = POD_LENGTH; // only podData[i] is stored
+    if (podLengths[i]>0) {
+      if (b + podLengths[i] + 1 > SBD_LENGTH) break; // no room left in SBD
+      sbd[2] = sbd[2] | (0x01 << (2+i));
+      sbd[b] = podLengths[i];
+      for (int j = 0; j<podLengths[i]; j++) {
+        sbd[b+j+1] = podData[i][j];
+      }
+      b = b + podLengths[i] + 1;
+    }
+  }
+}
+
+char SBDmessage::getPodBytes(char podID, char* data) {
+  char numBytes = podLengths[podID-1];
+  for (int i = 0; i < numBytes; i++) {
+    data[i] = podData[podID-1][i];
+  }
+  return numBytes;
+}
+
+void SBDmessage::testPodBytes() {
+  int b = SBD_CM_LENGTH;
+  char dl;
+  for (int i = 0; i<MAXPODS; i++) {
+    if (sbd[2] & (0x01 << (2+i))) {
+      dl = sbd[b];
+      printf("Pod %d has %d data bytes\r\n\t", i+1, dl);
+      for (int j = 0; j<dl; j++) {
+        printf("%02X ", sbd[b+1+j]);
+      }
+      printf("\r\n");
+      b = b + dl + 1;
+    }
+  }
+}
@@ -0,0 +1,194 @@
+/** Whitworth Near Space SBD Message object
+ *
+ * Update for Mbed OS 6 and the RockBLOCK 9603 (written in 2021)
+ * Based on the SBDmessage class used with the NAL 9602 (see prev_version)
+ *   Note: GPS data now comes from a GPSFix snapshot instead of GPSCoordinates
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 5.0
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef SBDmessage_H
+#define SBDmessage_H
+
+#include <mbed.h>
+
+#define SBD_LENGTH 340
+#define POD_LENGTH 70
+#define MAXPODS 6
+#define SBD_CM_LENGTH 39  // bytes 0-38 are mission ID, GPS, command module, dynamics and receiver health data
+
+#define SBD_STATUS_EXTRAPOLATED 0x40  // byte 36: position was extrapolated, not a GPS fix
+
+#define SBD_FLIGHT_MODE_FLIGHT 2  // matches FLIGHT_MODE_FLIGHT in FlightParameters.h
+
+/** Snapshot of a GPS solution, in the units reported by the Ublox receiver
+ */
+struct GPSFix
+{
+  bool positionFix;         // Is the position valid?
+  uint8_t SIV;              // Number of satellites used in solution
+  time_t syncTime;          // Time of fix (in seconds since 1/1/1970)
+  int32_t latitude;         // Degrees * 10^-7
+  int32_t longitude;        // Degrees * 10^-7
+  int32_t altitudeMSL;      // mm above mean sea level
+  int32_t verticalVelocity; // mm/s (with positive downward)
+  int32_t groundSpeed;      // mm/s
+  int32_t heading;          // Heading of motion in degrees * 10^-5
+};
+
+/** Summary of high rate (HNR) navigation data since the previous frame
+ */
+struct DynamicsSummary
+{
+  uint16_t samples;           // Number of high rate solutions summarized (0 = none)
+  uint32_t peakAcceleration;  // Largest acceleration magnitude in mm/s^2
+  int32_t maxDescentRate;     // Fastest descent in mm/s (positive downward)
+};
+
+/** Worst receiver health readings since the previous frame (MON-HW/MON-RF, MON-TXBUF, MON-RXBUF)
+ */
+struct ReceiverHealthSummary
+{
+  uint16_t samples;           // Number of health polls summarized (0 = none)
+  uint8_t jamInd;             // Highest CW jamming indicator (0-255)
+  uint16_t agcCnt;            // Lowest AGC count (0-8191)
+  uint16_t noisePerMS;        // Highest noise level
+  uint8_t antStatus;          // Antenna status (0 init, 1 unknown, 2 ok, 3 short, 4 open), worst seen
+  uint8_t jammingState;       // 0 unknown, 1 ok, 2 warning, 3 critical, worst seen
+  bool outputLost;            // Receiver dropped output on the I2C port (its TX buffer filled)
+  uint8_t txPeakUsage;        // Peak I2C TX buffer usage (%)
+  uint8_t rxPeakUsage;        // Peak I2C RX buffer usage (%)
+};
+
+class SBDmessage {
+
+public:
+  char podLengths[MAXPODS];
+  uint32_t msgLength;
+  uint32_t missionID;
+
+  /** Create an SBDmessage object
+  */
+  SBDmessage();
+
+  ~SBDmessage();
+
+  /** Sets mission ID portion of mission ID
+  *
+  * Must set missionID member variable before use
+  *
+  * @param flightMode Mission ID number registered with server is
+  *   positive if moving and negative if on the ground (pre or post flight)
+  */
+  void setMissionID(int flightMode);
+
+  /** Populate portion of SBD message devoted to GPS data
+  *
+  * Replaces the fix and heading sign bits of byte 2 and clears
+  * SBD_STATUS_EXTRAPOLATED, so a message written over keeps nothing from
+  * the fix before
+  *
+  * @param fix GPS snapshot to encode
+  */
+  void generateGPSBytes(const GPSFix &fix);
+
+  /** Populate GPS portion of SBD message with an extrapolated position
+  *
+  * The GPS fix bit stays clear and SBD_STATUS_EXTRAPOLATED is set in byte 36
+  *
+  * @param fix Predicted position (see TrackPredictor)
+  */
+  void generatePredictedGPSBytes(const GPSFix &fix);
+
+  /** Populate command module portion of SBD message
+  *
+  * @param voltage Command module battery voltage
+  * @param intTemp Temperature inside command module
+  * @param extTemp External temperature
+  * @param capacity Remaining battery capacity (in percent)
+  */
+  void generateCommandModuleBytes(float voltage, float intTemp, float extTemp, float capacity = 0);
+
+  /** Populate dynamics summary portion of SBD message
+  *
+  * Leave it out (bytes stay 0) when no high rate data was recorded
+  *
+  * @param summary Peak acceleration and descent rate since the last frame
+  */
+  void generateDynamicsBytes(const DynamicsSummary &summary);
+
+  /** Populate receiver health portion of SBD message
+  *
+  * Leave it out (bytes stay 0) when the receiver was not polled
+  *
+  * @param summary Receiver health since the last frame
+  */
+  void generateHealthBytes(const ReceiverHealthSummary &summary);
+
+  /** Loads pod bytes into SBD
+  */
+  void generatePodBytes();
+
+  /** Store pod bytes in buffer
+  *
+  * @param podID Pod number (1 to MAXPODS)
+  * @param data Raw pod bytes (length given by podLengths[podID-1])
+  */
+  int loadPodBuffer(int podID, const char* data);
+
+  /** Clear message
+  */
+  void clearMessage();
+
+  /** Print the pod bytes contained in the SBD
+  */
+  void testPodBytes();
+
+  /** Copy stored pod bytes
+  */
+  char getPodBytes(char podID, char* data);
+
+  /** Calculate the checksum
+  */
+  unsigned short generateChecksum();
+
+  void updateMsgLength();
+
+  /** Get ith byte of SBD Message
+  *
+  * @param i Requested byte (0-339)
+  */
+  char getByte(uint32_t i);
+
+  /** Raw bytes of the SBD message (msgLength bytes are valid)
+  */
+  const char* data() const;
+
+private:
+  char sbd[SBD_LENGTH];
+  char podData[MAXPODS][POD_LENGTH];
+  char checksum[2];
+
+  /** Store a 16-bit signed integer to SBD message
+   * @param startIndex Starting address of byte (0-338)
+   * @param data The 16-bit signed integer to be stored
+   */
+  void store_int16(uint32_t startIndex, int16_t data);
+
+  /** Store a 16-bit unsigned integer to SBD message
+   * @param startIndex Starting address of byte (0-338)
+   * @param data The 16-bit unsigned integer to be stored
+   */
+  void store_uint16(uint32_t startIndex, uint16_t data);
+
+  /** Store a 32-bit signed integer to SBD message
+   * @param startIndex Starting address of byte (0-336)
+   * @param data The 32-bit signed integer to be stored
+   */
+  void store_int32(uint32_t startIndex, int32_t data);
+};
+
+#endif
@@ -0,0 +1,273 @@
+#include "SBDpipeline.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with 9603
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+SBDpipeline::SBDpipeline() {
+  for (int i = 0; i < SBD_PIPELINE_FRAMES; i++) {
+    _state[i] = FRAME_FREE;
+  }
+  _producer = NULL;
+  _flightMode = 0;
+  _missionID = 0;
+  _podTimeout = 5000ms;
+  _maxAge = SBD_PIPELINE_MAX_AGE;
+  _framesBuilt = 0;
+  _framesTaken = 0;
+  _framesRefreshed = 0;
+}
+
+SBDpipeline::~SBDpipeline() {
+  if (_producer) {
+    _producer->terminate();
+    delete _producer;
+  }
+}
+
+void SBDpipeline::attach_pod_request(Callback<void()> func) {
+  _podRequest = func;
+}
+
+void SBDpipeline::attach_pod_ready(Callback<bool()> func) {
+  _podReady = func;
+}
+
+void SBDpipeline::attach_pod_collect(Callback<void(SBDmessage*)> func) {
+  _podCollect = func;
+}
+
+void SBDpipeline::attach_gps(Callback<bool(GPSFix&)> func) {
+  _gps = func;
+}
+
+void SBDpipeline::attach_prediction(Callback<bool(GPSFix&)> func) {
+  _prediction = func;
+}
+
+void SBDpipeline::attach_sensors(Callback<void(SBDmessage*)> func) {
+  _sensors = func;
+}
+
+void SBDpipeline::attach_next_session(Callback<std::chrono::milliseconds()> func) {
+  _mutex.lock();
+  _nextSession = func;
+  _mutex.unlock();
+  _flags.set(SBD_PIPELINE_FLAG_WAKE);
+}
+
+// Status: Ready for testing
+void SBDpipeline::set_flight_mode(int mode) {
+  _mutex.lock();
+  bool changed = (mode != _flightMode);
+  _flightMode = mode;
+  _mutex.unlock();
+  if (changed) invalidate();
+}
+
+void SBDpipeline::set_mission_ID(uint32_t id) {
+  _mutex.lock();
+  _missionID = id;
+  _mutex.unlock();
+}
+
+void SBDpipeline::set_pod_timeout(std::chrono::milliseconds timeout) {
+  _mutex.lock();
+  _podTimeout = timeout;
+  _mutex.unlock();
+}
+
+void SBDpipeline::set_max_frame_age(std::chrono::milliseconds age) {
+  _mutex.lock();
+  _maxAge = age;
+  _mutex.unlock();
+  _flags.set(SBD_PIPELINE_FLAG_WAKE);
+}
+
+// Status: Ready for testing
+void SBDpipeline::start() {
+  if (_producer) return;
+  _producer = new Thread(osPriorityBelowNormal, SBD_PIPELINE_STACK);
+  _producer->start(callback(this, &SBDpipeline::producer_loop));
+}
+
+// Status: Ready for testing
+SBDmessage* SBDpipeline::take_frame() {
+  SBDmessage *frame = NULL;
+  _mutex.lock();
+  int i = find_state(FRAME_READY);
+  if (i >= 0) {
+    _state[i] = FRAME_IN_USE;
+    _framesTaken++;
+    frame = &_frames[i];
+  }
+  _mutex.unlock();
+  // The other buffer can now be refilled while the modem works
+  if (frame) _flags.set(SBD_PIPELINE_FLAG_WAKE);
+  return frame;
+}
+
+// Status: Ready for testing
+SBDmessage* SBDpipeline::wait_for_frame(std::chrono::milliseconds timeout) {
+  Timer t;
+  t.start();
+  SBDmessage *frame = take_frame();
+  while (!frame) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(t.elapsed_time());
+    if (elapsed >= timeout) break;
+    uint32_t flags = _flags.wait_any_for(SBD_PIPELINE_FLAG_READY, timeout - elapsed);
+    if (flags & osFlagsError) break;
+    frame = take_frame();
+  }
+  return frame;
+}
+
+// Status: Ready for testing
+void SBDpipeline::release_frame(SBDmessage *frame) {
+  _mutex.lock();
+  for (int i = 0; i < SBD_PIPELINE_FRAMES; i++) {
+    if ((&_frames[i] == frame) && (_state[i] == FRAME_IN_USE))
+      _state[i] = FRAME_FREE;
+  }
+  _mutex.unlock();
+  _flags.set(SBD_PIPELINE_FLAG_WAKE);
+}
+
+// Status: Ready for testing
+void SBDpipeline::invalidate() {
+  _mutex.lock();
+  for (int i = 0; i < SBD_PIPELINE_FRAMES; i++) {
+    if (_state[i] == FRAME_READY)
+      _builtAt[i] = Kernel::Clock::time_point();  // treat as infinitely old
+  }
+  _mutex.unlock();
+  _flags.set(SBD_PIPELINE_FLAG_WAKE);
+}
+
+uint32_t SBDpipeline::frames_built() {
+  return _framesBuilt;
+}
+
+uint32_t SBDpipeline::frames_taken() {
+  return _framesTaken;
+}
+
+uint32_t SBDpipeline::frames_refreshed() {
+  return _framesRefreshed;
+}
+
+int SBDpipeline::find_state(FrameState state) {
+  for (int i = 0; i < SBD_PIPELINE_FRAMES; i++) {
+    if (_state[i] == state) return i;
+  }
+  return -1;
+}
+
+/* A ready frame is rebuilt when it is older than _maxAge, except that
+ * while no session can start yet there is no point: it is rebuilt once,
+ * _maxAge/2 before the session window opens, and kept until then. The
+ * next-session function is called without the mutex held.
+ */
+// Status: Ready for testing
+void SBDpipeline::producer_loop() {
+  while (true) {
+    int slot = -1;
+    std::chrono::milliseconds sleepTime = 0ms;
+    bool forever = true;
+
+    _mutex.lock();
+    Callback<std::chrono::milliseconds()> nextSession = _nextSession;
+    _mutex.unlock();
+    std::chrono::milliseconds untilSession = nextSession ? nextSession() : 0ms;
+
+    _mutex.lock();
+    int ready = find_state(FRAME_READY);
+    if (ready >= 0) {
+      bool invalid = (_builtAt[ready] == Kernel::Clock::time_point());
+      auto age = std::chrono::duration_cast<std::chrono::milliseconds>(Kernel::Clock::now() - _builtAt[ready]);
+      std::chrono::milliseconds stale = _maxAge - age;    // time left before the frame is too old
+      if (!invalid && (untilSession > stale) && (untilSession > _maxAge / 2)) {
+        // Too old by the time a session can start, so rebuild just before then
+        sleepTime = untilSession - _maxAge / 2;
+        forever = false;
+      } else if (!invalid && (stale > 0ms)) {
+        // Current frame is fresh, so sleep until it goes stale or is taken
+        sleepTime = stale;
+        forever = false;
+      } else {
+        slot = find_state(FRAME_FREE);
+      }
+    } else {
+      slot = find_state(FRAME_FREE);
+    }
+    if (slot >= 0) _state[slot] = FRAME_BUILDING;
+    _mutex.unlock();
+
+    if (slot < 0) {
+      // Nothing to do until a frame is taken/released or the ready one ages out
+      if (forever)
+        _flags.wait_any(SBD_PIPELINE_FLAG_WAKE);
+      else
+        _flags.wait_any_for(SBD_PIPELINE_FLAG_WAKE, sleepTime);
+      continue;
+    }
+
+    build_frame(&_frames[slot]);
+
+    _mutex.lock();
+    _state[slot] = FRAME_READY;
+    _builtAt[slot] = Kernel::Clock::now();
+    _framesBuilt++;
+    // Only the newest frame is kept; a stale one still waiting is discarded
+    for (int i = 0; i < SBD_PIPELINE_FRAMES; i++) {
+      if ((i != slot) && (_state[i] == FRAME_READY)) {
+        _state[i] = FRAME_FREE;
+        _framesRefreshed++;
+      }
+    }
+    _mutex.unlock();
+    _flags.set(SBD_PIPELINE_FLAG_READY);
+  }
+}
+
+// Status: Ready for testing
+void SBDpipeline::build_frame(SBDmessage *msg) {
+  _mutex.lock();
+  int mode = _flightMode;
+  uint32_t id = _missionID;
+  std::chrono::milliseconds podTimeout = _podTimeout;
+  _mutex.unlock();
+
+  msg->clearMessage();
+  for (int i = 0; i < MAXPODS; i++)
+    msg->podLengths[i] = 0;
+  msg->missionID = id;
+  msg->setMissionID(mode);
+
+  // Ask pods first so they can respond while GPS and sensors are read
+  Timer podTimer;
+  podTimer.start();
+  if (_podRequest) _podRequest();
+
+  GPSFix fix;
+  if (_gps && _gps(fix)) msg->generateGPSBytes(fix);
+  else if (_prediction && _prediction(fix)) msg->generatePredictedGPSBytes(fix);
+
+  if (_sensors) _sensors(msg);
+
+  if (_podReady) {
+    while (!_podReady() && (podTimer.elapsed_time() < podTimeout)) {
+      ThisThread::sleep_for(10ms);
+    }
+  }
+  if (_podCollect) _podCollect(msg);
+
+  msg->generatePodBytes();
+  msg->updateMsgLength();
+}
@@ -0,0 +1,199 @@
+/** Whitworth Near Space SBD frame pipeline
+ *
+ * Double-buffered preparation of SBD messages. A producer thread builds the
+ * next frame (pod request, GPS snapshot, sensor reads, pod collection) while
+ * the previous frame is still being sent through the modem, so a ready frame
+ * is waiting as soon as the Iridium session ends.
+ *
+ * A ready frame is kept until shortly before the next session can start and
+ * is then rebuilt, so it carries fresh data without being rebuilt over and
+ * over while it waits (see attach_next_session).
+ *
+ * Typical use:
+ *    pipeline.attach_gps(get_gps_snapshot);  // bool get_gps_snapshot(GPSFix &fix)
+ *    pipeline.attach_next_session(callback(&scheduler, &IridiumScheduler::time_to_window));
+ *    pipeline.start();
+ *    ...
+ *    SBDmessage *frame = pipeline.wait_for_frame(10s);
+ *    if (frame) {
+ *      // hand frame->data() (frame->msgLength bytes) to the modem
+ *      pipeline.release_frame(frame);
+ *    }
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef SBDpipeline_H
+#define SBDpipeline_H
+
+#include <mbed.h>
+#include "SBDmessage.h"
+
+#define SBD_PIPELINE_FRAMES 2
+#define SBD_PIPELINE_STACK 4096
+#define SBD_PIPELINE_MAX_AGE 10000ms  // default oldest frame sent (a build takes up to the pod timeout)
+
+#define SBD_PIPELINE_FLAG_WAKE 0x01   // producer should re-check the frames
+#define SBD_PIPELINE_FLAG_READY 0x02  // a frame has become ready
+
+class SBDpipeline {
+
+public:
+  enum FrameState {
+    FRAME_FREE,       // available for the producer
+    FRAME_BUILDING,   // producer is filling it in
+    FRAME_READY,      // complete and waiting for the modem
+    FRAME_IN_USE      // taken by the modem session
+  };
+
+  /** Create an SBD pipeline (producer is not started until start() is called)
+   */
+  SBDpipeline();
+
+  ~SBDpipeline();
+
+  /** Function called at the start of a build to ask the pods for data
+   */
+  void attach_pod_request(Callback<void()> func);
+
+  /** Function polled while waiting for pod data
+   *
+   * Should return true once every pod has answered (or there are no pods)
+   */
+  void attach_pod_ready(Callback<bool()> func);
+
+  /** Function called to copy pod data into the frame
+   *
+   * Should set podLengths and call loadPodBuffer for each pod that answered
+   */
+  void attach_pod_collect(Callback<void(SBDmessage*)> func);
+
+  /** Function used to take a GPS snapshot
+   *
+   * Should fill in the GPSFix and return true if the snapshot is valid
+   */
+  void attach_gps(Callback<bool(GPSFix&)> func);
+
+  /** Function used when the GPS snapshot fails
+   *
+   * Should fill in an extrapolated fix (e.g. from TrackPredictor) and return
+   * true if it could; the frame then carries it marked as extrapolated
+   */
+  void attach_prediction(Callback<bool(GPSFix&)> func);
+
+  /** Function called to store command module data (voltage, temperatures)
+   *
+   * Normally calls generateCommandModuleBytes on the frame
+   */
+  void attach_sensors(Callback<void(SBDmessage*)> func);
+
+  /** Function giving the time until the next session can start
+   *
+   * Normally IridiumScheduler::time_to_window. A ready frame that would be
+   * older than the maximum age by then is rebuilt half the maximum age
+   * before it; until then the producer sleeps. Without this function a
+   * ready frame is rebuilt every maximum age.
+   */
+  void attach_next_session(Callback<std::chrono::milliseconds()> func);
+
+  /** Set the flight mode used for the mission ID sign of new frames
+   *
+   * @param mode Flight mode (see FlightParameters.h)
+   */
+  void set_flight_mode(int mode);
+
+  /** Set the mission ID stored in new frames
+   *
+   * @param id Mission ID registered with the server
+   */
+  void set_mission_ID(uint32_t id);
+
+  /** Maximum time to wait for the pods to answer during a build
+   */
+  void set_pod_timeout(std::chrono::milliseconds timeout);
+
+  /** A ready frame older than this is rebuilt so the modem never sends stale data
+   *
+   * This bounds how old the data in a transmitted frame can be. With
+   * attach_next_session it only applies from the time a session can start.
+   */
+  void set_max_frame_age(std::chrono::milliseconds age);
+
+  /** Start the producer thread
+   */
+  void start();
+
+  /** Take the newest ready frame without blocking
+   *
+   * The frame belongs to the caller until release_frame is called.
+   *
+   * @returns pointer to the frame or NULL if no frame is ready
+   */
+  SBDmessage* take_frame();
+
+  /** Take the newest ready frame, waiting up to timeout for one to be built
+   *
+   * @param timeout Maximum time to wait
+   * @returns pointer to the frame or NULL on timeout
+   */
+  SBDmessage* wait_for_frame(std::chrono::milliseconds timeout);
+
+  /** Return a frame to the pipeline after the modem is done with it
+   *
+   * @param frame Pointer returned by take_frame or wait_for_frame
+   */
+  void release_frame(SBDmessage *frame);
+
+  /** Force the producer to rebuild the ready frame (e.g. after a mode change)
+   */
+  void invalidate();
+
+  /** Number of frames built since start */
+  uint32_t frames_built();
+
+  /** Number of frames handed to the modem */
+  uint32_t frames_taken();
+
+  /** Number of ready frames discarded because a newer one was built */
+  uint32_t frames_refreshed();
+
+private:
+  SBDmessage _frames[SBD_PIPELINE_FRAMES];
+  FrameState _state[SBD_PIPELINE_FRAMES];
+  Kernel::Clock::time_point _builtAt[SBD_PIPELINE_FRAMES];
+
+  Thread *_producer;
+  Mutex _mutex;
+  EventFlags _flags;
+
+  Callback<void()> _podRequest;
+  Callback<bool()> _podReady;
+  Callback<void(SBDmessage*)> _podCollect;
+  Callback<bool(GPSFix&)> _gps;
+  Callback<bool(GPSFix&)> _prediction;
+  Callback<void(SBDmessage*)> _sensors;
+  Callback<std::chrono::milliseconds()> _nextSession;
+
+  int _flightMode;
+  uint32_t _missionID;
+  std::chrono::milliseconds _podTimeout;
+  std::chrono::milliseconds _maxAge;
+
+  uint32_t _framesBuilt;
+  uint32_t _framesTaken;
+  uint32_t _framesRefreshed;
+
+  /** Producer thread loop */
+  void producer_loop();
+
+  /** Fill in one frame (called without holding the mutex) */
+  void build_frame(SBDmessage *msg);
+
+  /** Index of first frame in the given state or -1 (call with mutex held) */
+  int find_state(FrameState state);
+};
+
+#endif
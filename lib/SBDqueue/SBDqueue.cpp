@@ -0,0 +1,358 @@
+#include "SBDqueue.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with 9603
+ *  - Flight tested
+ */
+
+/* Slot layout in FRAM (see docs/FRAM.adoc)
+ *   0     state (SBDQ_SLOT_VALID if in use)
+ *   1     priority class
+ *   2     attempts
+ *   3     coalesce level
+ *   4-7   sequence number
+ *   8-9   message length
+ *   10-11 checksum (16-bit sum of message bytes)
+ *   12-   message bytes
+ */
+
+// Status: Ready for testing
+SBDqueue::SBDqueue(Cypress_FRAM *fram) {
+  _fram = fram;
+  _nextSequence = 0;
+  _dropped = 0;
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++)
+    _entries[i].valid = false;
+}
+
+SBDqueue::~SBDqueue() {
+
+}
+
+uint16_t SBDqueue::slot_address(int slot) {
+  return SBDQ_SLOT_ADDRESS + slot * SBDQ_SLOT_SIZE;
+}
+
+// Status: Ready for testing
+int SBDqueue::begin() {
+  FRAM_Response_Read_Uint16 magic = _fram->read_uint16(SBDQ_BASE_ADDRESS);
+  if (magic.status != FRAM_SUCCESS) return magic.status;
+  char info[2];
+  int status = _fram->read(SBDQ_BASE_ADDRESS + 2, info, 2);
+  if (status != FRAM_SUCCESS) return status;
+  if ((magic.data != SBDQ_MAGIC) || (info[0] != SBDQ_VERSION) || (info[1] != SBDQ_MAX_SLOTS))
+    return format();
+
+  // Rebuild the index from the slot headers
+  char header[SBDQ_SLOT_HEADER_SIZE];
+  Kernel::Clock::time_point now = Kernel::Clock::now();
+  _nextSequence = 0;
+  _dropped = 0;
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++) {
+    _entries[i].valid = false;
+    status = _fram->read(slot_address(i), header, SBDQ_SLOT_HEADER_SIZE);
+    if (status != FRAM_SUCCESS) return status;
+    if ((uint8_t)header[0] != SBDQ_SLOT_VALID) continue;
+    uint16_t length = ((uint8_t)header[8] << 8) | (uint8_t)header[9];
+    uint16_t stored = ((uint8_t)header[10] << 8) | (uint8_t)header[11];
+    uint8_t priority = header[1];
+    // A slot torn by a reset mid-write (or corrupted) is freed rather than sent
+    bool good = (length >= 1) && (length <= SBDQ_DATA_SIZE) && (priority <= SBD_PRIORITY_BULK);
+    if (good) {
+      uint16_t cs;
+      status = slot_checksum(i, length, cs);
+      if (status != FRAM_SUCCESS) return status;
+      good = (cs == stored);
+    }
+    if (!good) {
+      status = free_slot(i);
+      if (status != FRAM_SUCCESS) return status;
+      _dropped++;
+      continue;
+    }
+    _entries[i].valid = true;
+    _entries[i].priority = priority;
+    _entries[i].attempts = header[2];
+    _entries[i].level = header[3];
+    _entries[i].sequence = ((uint32_t)(uint8_t)header[4] << 24) | ((uint32_t)(uint8_t)header[5] << 16) |
+                           ((uint32_t)(uint8_t)header[6] << 8) | (uint8_t)header[7];
+    _entries[i].length = length;
+    _entries[i].nextAttempt = now;  // backoff timers do not survive a reset
+    if (_entries[i].sequence >= _nextSequence)
+      _nextSequence = _entries[i].sequence + 1;
+  }
+  seed();
+  return SBDQ_SUCCESS;
+}
+
+/* Without a seed every boot would draw the same backoff jitter. The RTC keeps
+ * running through a reset, so it differs from boot to boot.
+ */
+void SBDqueue::seed() {
+  srand((unsigned int)time(NULL) ^ (unsigned int)Kernel::Clock::now().time_since_epoch().count() ^ _nextSequence);
+}
+
+int SBDqueue::slot_checksum(int slot, uint16_t length, uint16_t &cs) {
+  char chunk[SBDQ_CHECK_CHUNK];
+  cs = 0;
+  for (uint16_t done = 0; done < length; done += SBDQ_CHECK_CHUNK) {
+    int n = length - done;
+    if (n > SBDQ_CHECK_CHUNK) n = SBDQ_CHECK_CHUNK;
+    int status = _fram->read(slot_address(slot) + SBDQ_SLOT_HEADER_SIZE + done, chunk, n);
+    if (status != FRAM_SUCCESS) return status;
+    for (int i = 0; i < n; i++)
+      cs += (uint8_t)chunk[i];
+  }
+  return FRAM_SUCCESS;
+}
+
+// Status: Ready for testing
+int SBDqueue::format() {
+  int status;
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++) {
+    status = _fram->write(slot_address(i), (char)0);
+    if (status != FRAM_SUCCESS) return status;
+    _entries[i].valid = false;
+  }
+  char header[4];
+  header[0] = SBDQ_MAGIC >> 8;
+  header[1] = SBDQ_MAGIC & 0xFF;
+  header[2] = SBDQ_VERSION;
+  header[3] = SBDQ_MAX_SLOTS;
+  status = _fram->write(SBDQ_BASE_ADDRESS, header, 4);
+  _nextSequence = 0;
+  _dropped = 0;
+  seed();
+  return status;
+}
+
+// Status: Ready for testing
+int SBDqueue::write_slot_header(int slot, uint16_t checksum) {
+  SBDQueueEntry *e = &_entries[slot];
+  char header[SBDQ_SLOT_HEADER_SIZE];
+  header[0] = SBDQ_SLOT_VALID;
+  header[1] = e->priority;
+  header[2] = e->attempts;
+  header[3] = e->level;
+  header[4] = e->sequence >> 24;
+  header[5] = e->sequence >> 16;
+  header[6] = e->sequence >> 8;
+  header[7] = e->sequence;
+  header[8] = e->length >> 8;
+  header[9] = e->length;
+  header[10] = checksum >> 8;
+  header[11] = checksum;
+  // Write everything except the state byte, then mark the slot valid
+  int status = _fram->write(slot_address(slot) + 1, header + 1, SBDQ_SLOT_HEADER_SIZE - 1);
+  if (status != FRAM_SUCCESS) return status;
+  return _fram->write(slot_address(slot), header[0]);
+}
+
+int SBDqueue::free_slot(int slot) {
+  _entries[slot].valid = false;
+  return _fram->write(slot_address(slot), (char)0);
+}
+
+int SBDqueue::find_free() {
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++) {
+    if (!_entries[i].valid) return i;
+  }
+  return -1;
+}
+
+int SBDqueue::oldest(SBDPriority priority) {
+  int slot = -1;
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++) {
+    if (_entries[i].valid && (_entries[i].priority == priority)) {
+      if ((slot < 0) || (_entries[i].sequence < _entries[slot].sequence))
+        slot = i;
+    }
+  }
+  return slot;
+}
+
+// Status: Ready for testing
+int SBDqueue::coalesce_routine() {
+  /* Thin the track by merging a pair of neighboring routine entries. The pair
+   * with the lowest coalesce level (oldest on a tie) loses its newer member
+   * and the survivor's level goes up, so repeated calls thin the oldest part
+   * of the track by factors of two. The newest track point is never dropped.
+   */
+  int order[SBDQ_MAX_SLOTS];
+  int n = 0;
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++) {
+    if (_entries[i].valid && (_entries[i].priority == SBD_PRIORITY_ROUTINE)) {
+      // insertion sort by sequence
+      int j = n;
+      while ((j > 0) && (_entries[order[j-1]].sequence > _entries[i].sequence)) {
+        order[j] = order[j-1];
+        j--;
+      }
+      order[j] = i;
+      n++;
+    }
+  }
+  if (n < 3) return -1;
+
+  int best = -1;
+  uint8_t bestLevel = 0xFF;
+  for (int i = 0; i < n - 2; i++) {
+    uint8_t level = _entries[order[i]].level;
+    if (_entries[order[i+1]].level > level) level = _entries[order[i+1]].level;
+    if ((best < 0) || (level < bestLevel)) {
+      best = i;
+      bestLevel = level;
+    }
+  }
+
+  int keep = order[best];
+  int drop = order[best+1];
+  int status = free_slot(drop);
+  if (status != FRAM_SUCCESS) return status;
+  if (_entries[keep].level < 0xFF) _entries[keep].level++;
+  status = _fram->write(slot_address(keep) + 3, (char)_entries[keep].level);
+  if (status != FRAM_SUCCESS) return status;
+  _dropped++;
+  return drop;
+}
+
+// Status: Ready for testing
+int SBDqueue::push(const char *data, uint16_t length, SBDPriority priority) {
+  if ((length == 0) || (length > SBDQ_DATA_SIZE)) return SBDQ_ERROR_TOO_LONG;
+
+  int slot = find_free();
+  if (slot < 0) {
+    // Queue is full, so make room (bulk goes first, urgent is never dropped)
+    int victim = oldest(SBD_PRIORITY_BULK);
+    if (victim >= 0) {
+      int status = free_slot(victim);
+      if (status != FRAM_SUCCESS) return status;
+      _dropped++;
+      slot = victim;
+    } else if (priority != SBD_PRIORITY_BULK) {
+      slot = coalesce_routine();
+      if ((slot < 0) && (priority == SBD_PRIORITY_URGENT)) {
+        victim = oldest(SBD_PRIORITY_ROUTINE);
+        if (victim >= 0) {
+          int status = free_slot(victim);
+          if (status != FRAM_SUCCESS) return status;
+          _dropped++;
+          slot = victim;
+        }
+      }
+    }
+    if (slot < 0) return SBDQ_ERROR_FULL;
+  }
+
+  uint16_t cs = 0;
+  for (int i = 0; i < length; i++)
+    cs += (uint8_t)data[i];
+
+  int status = _fram->write(slot_address(slot) + SBDQ_SLOT_HEADER_SIZE, data, length);
+  if (status != FRAM_SUCCESS) return status;
+
+  SBDQueueEntry *e = &_entries[slot];
+  e->priority = priority;
+  e->attempts = 0;
+  e->level = 0;
+  e->sequence = _nextSequence++;
+  e->length = length;
+  e->nextAttempt = Kernel::Clock::now();
+  status = write_slot_header(slot, cs);
+  if (status != FRAM_SUCCESS) return status;
+  e->valid = true;
+  return SBDQ_SUCCESS;
+}
+
+// Status: Ready for testing
+int SBDqueue::next() {
+  int slot = -1;
+  Kernel::Clock::time_point now = Kernel::Clock::now();
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++) {
+    SBDQueueEntry *e = &_entries[i];
+    if (!e->valid || (e->nextAttempt > now)) continue;
+    if ((slot < 0) || (e->priority < _entries[slot].priority) ||
+        ((e->priority == _entries[slot].priority) && (e->sequence < _entries[slot].sequence)))
+      slot = i;
+  }
+  return slot;
+}
+
+// Status: Ready for testing
+int SBDqueue::read(int slot, char *data, int size) {
+  if ((slot < 0) || (slot >= SBDQ_MAX_SLOTS) || !_entries[slot].valid) return SBDQ_ERROR_INVALID_SLOT;
+  uint16_t length = _entries[slot].length;
+  if (length > size) return SBDQ_ERROR_TOO_LONG;
+  FRAM_Response_Read_Uint16 stored = _fram->read_uint16(slot_address(slot) + 10);
+  if (stored.status != FRAM_SUCCESS) return stored.status;
+  int status = _fram->read(slot_address(slot) + SBDQ_SLOT_HEADER_SIZE, data, length);
+  if (status != FRAM_SUCCESS) return status;
+  uint16_t cs = 0;
+  for (int i = 0; i < length; i++)
+    cs += (uint8_t)data[i];
+  if (cs != stored.data) return SBDQ_ERROR_CHECKSUM;
+  return length;
+}
+
+// Status: Ready for testing
+int SBDqueue::mark_sent(int slot) {
+  if ((slot < 0) || (slot >= SBDQ_MAX_SLOTS) || !_entries[slot].valid) return SBDQ_ERROR_INVALID_SLOT;
+  return free_slot(slot);
+}
+
+// Status: Ready for testing
+int SBDqueue::mark_failed(int slot) {
+  if ((slot < 0) || (slot >= SBDQ_MAX_SLOTS) || !_entries[slot].valid) return SBDQ_ERROR_INVALID_SLOT;
+  SBDQueueEntry *e = &_entries[slot];
+  if (e->attempts < 0xFF) e->attempts++;
+  e->nextAttempt = Kernel::Clock::now() + backoff(e->attempts);
+  return _fram->write(slot_address(slot) + 2, (char)e->attempts);
+}
+
+// Status: Ready for testing
+std::chrono::milliseconds SBDqueue::backoff(uint8_t attempts) {
+  std::chrono::milliseconds delay = SBDQ_BACKOFF_BASE;
+  for (int i = 1; (i < attempts) && (delay < SBDQ_BACKOFF_MAX); i++)
+    delay *= 2;
+  if (delay > SBDQ_BACKOFF_MAX) delay = SBDQ_BACKOFF_MAX;
+  // Jitter of +/- 25% keeps retries from lining up with the same bad sky view
+  return delay * (75 + rand() % 51) / 100;
+}
+
+std::chrono::milliseconds SBDqueue::time_to_next() {
+  Kernel::Clock::time_point now = Kernel::Clock::now();
+  bool found = false;
+  Kernel::Clock::time_point soonest = now;
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++) {
+    if (!_entries[i].valid) continue;
+    if (_entries[i].nextAttempt <= now) return 0ms;
+    if (!found || (_entries[i].nextAttempt < soonest)) soonest = _entries[i].nextAttempt;
+    found = true;
+  }
+  if (!found) return -1ms;
+  return std::chrono::duration_cast<std::chrono::milliseconds>(soonest - now);
+}
+
+int SBDqueue::count() {
+  int n = 0;
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++) {
+    if (_entries[i].valid) n++;
+  }
+  return n;
+}
+
+int SBDqueue::count(SBDPriority priority) {
+  int n = 0;
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++) {
+    if (_entries[i].valid && (_entries[i].priority == priority)) n++;
+  }
+  return n;
+}
+
+uint32_t SBDqueue::dropped() {
+  return _dropped;
+}
@@ -0,0 +1,166 @@
+/** Persistent outbound SBD queue stored in the command module FRAM
+ *
+ * Messages that could not be sent are kept in FRAM (see docs/FRAM.adoc for
+ * the layout) so they survive a reset. Each entry has a priority class:
+ *   - urgent: events such as launch, burst and landing (never evicted)
+ *   - routine: track points (thinned out when the queue is full)
+ *   - bulk: pod data (evicted first when the queue is full)
+ *
+ * Failed entries are retried with exponential backoff plus random jitter.
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef SBDqueue_H
+#define SBDqueue_H
+
+#include <mbed.h>
+#include "cypress_fm24w256.h"
+
+#define SBDQ_BASE_ADDRESS 0x0400    // queue header (see docs/FRAM.adoc)
+#define SBDQ_HEADER_SIZE 32
+#define SBDQ_SLOT_ADDRESS (SBDQ_BASE_ADDRESS + SBDQ_HEADER_SIZE)
+#define SBDQ_SLOT_HEADER_SIZE 12
+#define SBDQ_DATA_SIZE 340          // maximum MO SBD length
+#define SBDQ_SLOT_SIZE (SBDQ_SLOT_HEADER_SIZE + SBDQ_DATA_SIZE)
+#define SBDQ_MAX_SLOTS 64
+
+#define SBDQ_MAGIC 0x5351           // "SQ"
+#define SBDQ_VERSION 1
+#define SBDQ_SLOT_VALID 0xA5
+#define SBDQ_CHECK_CHUNK 34         // bytes read at a time when begin() checks a slot
+
+#define SBDQ_SUCCESS 0
+#define SBDQ_ERROR_FULL -10
+#define SBDQ_ERROR_TOO_LONG -11
+#define SBDQ_ERROR_INVALID_SLOT -12
+#define SBDQ_ERROR_CHECKSUM -13
+
+#define SBDQ_BACKOFF_BASE 30s       // first retry delay
+#define SBDQ_BACKOFF_MAX 1800s      // retry delay never grows beyond this
+
+enum SBDPriority {
+  SBD_PRIORITY_URGENT = 0,
+  SBD_PRIORITY_ROUTINE = 1,
+  SBD_PRIORITY_BULK = 2
+};
+
+/** In-memory index entry for one FRAM slot
+ */
+struct SBDQueueEntry {
+  bool valid;
+  uint8_t priority;
+  uint8_t attempts;
+  uint8_t level;        // number of times neighbors were coalesced into this entry
+  uint32_t sequence;    // order of arrival (persists across resets)
+  uint16_t length;
+  Kernel::Clock::time_point nextAttempt;
+};
+
+class SBDqueue {
+
+public:
+  /** Create a queue on the given FRAM
+   *
+   * @param fram Pointer to the shared FRAM object
+   */
+  SBDqueue(Cypress_FRAM *fram);
+
+  ~SBDqueue();
+
+  /** Load the queue index from FRAM, formatting the region if it is blank
+   *
+   * Slots with a bad length, priority or checksum are freed (and counted in
+   * dropped()).
+   *
+   * @returns SBDQ_SUCCESS or FRAM error code
+   */
+  int begin();
+
+  /** Erase every entry in the queue
+   *
+   * @returns SBDQ_SUCCESS or FRAM error code
+   */
+  int format();
+
+  /** Add a message to the queue
+   *
+   * When the queue is full room is made by evicting bulk entries, then by
+   * coalescing old routine entries (urgent entries are never dropped).
+   *
+   * @param data Message bytes
+   * @param length Number of bytes (1 to 340)
+   * @param priority Priority class
+   * @returns SBDQ_SUCCESS, SBDQ_ERROR_FULL, SBDQ_ERROR_TOO_LONG or FRAM error code
+   */
+  int push(const char *data, uint16_t length, SBDPriority priority);
+
+  /** Find the entry that should be sent next
+   *
+   * Highest priority class first, then oldest. Entries still waiting out
+   * their backoff are skipped.
+   *
+   * @returns slot number or -1 if nothing is due
+   */
+  int next();
+
+  /** Read the message stored in a slot
+   *
+   * @param slot Slot number from next()
+   * @param data Buffer for the message
+   * @param size Size of the buffer (SBDQ_DATA_SIZE always fits)
+   * @returns message length, SBDQ_ERROR_TOO_LONG if it does not fit, or other
+   *    negative error code
+   */
+  int read(int slot, char *data, int size);
+
+  /** Remove an entry after it was delivered
+   *
+   * @param slot Slot number from next()
+   * @returns SBDQ_SUCCESS or error code
+   */
+  int mark_sent(int slot);
+
+  /** Schedule a retry after a failed session
+   *
+   * @param slot Slot number from next()
+   * @returns SBDQ_SUCCESS or error code
+   */
+  int mark_failed(int slot);
+
+  /** Time until the next entry becomes due (0 if one is due now)
+   *
+   * @returns time or -1ms if the queue is empty
+   */
+  std::chrono::milliseconds time_to_next();
+
+  /** Number of entries in the queue */
+  int count();
+
+  /** Number of entries in a priority class */
+  int count(SBDPriority priority);
+
+  /** Number of entries dropped to make room since begin() */
+  uint32_t dropped();
+
+private:
+  Cypress_FRAM *_fram;
+  SBDQueueEntry _entries[SBDQ_MAX_SLOTS];
+  uint32_t _nextSequence;
+  uint32_t _dropped;
+
+  uint16_t slot_address(int slot);
+  int write_slot_header(int slot, uint16_t checksum);
+  int free_slot(int slot);
+  int slot_checksum(int slot, uint16_t length, uint16_t &cs);
+  void seed();
+  int find_free();
+  int oldest(SBDPriority priority);
+  int coalesce_routine();
+  std::chrono::milliseconds backoff(uint8_t attempts);
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "TrackPredictor.h"
+#include <math.h>
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+TrackPredictor::TrackPredictor() {
+  reset();
+}
+
+TrackPredictor::~TrackPredictor() {
+
+}
+
+void TrackPredictor::reset() {
+  memset(&_last, 0, sizeof(_last));
+  _haveFix = false;
+  _rate = 0;
+  _ground = 0;
+  for (int i = 0; i < TP_BINS; i++) {
+    _windN[i] = 0;
+    _windE[i] = 0;
+    _windKnown[i] = false;
+  }
+}
+
+// Status: Ready for testing
+void TrackPredictor::add(const GPSFix &fix) {
+  if (!fix.positionFix) return;
+
+  float rate = (float)(-fix.verticalVelocity);
+  if (!_haveFix || ((rate < 0) != (_rate < 0)))
+    _rate = rate;           // first fix or burst: start over
+  else
+    _rate += (rate - _rate) / TP_RATE_SMOOTHING;
+
+  if (!_haveFix || (fix.altitudeMSL < _ground)) _ground = fix.altitudeMSL;
+
+  float heading = fix.heading * 1.0e-5f * 0.017453293f;
+  float north = fix.groundSpeed * cosf(heading) / 10.0f;    // cm/s
+  float east = fix.groundSpeed * sinf(heading) / 10.0f;
+  int b = bin(fix.altitudeMSL);
+  if (b >= 0) {
+    if (_windKnown[b]) {
+      north = _windN[b] + (north - _windN[b]) / TP_WIND_SMOOTHING;
+      east = _windE[b] + (east - _windE[b]) / TP_WIND_SMOOTHING;
+    }
+    _windN[b] = (int16_t)lroundf(fmaxf(-32767.0f, fminf(32767.0f, north)));
+    _windE[b] = (int16_t)lroundf(fmaxf(-32767.0f, fminf(32767.0f, east)));
+    _windKnown[b] = true;
+  }
+
+  _last = fix;
+  _haveFix = true;
+}
+
+/* Positions are integrated in metres north and east of the last fix and
+ * converted to degrees at the end, which is accurate enough for the few
+ * kilometres covered in TP_MAX_OUTAGE_S.
+ */
+// Status: Ready for testing
+bool TrackPredictor::predict(time_t t, GPSFix &fix) {
+  if (!_haveFix) return false;
+  if ((t < _last.syncTime) || (t - _last.syncTime > TP_MAX_OUTAGE_S)) return false;
+
+  float lastHeading = _last.heading * 1.0e-5f * 0.017453293f;
+  float lastN = _last.groundSpeed * cosf(lastHeading);        // mm/s
+  float lastE = _last.groundSpeed * sinf(lastHeading);
+
+  float h = (float)_last.altitudeMSL;                          // mm
+  float north = 0;                                             // mm
+  float east = 0;
+  float vz = _rate;
+  float vN = lastN;
+  float vE = lastE;
+  bool landed = false;
+  int32_t remaining = (int32_t)(t - _last.syncTime);
+  while ((remaining > 0) && !landed) {
+    float dt = (remaining < TP_STEP_S) ? remaining : TP_STEP_S;
+    remaining -= (int32_t)dt;
+
+    vz = _rate;
+    if (_rate < 0)
+      vz = _rate * expf((h - _last.altitudeMSL) / (2000.0f * TP_SCALE_HEIGHT_M));
+    int32_t windN, windE;
+    if (wind((int32_t)h, windN, windE)) {
+      vN = windN;
+      vE = windE;
+    } else {
+      vN = lastN;
+      vE = lastE;
+    }
+    h += vz * dt;
+    north += vN * dt;
+    east += vE * dt;
+    if ((_rate < 0) && (h <= _ground)) {
+      h = _ground;
+      landed = true;
+    }
+  }
+  if (landed) vz = vN = vE = 0;
+
+  fix = _last;
+  fix.positionFix = false;
+  fix.SIV = 0;
+  fix.syncTime = t;
+  // 1e-7 degree of latitude is 11.132 mm
+  fix.latitude = _last.latitude + (int32_t)lroundf(north / 11.132f);
+  fix.longitude = _last.longitude +
+    (int32_t)lroundf(east / (11.132f * cosf(_last.latitude * 1.0e-7f * 0.017453293f)));
+  fix.altitudeMSL = (int32_t)lroundf(h);
+  fix.verticalVelocity = (int32_t)lroundf(-vz);
+  fix.groundSpeed = (int32_t)lroundf(sqrtf(vN * vN + vE * vE));
+  float heading = atan2f(vE, vN) * 57.29578f;
+  if (heading < 0) heading += 360;
+  fix.heading = (int32_t)lroundf(heading * 100000);
+  return true;
+}
+
+bool TrackPredictor::wind(int32_t altitude, int32_t &north, int32_t &east) {
+  int b = bin(altitude);
+  if ((b < 0) || !_windKnown[b]) return false;
+  north = _windN[b] * 10;
+  east = _windE[b] * 10;
+  return true;
+}
+
+int32_t TrackPredictor::vertical_rate() {
+  return (int32_t)lroundf(_rate);
+}
+
+int TrackPredictor::bin(int32_t altitude) {
+  if (altitude < 0) return -1;
+  int b = altitude / (TP_BIN_M * 1000);
+  return (b < TP_BINS) ? b : -1;
+}
@@ -0,0 +1,95 @@
+/** Dead reckoning of the balloon track through short GPS outages
+ *
+ * When no GPS snapshot is available the frame used to go out without a
+ * position, so the ground track stopped until the receiver came back.
+ * TrackPredictor learns from every good fix and extrapolates from the last
+ * one instead, without powering or polling the receiver:
+ *
+ *  - the vertical rate is smoothed over recent fixes (restarted when the
+ *    sign changes at burst); in descent it is scaled with altitude because
+ *    the parachute falls faster in thinner air (terminal velocity goes as
+ *    1/sqrt(density), density falls off with a scale height of about 7 km)
+ *  - the horizontal velocity at each altitude is taken from a wind profile
+ *    learned on the way up, in TP_BIN_M altitude bins; where nothing was
+ *    learned the last measured velocity is used
+ *  - the track is integrated in TP_STEP_S steps and stops at the ground
+ *    (the lowest altitude seen in a good fix)
+ *
+ * Predictions are only made up to TP_MAX_OUTAGE_S after the last fix. The
+ * frame marks them as extrapolated (see SBDmessage::generatePredictedGPSBytes).
+ *
+ * Typical use:
+ *    if (fix.positionFix) predictor.add(fix);          // every good fix
+ *    ...
+ *    else if (predictor.predict(time(NULL), fix))      // no snapshot
+ *      msg->generatePredictedGPSBytes(fix);
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef TrackPredictor_H
+#define TrackPredictor_H
+
+#include <mbed.h>
+#include "SBDmessage.h"
+
+#define TP_BIN_M 500                // altitude bin of the wind profile (m)
+#define TP_BINS 80                  // bins kept (up to 40 km)
+#define TP_WIND_SMOOTHING 4         // a bin moves 1/4 of the way to each new measurement
+#define TP_RATE_SMOOTHING 4         // same for the vertical rate
+#define TP_STEP_S 5                 // integration step
+#define TP_MAX_OUTAGE_S 600         // no prediction this long after the last fix
+#define TP_SCALE_HEIGHT_M 7000      // density scale height for the descent rate
+
+class TrackPredictor {
+
+public:
+  TrackPredictor();
+
+  ~TrackPredictor();
+
+  /** Learn from a good fix (ignored if positionFix is false)
+   */
+  void add(const GPSFix &fix);
+
+  /** Extrapolate the position at a given time
+   *
+   * @param t Time of the prediction (seconds since 1/1/1970)
+   * @param fix Filled in with the predicted position, vertical velocity,
+   *    ground speed and heading; positionFix is false and SIV is 0
+   * @returns false if there is no fix to start from, t is before it or more
+   *    than TP_MAX_OUTAGE_S after it
+   */
+  bool predict(time_t t, GPSFix &fix);
+
+  /** Learned wind at an altitude
+   *
+   * @param altitude mm above mean sea level
+   * @param north Filled in with the northward velocity (mm/s)
+   * @param east Filled in with the eastward velocity (mm/s)
+   * @returns false if nothing was learned in that bin
+   */
+  bool wind(int32_t altitude, int32_t &north, int32_t &east);
+
+  /** Smoothed vertical rate (mm/s, positive upward) */
+  int32_t vertical_rate();
+
+  /** Forget the last fix, rate and wind profile */
+  void reset();
+
+private:
+  GPSFix _last;
+  bool _haveFix;
+  float _rate;                      // mm/s, positive upward
+  int32_t _ground;                  // lowest altitude seen (mm)
+  int16_t _windN[TP_BINS];          // cm/s
+  int16_t _windE[TP_BINS];          // cm/s
+  bool _windKnown[TP_BINS];
+
+  static int bin(int32_t altitude);
+};
+
+#endif
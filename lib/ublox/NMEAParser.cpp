@@ -0,0 +1,319 @@
+#include "NMEAParser.h"
+
+/* Development Status Notes
+ *
+ * Each function should be preceded by a note on its status:
+ *  - Incomplete
+ *  - Ready for testing
+ *  - Lab tested with GPS
+ *  - Flight tested
+ */
+
+// Status: Ready for testing
+NMEAParser::NMEAParser() {
+  reset();
+}
+
+void NMEAParser::reset() {
+  _state = NMEA_IDLE;
+  _fix = {};
+  _pending = _fix;
+  _sentences = 0;
+  _errors = 0;
+}
+
+const NMEAFix &NMEAParser::fix() {
+  return _fix;
+}
+
+uint32_t NMEAParser::sentences() {
+  return _sentences;
+}
+
+uint32_t NMEAParser::checksum_errors() {
+  return _errors;
+}
+
+/* Everything between '$' and '*' goes into the checksum. Fields are
+ * converted as soon as they end, into _pending, and _pending becomes the
+ * fix only if the two hex digits after '*' match. Sentences of other types
+ * are dropped after their first field.
+ */
+// Status: Ready for testing
+uint8_t NMEAParser::process(char c) {
+  if (c == '$') {
+    _state = NMEA_BODY;
+    _checksum = 0;
+    _type = 0;
+    _field = 0;
+    _length = 0;
+    _pending = _fix;
+    return 0;
+  }
+
+  int h;
+  switch (_state) {
+    case NMEA_BODY:
+      if (c == '*') {
+        end_field();
+        _state = NMEA_CHECKSUM_1;
+      } else if ((c == '\r') || (c == '\n')) {
+        _state = NMEA_IDLE;               // no checksum, not trusted
+      } else {
+        _checksum ^= c;
+        if (c == ',') {
+          end_field();
+          if (_type == 0) {
+            _state = NMEA_IDLE;
+          } else {
+            _field++;
+            _length = 0;
+          }
+        } else if ((_length >= 0) && (_length < NMEA_FIELD_LENGTH)) {
+          _buffer[_length++] = c;
+        } else {
+          _length = -1;                   // too long to be one of ours
+        }
+      }
+      return 0;
+    case NMEA_CHECKSUM_1:
+      h = hex_value(c);
+      if (h < 0) {
+        _state = NMEA_IDLE;
+        return 0;
+      }
+      _received = h << 4;
+      _state = NMEA_CHECKSUM_2;
+      return 0;
+    case NMEA_CHECKSUM_2:
+      _state = NMEA_IDLE;
+      h = hex_value(c);
+      if (h < 0) return 0;
+      if ((_received | h) != _checksum) {
+        _errors++;
+        return 0;
+      }
+      if (_type == 0) return 0;
+      _fix = _pending;
+      _sentences++;
+      return _type;
+    default:
+      return 0;
+  }
+}
+
+void NMEAParser::end_field() {
+  if (_length < 0) return;
+  if (_field == 0) {
+    sentence_field();
+    return;
+  }
+  switch (_type) {
+    case NMEA_GGA:
+      gga_field();
+      break;
+    case NMEA_RMC:
+      rmc_field();
+      break;
+    case NMEA_VTG:
+      vtg_field();
+      break;
+    case NMEA_GSA:
+      gsa_field();
+      break;
+  }
+}
+
+// Talker ID (GP, GN, GL, ...) is ignored
+void NMEAParser::sentence_field() {
+  _type = 0;
+  if (_length != 5) return;
+  const char *s = &_buffer[2];
+  if ((s[0] == 'G') && (s[1] == 'G') && (s[2] == 'A')) _type = NMEA_GGA;
+  else if ((s[0] == 'R') && (s[1] == 'M') && (s[2] == 'C')) _type = NMEA_RMC;
+  else if ((s[0] == 'V') && (s[1] == 'T') && (s[2] == 'G')) _type = NMEA_VTG;
+  else if ((s[0] == 'G') && (s[1] == 'S') && (s[2] == 'A')) _type = NMEA_GSA;
+}
+
+// $xxGGA,time,lat,N/S,lon,E/W,quality,numSV,HDOP,alt,M,sep,M,diffAge,diffStation
+void NMEAParser::gga_field() {
+  int64_t v;
+  int32_t coordinate;
+  switch (_field) {
+    case 1:
+      parse_time();
+      break;
+    case 2:
+      if (parse_coordinate(_buffer, _length, coordinate)) _pending.latitude = coordinate;
+      break;
+    case 3:
+      if ((_length == 1) && (_buffer[0] == 'S') && (_pending.latitude > 0)) _pending.latitude = -_pending.latitude;
+      break;
+    case 4:
+      if (parse_coordinate(_buffer, _length, coordinate)) _pending.longitude = coordinate;
+      break;
+    case 5:
+      if ((_length == 1) && (_buffer[0] == 'W') && (_pending.longitude > 0)) _pending.longitude = -_pending.longitude;
+      break;
+    case 6:
+      if (parse_decimal(_buffer, _length, 0, v)) _pending.positionValid = v > 0;
+      break;
+    case 7:
+      if (parse_decimal(_buffer, _length, 0, v)) _pending.SIV = (uint8_t)v;
+      break;
+    case 8:
+      if (parse_decimal(_buffer, _length, 2, v)) _pending.hDOP = (uint16_t)v;
+      break;
+    case 9:
+      if (parse_decimal(_buffer, _length, 3, v)) _pending.altitudeMSL = (int32_t)v;
+      break;
+    case 11:
+      if (parse_decimal(_buffer, _length, 3, v)) _pending.geoidSeparation = (int32_t)v;
+      break;
+  }
+}
+
+// $xxRMC,time,status,lat,N/S,lon,E/W,knots,course,date,magVar,E/W,mode
+void NMEAParser::rmc_field() {
+  int64_t v;
+  int32_t coordinate;
+  switch (_field) {
+    case 1:
+      parse_time();
+      break;
+    case 2:
+      _pending.positionValid = (_length == 1) && (_buffer[0] == 'A');
+      break;
+    case 3:
+      if (parse_coordinate(_buffer, _length, coordinate)) _pending.latitude = coordinate;
+      break;
+    case 4:
+      if ((_length == 1) && (_buffer[0] == 'S') && (_pending.latitude > 0)) _pending.latitude = -_pending.latitude;
+      break;
+    case 5:
+      if (parse_coordinate(_buffer, _length, coordinate)) _pending.longitude = coordinate;
+      break;
+    case 6:
+      if ((_length == 1) && (_buffer[0] == 'W') && (_pending.longitude > 0)) _pending.longitude = -_pending.longitude;
+      break;
+    case 7:
+      // 1 knot = 1852 m/h
+      if (parse_decimal(_buffer, _length, 3, v)) _pending.groundSpeed = (int32_t)((v * 1852 + 1800) / 3600);
+      break;
+    case 8:
+      if (parse_decimal(_buffer, _length, 5, v)) _pending.heading = (int32_t)v;
+      break;
+    case 9:
+      if (_length == 6) {
+        _pending.day = (_buffer[0] - '0') * 10 + (_buffer[1] - '0');
+        _pending.month = (_buffer[2] - '0') * 10 + (_buffer[3] - '0');
+        _pending.year = 2000 + (_buffer[4] - '0') * 10 + (_buffer[5] - '0');
+        _pending.dateValid = (_pending.day >= 1) && (_pending.day <= 31) &&
+          (_pending.month >= 1) && (_pending.month <= 12);
+      } else {
+        _pending.dateValid = false;
+      }
+      break;
+  }
+}
+
+// $xxVTG,courseTrue,T,courseMag,M,knots,N,km/h,K,mode
+void NMEAParser::vtg_field() {
+  int64_t v;
+  switch (_field) {
+    case 1:
+      if (parse_decimal(_buffer, _length, 5, v)) _pending.heading = (int32_t)v;
+      break;
+    case 7:
+      // km/h with 3 decimals is m/h
+      if (parse_decimal(_buffer, _length, 3, v)) _pending.groundSpeed = (int32_t)((v * 1000 + 1800) / 3600);
+      break;
+  }
+}
+
+// $xxGSA,opMode,navMode,sv1,...,sv12,PDOP,HDOP,VDOP(,systemId)
+void NMEAParser::gsa_field() {
+  int64_t v;
+  switch (_field) {
+    case 2:
+      if (parse_decimal(_buffer, _length, 0, v)) _pending.fixType = (v >= 2) ? (uint8_t)v : 0;
+      break;
+    case 15:
+      if (parse_decimal(_buffer, _length, 2, v)) _pending.pDOP = (uint16_t)v;
+      break;
+    case 16:
+      if (parse_decimal(_buffer, _length, 2, v)) _pending.hDOP = (uint16_t)v;
+      break;
+    case 17:
+      if (parse_decimal(_buffer, _length, 2, v)) _pending.vDOP = (uint16_t)v;
+      break;
+  }
+}
+
+// hhmmss(.sss)
+bool NMEAParser::parse_time() {
+  _pending.timeValid = false;
+  if (_length < 6) return false;
+  for (int i = 0; i < 6; i++)
+    if ((_buffer[i] < '0') || (_buffer[i] > '9')) return false;
+  _pending.hour = (_buffer[0] - '0') * 10 + (_buffer[1] - '0');
+  _pending.minute = (_buffer[2] - '0') * 10 + (_buffer[3] - '0');
+  _pending.second = (_buffer[4] - '0') * 10 + (_buffer[5] - '0');
+  int64_t ms = 0;
+  if ((_length > 7) && (_buffer[6] == '.') && !parse_decimal(&_buffer[6], _length - 6, 3, ms)) return false;
+  _pending.millisecond = (uint16_t)ms;
+  _pending.timeValid = (_pending.hour < 24) && (_pending.minute < 60) && (_pending.second <= 60);
+  return _pending.timeValid;
+}
+
+// Status: Ready for testing
+bool NMEAParser::parse_decimal(const char *s, int len, int decimals, int64_t &value) {
+  int i = 0;
+  bool negative = false;
+  if ((len > 0) && ((s[0] == '-') || (s[0] == '+'))) {
+    negative = s[0] == '-';
+    i++;
+  }
+  int64_t v = 0;
+  int digits = 0;
+  int fraction = -1;            // digits seen after the point, -1 before it
+  for (; i < len; i++) {
+    char c = s[i];
+    if ((c == '.') && (fraction < 0)) {
+      fraction = 0;
+    } else if ((c >= '0') && (c <= '9')) {
+      digits++;
+      if (fraction < 0) {
+        v = v * 10 + (c - '0');
+      } else if (fraction < decimals) {
+        v = v * 10 + (c - '0');
+        fraction++;
+      }
+    } else {
+      return false;
+    }
+  }
+  if (digits == 0) return false;
+  for (int f = (fraction < 0 ? 0 : fraction); f < decimals; f++)
+    v *= 10;
+  value = negative ? -v : v;
+  return true;
+}
+
+// Status: Ready for testing
+bool NMEAParser::parse_coordinate(const char *s, int len, int32_t &value) {
+  int64_t v;
+  if (!parse_decimal(s, len, 7, v) || (v < 0)) return false;
+  int64_t degrees = v / 1000000000;         // (d)dd
+  int64_t minutes = v % 1000000000;         // mm.mmmmmmm * 10^7
+  if (minutes >= 600000000) return false;
+  value = (int32_t)(degrees * 10000000 + (minutes + 30) / 60);
+  return true;
+}
+
+int NMEAParser::hex_value(char c) {
+  if ((c >= '0') && (c <= '9')) return c - '0';
+  if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+  if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+  return -1;
+}
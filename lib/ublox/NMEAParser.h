@@ -0,0 +1,125 @@
+/** Incremental NMEA 0183 parser (GGA, RMC, VTG and GSA)
+ *
+ * Some receivers come up with UBX output disabled, and then NMEA is all
+ * there is. The parser takes one character at a time, so it can sit
+ * directly behind Ublox_GPS::process(). It keeps the XOR checksum as the
+ * characters go by and converts each field with integer arithmetic when the
+ * field ends (no sscanf, atof or heap). Fields go into a scratch copy of
+ * the fix that only replaces the real one once the checksum has matched.
+ *
+ * Units match the UBX NAV-PVT fields held by Ublox_GPS, so the same getters
+ * work whichever protocol the receiver is speaking.
+ *
+ *  @author John M. Larkin (jlarkin@whitworth.edu)
+ *  @version 0.1
+ *  @date 2021
+ *  @copyright MIT License
+ */
+
+#ifndef NMEAParser_H
+#define NMEAParser_H
+
+#include <stdint.h>
+
+#define NMEA_GGA 0x01
+#define NMEA_RMC 0x02
+#define NMEA_VTG 0x04
+#define NMEA_GSA 0x08
+
+#define NMEA_FIELD_LENGTH 16        // longest field kept (longer ones are ignored)
+
+/** Navigation data from NMEA sentences (UBX NAV-PVT units)
+ */
+struct NMEAFix {
+  uint8_t hour;
+  uint8_t minute;
+  uint8_t second;
+  uint16_t millisecond;
+  uint16_t year;
+  uint8_t month;
+  uint8_t day;
+  bool timeValid;
+  bool dateValid;
+  bool positionValid;       // RMC status A or GGA quality > 0
+  uint8_t fixType;          // 0 = none, 2 = 2D, 3 = 3D (from GSA)
+  uint8_t SIV;              // satellites used (from GGA)
+  int32_t latitude;         // degrees * 10^-7
+  int32_t longitude;        // degrees * 10^-7
+  int32_t altitudeMSL;      // mm above mean sea level
+  int32_t geoidSeparation;  // mm (ellipsoid height = altitudeMSL + geoidSeparation)
+  int32_t groundSpeed;      // mm/s
+  int32_t heading;          // degrees * 10^-5
+  uint16_t pDOP;            // * 0.01
+  uint16_t hDOP;            // * 0.01
+  uint16_t vDOP;            // * 0.01
+};
+
+class NMEAParser {
+
+public:
+  NMEAParser();
+
+  /** Process one character of the stream
+   *
+   * @param c Next character from the receiver
+   * @returns NMEA_GGA, NMEA_RMC, NMEA_VTG or NMEA_GSA when c completes a
+   *    sentence of that type with a good checksum, otherwise 0
+   */
+  uint8_t process(char c);
+
+  /** Latest values (each field keeps its value until a sentence updates it) */
+  const NMEAFix &fix();
+
+  /** Sentences of the four types accepted so far */
+  uint32_t sentences();
+
+  /** Sentences dropped for a bad checksum */
+  uint32_t checksum_errors();
+
+  /** Forget the fix and counters */
+  void reset();
+
+  /** Parse a decimal number into an integer scaled by 10^decimals
+   *
+   * @param s Digits with an optional sign and decimal point
+   * @param len Number of characters
+   * @param decimals Digits kept after the point (extra ones are dropped)
+   * @param value Result
+   * @returns false if the field is empty or not a number
+   */
+  static bool parse_decimal(const char *s, int len, int decimals, int64_t &value);
+
+  /** Convert NMEA (d)ddmm.mmmm to degrees * 10^-7 */
+  static bool parse_coordinate(const char *s, int len, int32_t &value);
+
+private:
+  enum State {
+    NMEA_IDLE = 0,
+    NMEA_BODY,
+    NMEA_CHECKSUM_1,
+    NMEA_CHECKSUM_2
+  };
+
+  State _state;
+  uint8_t _checksum;
+  uint8_t _received;
+  uint8_t _type;
+  int _field;
+  char _buffer[NMEA_FIELD_LENGTH];
+  int _length;
+  NMEAFix _fix;
+  NMEAFix _pending;
+  uint32_t _sentences;
+  uint32_t _errors;
+
+  void end_field();
+  void sentence_field();
+  void gga_field();
+  void rmc_field();
+  void vtg_field();
+  void gsa_field();
+  bool parse_time();
+  static int hex_value(char c);
+};
+
+#endif
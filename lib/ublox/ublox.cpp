@@ -1,5 +1,5 @@
 /****************************************************************************
- * Class for interfacing with a Ublox GPS module via I2C (DDC)
+ * Class for interfacing with a Ublox GPS module via I2C (DDC) or UART
  * 
  * Written for Mbed OS by John M. Larkin (February 17, 2020)
  * Released under the MIT License (http://opensource.org/licenses/MIT).
@@ -42,6 +42,17 @@ Ublox_GPS::Ublox_GPS(I2C* i2c, uint8_t deviceAddress) {
   _pollingTimer.start();
 }
 
+Ublox_GPS::Ublox_GPS(BufferedSerial* serial) {
+  _serialPort = serial;
+  commType = COMM_TYPE_SERIAL;
+  currentGeofenceParams.numFences = 0; // Zero the number of geofences currently in use
+  moduleQueried.versionNumber = false;
+  _pollingTimer.start();
+  //BufferedSerial fills its ring buffer from the UART interrupt. sigio wakes
+  //waitForData when new bytes arrive.
+  _serialPort->sigio(callback(this, &Ublox_GPS::dataReadyISR));
+}
+
 //Enable or disable the printing of sent/response HEX values.
 //Use this in conjunction with 'Transport Logging' from the Universal Reader Assistant to see what they're doing that we're not
 void Ublox_GPS::enableDebugging(void)
@@ -114,6 +125,9 @@ const char* Ublox_GPS::statusString(UbloxStatus_e stat)
   case UBLOX_STATUS_I2C_COMM_FAILURE:
     return "I2C Comm Failure";
     break;
+  case UBLOX_STATUS_PENDING:
+    return "Pending";
+    break;
   default:
     return "Unknown Status";
     break;
@@ -177,6 +191,166 @@ bool Ublox_GPS::setI2CAddress(uint8_t deviceAddress, uint16_t maxWait)
   return (false);
 }
 
+//Configure the receiver's TX-ready output for the DDC (I2C) port and attach an interrupt to it
+//CFG-PRT txReady field (payload bytes 2-3): bit 0 enable, bit 1 polarity (1 = active low),
+//bits 2-6 PIO number, bits 7-15 threshold in units of 8 bytes.
+//Check the integration manual for which PIO can be used on a given module.
+bool Ublox_GPS::setTxReady(PinName pin, uint8_t gpsPIO, bool activeLow, uint16_t thresholdBytes, uint16_t maxWait)
+{
+  if (commType != COMM_TYPE_I2C)
+    return (false); //Serial data arrival is already interrupt driven
+
+  //Get the current config values for the I2C port
+  if (getPortSettings(COM_PORT_I2C, maxWait) == false)
+    return (false);
+  if (commandAck != UBX_ACK_ACK)
+  {
+    debugPrintln("setTxReady: failed to read port settings");
+    return (false);
+  }
+
+  uint16_t threshold = (thresholdBytes + 7) / 8;
+  if (threshold == 0)
+    threshold = 1;
+  if (threshold > 0x1FF)
+    threshold = 0x1FF;
+  uint16_t txReady = 0x0001 | ((activeLow ? 1 : 0) << 1) | ((gpsPIO & 0x1F) << 2) | (threshold << 7);
+
+  packetCfg.cls = UBX_CLASS_CFG;
+  packetCfg.id = UBX_CFG_PRT;
+  packetCfg.len = 20;
+  packetCfg.startingSpot = 0;
+
+  //payloadCfg is now loaded with current bytes. Change only the ones we need to
+  payloadCfg[2] = txReady & 0xFF;
+  payloadCfg[3] = txReady >> 8;
+
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_SENT)
+    return (false);
+
+  if (_txReadyPin != NULL)
+    delete _txReadyPin;
+  _txReadyPin = new InterruptIn(pin);
+  _txReadyActiveLow = activeLow;
+  if (activeLow)
+    _txReadyPin->fall(callback(this, &Ublox_GPS::dataReadyISR));
+  else
+    _txReadyPin->rise(callback(this, &Ublox_GPS::dataReadyISR));
+  return (true);
+}
+
+//Turn TX-ready off in the receiver and go back to polling on i2cPollingWait
+bool Ublox_GPS::disableTxReady(uint16_t maxWait)
+{
+  if (_txReadyPin != NULL)
+  {
+    delete _txReadyPin; //Detaches the interrupt
+    _txReadyPin = NULL;
+  }
+
+  if (getPortSettings(COM_PORT_I2C, maxWait) == false || commandAck != UBX_ACK_ACK)
+    return (false);
+
+  packetCfg.cls = UBX_CLASS_CFG;
+  packetCfg.id = UBX_CFG_PRT;
+  packetCfg.len = 20;
+  packetCfg.startingSpot = 0;
+  payloadCfg[2] = 0;
+  payloadCfg[3] = 0;
+
+  return (sendCommand(packetCfg, maxWait) == UBLOX_STATUS_DATA_SENT);
+}
+
+//Returns true if TX-ready is in use and the receiver has data waiting
+bool Ublox_GPS::txReadyAsserted()
+{
+  if (_txReadyPin == NULL)
+    return (false);
+  return (_txReadyPin->read() == (_txReadyActiveLow ? 0 : 1));
+}
+
+//Interrupt handler for the TX-ready pin and serial sigio. Wakes anyone waiting in waitForData.
+void Ublox_GPS::dataReadyISR()
+{
+  _dataReady.release();
+}
+
+//Sleep until more data may be waiting. With TX-ready or serial this blocks on the
+//data interrupt (or the timeout); otherwise it is the short delay between polls.
+void Ublox_GPS::waitForData(std::chrono::microseconds timeout)
+{
+  if (commType == COMM_TYPE_SERIAL)
+  {
+    if (_serialPort->readable())
+      return;
+  }
+  else if (_txReadyPin == NULL)
+  {
+    wait_us(500);
+    return;
+  }
+  else if (txReadyAsserted())
+    return; //More than the threshold still waiting, no new edge will come
+  if (timeout.count() > 0)
+    _dataReady.try_acquire_for(std::chrono::duration_cast<std::chrono::milliseconds>(timeout) + 1ms);
+}
+
+//Returns the I2C activity counters. Each skipped poll would otherwise have cost two transactions.
+UbloxBusCounters Ublox_GPS::getBusCounters()
+{
+  return (_busCounters);
+}
+
+void Ublox_GPS::resetBusCounters()
+{
+  _busCounters = {0, 0, 0, 0};
+}
+
+//Changes the serial baud rate of the Ublox module, uartPort should be COM_PORT_UART1/2
+//If we are talking to the module over that UART our own baud rate is changed too.
+//The receiver answers at the new rate, so no ACK is expected.
+bool Ublox_GPS::setSerialRate(uint32_t baudrate, uint8_t uartPort, uint16_t maxWait)
+{
+  //Get the current config values for the UART port
+  if (getPortSettings(uartPort, maxWait) == false || commandAck != UBX_ACK_ACK)
+  {
+    debugPrintln("setSerialRate: failed to read port settings");
+    return (false);
+  }
+
+  packetCfg.cls = UBX_CLASS_CFG;
+  packetCfg.id = UBX_CFG_PRT;
+  packetCfg.len = 20;
+  packetCfg.startingSpot = 0;
+
+  //payloadCfg is now loaded with current bytes. Change only the ones we need to
+  payloadCfg[8] = baudrate;
+  payloadCfg[9] = baudrate >> 8;
+  payloadCfg[10] = baudrate >> 16;
+  payloadCfg[11] = baudrate >> 24;
+
+  sendCommand(packetCfg, 0); //Don't expect ACK, it comes back at the new rate
+
+  if (commType == COMM_TYPE_SERIAL && uartPort == COM_PORT_UART1)
+  {
+    ThisThread::sleep_for(100ms); //Let the command leave before switching
+    _serialPort->set_baud(baudrate);
+  }
+  return (true);
+}
+
+//Configure UART1 port to output UBX, NMEA, RTCM3 or a combination thereof
+bool Ublox_GPS::setUART1Output(uint8_t comSettings, uint16_t maxWait)
+{
+  return (setPortOutput(COM_PORT_UART1, comSettings, maxWait));
+}
+
+//Configure UART2 port to output UBX, NMEA, RTCM3 or a combination thereof
+bool Ublox_GPS::setUART2Output(uint8_t comSettings, uint16_t maxWait)
+{
+  return (setPortOutput(COM_PORT_UART2, comSettings, maxWait));
+}
+
 //Want to see the NMEA messages on a Serial port? Here's how
 void Ublox_GPS::setNMEAOutputPort(BufferedSerial &nmeaOutputPort)
 {
@@ -188,27 +362,54 @@ bool Ublox_GPS::checkUblox()
 {
   if (commType == COMM_TYPE_I2C)
     return (checkUbloxI2C());
-  // else if (commType == COMM_TYPE_SERIAL)
-  //   return (checkUbloxSerial());
+  else if (commType == COMM_TYPE_SERIAL)
+    return (checkUbloxSerial());
   return false;
 }
 
+//Drains the serial receive buffer, passing the bytes to process()
+//Returns true if any bytes were read
+bool Ublox_GPS::checkUbloxSerial()
+{
+  uint8_t buf[64];
+  bool gotData = false;
+  while (_serialPort->readable())
+  {
+    ssize_t n = _serialPort->read(buf, sizeof(buf)); //Returns what is already buffered, up to sizeof(buf)
+    if (n <= 0)
+      break;
+    process(buf, n);
+    gotData = true;
+  }
+  return gotData;
+}
+
 
 
 //Polls I2C for data, passing any new bytes to process()
 //Returns true if new bytes are available
 bool Ublox_GPS::checkUbloxI2C()
 {
+  //With TX-ready in use the pin tells us if anything is waiting, so an idle
+  //receiver costs no bus traffic and there is no need to rate limit polls
+  if (_txReadyPin != NULL && !txReadyAsserted())
+  {
+    _busCounters.pollsSkipped++;
+    return false;
+  }
+
   DigitalOut led(LED1);
   led = 0;
   char cmd[MAX_PAYLOAD_SIZE];
   char nak;
   char addr = _gpsI2Caddress<<1; // We need 8-bit version of address
   _i2c->lock();
-  if (_pollingTimer.elapsed_time() >= i2cPollingWait)
+  if (_txReadyPin != NULL || _pollingTimer.elapsed_time() >= i2cPollingWait)
   {
     //Get the number of bytes available from the module
     uint16_t bytesAvailable = 0;
+    _busCounters.polls++;
+    _busCounters.transactions += 2;
     cmd[0] = 0xFD; //0xFD (MSB) and 0xFE (LSB) are the registers that contain number of bytes available
     nak = _i2c->write(addr, cmd, 1, true); // Do not send STOP signal
     if (nak) {
@@ -231,6 +432,7 @@ bool Ublox_GPS::checkUbloxI2C()
     if (bytesAvailable == 0)
     {
       debugPrintln("checkUbloxI2C: OK, zero bytes available");
+      _busCounters.emptyPolls++;
       _pollingTimer.reset();
       _i2c->unlock();
       return false;
@@ -266,31 +468,40 @@ bool Ublox_GPS::checkUbloxI2C()
     }
 
     // mbed version
+    //The register address stays at 0xFF while the stream is read, so only the
+    //first chunk needs the address write. Long drains (e.g. retrieveBatch) are
+    //then one read per MAX_PAYLOAD_SIZE bytes.
     int bytesToRead;
     bool firstRead = true;
     while (bytesAvailable) {
       if (bytesAvailable > MAX_PAYLOAD_SIZE) {
         bytesToRead = MAX_PAYLOAD_SIZE;
       } else bytesToRead = bytesAvailable;
-      cmd[0] = 0xFF; //0xFF is the register to read data from
-      nak = _i2c->write(addr, cmd, 1, true);
-      if (nak) {
-        _i2c->unlock();
-        return false;
+      if (firstRead) {
+        cmd[0] = 0xFF; //0xFF is the register to read data from
+        _busCounters.transactions++;
+        nak = _i2c->write(addr, cmd, 1, true);
+        if (nak) {
+          _i2c->unlock();
+          return false;
+        }
       }
+      _busCounters.transactions++;
       nak = _i2c->read(addr, cmd, bytesToRead);
       if (nak) {
         _i2c->unlock();
         return false;
       }
-      if ((firstRead) && (cmd[0] == 0x7F)) {
+      //0x7F means the module was not ready with data. It can come back on any
+      //chunk, not just the first; inside a UBX frame it may be a payload byte,
+      //and the frame checksum catches it there if it was not.
+      if ((cmd[0] == 0x7F) && (firstRead || (currentSentence != UBX))) {
         debugPrintln("checkUbloxU2C: Ublox error, module not ready with data");
         led = 1;
         _i2c->unlock();
         return false;
       }
-      for (int i = 0; i < bytesToRead; i++)
-        process(cmd[i]);
+      process((uint8_t*)cmd, bytesToRead);
       firstRead = false;
       bytesAvailable -= bytesToRead;
     }
@@ -310,6 +521,7 @@ void Ublox_GPS::process(uint8_t incoming)
       //This is the start of a binary sentence. Reset flags.
       //We still don't know the response class
       ubxFrameCounter = 0;
+      ubxFrameClass = CLASS_NONE;
 
       rollingChecksumA = 0; //Reset our rolling checksums
       rollingChecksumB = 0;
@@ -350,19 +562,30 @@ void Ublox_GPS::process(uint8_t incoming)
       }
       else
       {
-        packetCfg.counter = 0;
-        packetCfg.valid = false;
+        //Which packet this goes to depends on the ID, so hold the class byte until then
+        ubxFrameClassByte = incoming;
         ubxFrameClass = CLASS_NOT_AN_ACK;
       }
     }
+    else if (ubxFrameCounter == 3 && ubxFrameClass == CLASS_NOT_AN_ACK) //ID
+    {
+      if (isSubscribedFrame(ubxFrameClassByte, incoming))
+        ubxFrameClass = CLASS_SUBSCRIBED;
+      ubxPacket *packet = (ubxFrameClass == CLASS_SUBSCRIBED) ? &packetSub : &packetCfg;
+      packet->counter = 0;
+      packet->valid = false;
+      processUBX(ubxFrameClassByte, packet);
+    }
 
     ubxFrameCounter++;
 
     //Depending on this frame's class, pass different structs and payload arrays
     if (ubxFrameClass == CLASS_ACK)
       processUBX(incoming, &packetAck);
-    else if (ubxFrameClass == CLASS_NOT_AN_ACK)
+    else if (ubxFrameClass == CLASS_NOT_AN_ACK && ubxFrameCounter > 3)
       processUBX(incoming, &packetCfg);
+    else if (ubxFrameClass == CLASS_SUBSCRIBED)
+      processUBX(incoming, &packetSub);
   }
   else if (currentSentence == NMEA)
   {
@@ -374,7 +597,36 @@ void Ublox_GPS::process(uint8_t incoming)
   }
 }
 
-//This is the default or generic NMEA processor. We're only going to pipe the data to serial port so we can see it.
+//Processes a block of bytes (e.g. one I2C read). Framing bytes go through process()
+//one at a time but runs of UBX payload bytes are copied and checksummed as a block.
+void Ublox_GPS::process(const uint8_t *data, uint16_t len)
+{
+  uint16_t i = 0;
+  while (i < len)
+  {
+    uint16_t used = 0;
+    if (currentSentence == UBX && ubxFrameCounter > 3)
+    {
+      if (ubxFrameClass == CLASS_ACK)
+        used = processUBXpayload(&data[i], len - i, &packetAck);
+      else if (ubxFrameClass == CLASS_NOT_AN_ACK)
+        used = processUBXpayload(&data[i], len - i, &packetCfg);
+      else if (ubxFrameClass == CLASS_SUBSCRIBED)
+        used = processUBXpayload(&data[i], len - i, &packetSub);
+    }
+    if (used == 0)
+    {
+      process(data[i]);
+      used = 1;
+    }
+    else
+      ubxFrameCounter += used;
+    i += used;
+  }
+}
+
+//This is the default or generic NMEA processor. Characters are piped to the serial port (if set) so we can see them
+//and handed to the NMEA parser, which fills in the NAV-PVT fields from GGA/RMC/VTG/GSA.
 // Need to add __weak__ attribute in header file if decide to make user-overwrite of this
 // method an option. SparkFun version is like that, but I've opted to not do that (JML).
 void Ublox_GPS::processNMEA(char incoming)
@@ -382,6 +634,91 @@ void Ublox_GPS::processNMEA(char incoming)
   //If user has assigned an output port then pipe the characters there
   if (_nmeaOutputPort != NULL)
     _nmeaOutputPort->write(&incoming,1); //Echo this byte to the serial port
+
+  uint8_t sentence = _nmea.process(incoming);
+  if (sentence != 0)
+    processNMEAsentence(sentence);
+}
+
+//A GGA, RMC, VTG or GSA sentence has passed its checksum. Copy what it carries into the same fields
+//NAV-PVT fills and mark them fresh. NMEA has no vertical velocity, so that field is left alone.
+void Ublox_GPS::processNMEAsentence(uint8_t sentence)
+{
+  const NMEAFix &nmea = _nmea.fix();
+
+  if ((sentence & (NMEA_GGA | NMEA_RMC)) && nmea.timeValid)
+  {
+    gpsHour = nmea.hour;
+    gpsMinute = nmea.minute;
+    gpsSecond = nmea.second;
+    gpsMillisecond = nmea.millisecond;
+    gpsNanosecond = (int32_t)nmea.millisecond * 1000000;
+    moduleQueried.gpsHour = true;
+    moduleQueried.gpsMinute = true;
+    moduleQueried.gpsSecond = true;
+    moduleQueried.gpsNanosecond = true;
+  }
+
+  //GGA quality 0 or RMC status V: the receiver has no fix. Some receivers still fill in the last
+  //position, so the position fields are left alone and only fixType says the fix was lost.
+  if ((sentence & (NMEA_GGA | NMEA_RMC)) && !nmea.positionValid)
+  {
+    fixType = 0;
+    moduleQueried.fixType = true;
+  }
+
+  switch (sentence)
+  {
+  case NMEA_GGA:
+    if (nmea.positionValid)
+    {
+      latitude = nmea.latitude;
+      longitude = nmea.longitude;
+      altitudeMSL = nmea.altitudeMSL;
+      altitude = nmea.altitudeMSL + nmea.geoidSeparation;
+      moduleQueried.latitude = true;
+      moduleQueried.longitude = true;
+      moduleQueried.altitudeMSL = true;
+      moduleQueried.altitude = true;
+    }
+    SIV = nmea.SIV;
+    moduleQueried.SIV = true;
+    break;
+  case NMEA_RMC:
+    if (nmea.positionValid)
+    {
+      latitude = nmea.latitude;
+      longitude = nmea.longitude;
+      groundSpeed = nmea.groundSpeed;
+      headingOfMotion = nmea.heading;
+      moduleQueried.latitude = true;
+      moduleQueried.longitude = true;
+      moduleQueried.groundSpeed = true;
+      moduleQueried.headingOfMotion = true;
+    }
+    if (nmea.dateValid)
+    {
+      gpsYear = nmea.year;
+      gpsMonth = nmea.month;
+      gpsDay = nmea.day;
+      moduleQueried.gpsYear = true;
+      moduleQueried.gpsMonth = true;
+      moduleQueried.gpsDay = true;
+    }
+    break;
+  case NMEA_VTG:
+    groundSpeed = nmea.groundSpeed;
+    headingOfMotion = nmea.heading;
+    moduleQueried.groundSpeed = true;
+    moduleQueried.headingOfMotion = true;
+    break;
+  case NMEA_GSA:
+    fixType = nmea.fixType;
+    pDOP = nmea.pDOP;
+    moduleQueried.fixType = true;
+    moduleQueried.pDOP = true;
+    break;
+  }
 }
 
 //We need to be able to identify an RTCM packet and then the length
@@ -464,6 +801,9 @@ void Ublox_GPS::processUBX(uint8_t incoming, ubxPacket *incomingUBX)
   else if (incomingUBX->counter == 1)
   {
     incomingUBX->id = incoming;
+    //NAV-PVT and subscribed messages arrive asynchronously and are always stored from the start
+    ubxFrameAsync = (incomingUBX->cls == UBX_CLASS_NAV && incoming == UBX_NAV_PVT) || findSubscription(incomingUBX->cls, incoming) != NULL
+                    || findRequest(incomingUBX->cls, incoming, false) != NULL;
   }
   else if (incomingUBX->counter == 2) //Len LSB
   {
@@ -472,6 +812,16 @@ void Ublox_GPS::processUBX(uint8_t incoming, ubxPacket *incomingUBX)
   else if (incomingUBX->counter == 3) //Len MSB
   {
     incomingUBX->len |= incoming << 8;
+    //Drop a frame whose recorded part would not fit this packet's payload array
+    uint16_t startingSpot = ubxFrameAsync ? 0 : incomingUBX->startingSpot;
+    if (incomingUBX->len > payloadSize(incomingUBX) + startingSpot)
+    {
+      currentSentence = NONE; //Reset the sentence to being looking for a new start char
+      if (_printDebug == true)
+      {
+        printf("processUBX: %d byte payload does not fit\r\n", incomingUBX->len);
+      }
+    }
   }
   else if (incomingUBX->counter == incomingUBX->len + 4) //ChecksumA
   {
@@ -517,34 +867,93 @@ void Ublox_GPS::processUBX(uint8_t incoming, ubxPacket *incomingUBX)
   }
   else //Load this byte into the payload array
   {
-    //If a UBX_NAV_PVT packet comes in asynchronously, we need to fudge the startingSpot
+    //If a UBX_NAV_PVT (or subscribed) packet comes in asynchronously, we need to fudge the startingSpot
     uint16_t startingSpot = incomingUBX->startingSpot;
-    if (incomingUBX->cls == UBX_CLASS_NAV && incomingUBX->id == UBX_NAV_PVT)
+    if (ubxFrameAsync)
       startingSpot = 0;
     //Begin recording if counter goes past startingSpot
     if ((incomingUBX->counter - 4) >= startingSpot)
     {
       //Check to see if we have room for this byte
-      if (((incomingUBX->counter - 4) - startingSpot) < MAX_PAYLOAD_SIZE)         //If counter = 208, starting spot = 200, we're good to record.
-        incomingUBX->payload[incomingUBX->counter - 4 - startingSpot] = incoming; //Store this byte into payload array
+      if (((incomingUBX->counter - 4) - startingSpot) < payloadSize(incomingUBX)) //If counter = 208, starting spot = 200, we're good to record.
+        incomingUBX->payload[incomingUBX->counter - 4 - startingSpot] = incoming;  //Store this byte into payload array
     }
   }
 
   incomingUBX->counter++;
-  if (incomingUBX->counter == MAX_PAYLOAD_SIZE)
-  {
-    //Something has gone very wrong
-    currentSentence = NONE; //Reset the sentence to being looking for a new start char
-    if (_printDebug == true)
-    {
-      printf("processUBX: counter hit MAX_PAYLOAD_SIZE\r\n");
-    }
-  }
+}
+
+uint16_t Ublox_GPS::payloadSize(const ubxPacket *packet)
+{
+  if (packet == &packetAck)
+    return (sizeof(payloadAck));
+  if (packet == &packetSub)
+    return (sizeof(payloadSub));
+  return (MAX_PAYLOAD_SIZE);
+}
+
+//Subscribed messages go to packetSub, except the ones processUBXpacket parses out of payloadCfg
+bool Ublox_GPS::isSubscribedFrame(uint8_t msgClass, uint8_t msgID)
+{
+  if (msgClass == UBX_CLASS_NAV && (msgID == UBX_NAV_PVT || msgID == UBX_NAV_HPPOSLLH))
+    return (false);
+  return (findSubscription(msgClass, msgID) != NULL);
+}
+
+//Block version of the payload branch of processUBX(). Files as many payload bytes
+//as are available into incomingUBX and adds them to the rolling checksum.
+//Returns 0 if the packet is not in its payload (header and checksum bytes must
+//go through processUBX). processUBX has already dropped any frame whose recorded
+//part does not fit the payload array.
+uint16_t Ublox_GPS::processUBXpayload(const uint8_t *data, uint16_t len, ubxPacket *incomingUBX)
+{
+  uint16_t counter = incomingUBX->counter;
+  if (counter < 4 || counter >= incomingUBX->len + 4)
+    return 0;
+
+  uint16_t span = incomingUBX->len + 4 - counter;
+  if (span > len)
+    span = len;
+
+  addToChecksum(data, span);
+
+  //If a UBX_NAV_PVT (or subscribed) packet comes in asynchronously, we need to fudge the startingSpot
+  uint16_t startingSpot = incomingUBX->startingSpot;
+  if (ubxFrameAsync)
+    startingSpot = 0;
+  //Skip bytes before startingSpot. len - startingSpot fits the payload array, so the rest does too.
+  uint16_t offset = counter - 4;
+  uint16_t skip = 0;
+  if (offset < startingSpot)
+    skip = (startingSpot - offset < span) ? startingSpot - offset : span;
+  if (span > skip)
+    memcpy(&incomingUBX->payload[offset + skip - startingSpot], &data[skip], span - skip);
+
+  incomingUBX->counter += span;
+  return span;
 }
 
 //Once a packet has been received and validated, identify this packet's class/id and update internal flags
 void Ublox_GPS::processUBXpacket(ubxPacket *msg)
 {
+  //Answers to sendRequest requests go to the request pool
+  matchRequest(msg);
+
+  //Hand subscribed messages to their callback or storage slot
+  ubxSubscription *sub = findSubscription(msg->cls, msg->id);
+  if (sub != NULL)
+  {
+    sub->count++;
+    if (sub->callback)
+      sub->callback(msg);
+    else if (sub->storage != NULL)
+    {
+      uint16_t len = (msg->len < sub->storageSize) ? msg->len : sub->storageSize;
+      memcpy(sub->storage, msg->payload, len);
+      sub->fresh = true;
+    }
+  }
+
   switch (msg->cls)
   {
   case UBX_CLASS_ACK:
@@ -581,11 +990,14 @@ void Ublox_GPS::processUBXpacket(ubxPacket *msg)
 
       fixType = extractByte(20 - startingSpot);
       carrierSolution = extractByte(21 - startingSpot) >> 6; //Get 6th&7th bits of this byte
+      gnssFixOk = extractByte(21 - startingSpot) & 0x01;
       SIV = extractByte(23 - startingSpot);
       longitude = extractLong(24 - startingSpot);
       latitude = extractLong(28 - startingSpot);
       altitude = extractLong(32 - startingSpot);
       altitudeMSL = extractLong(36 - startingSpot);
+      horizontalAccEst = extractLong(40 - startingSpot);
+      verticalAccEst = extractLong(44 - startingSpot);
       verticalVelocity = extractLong(56 - startingSpot);
       groundSpeed = extractLong(60 - startingSpot);
       headingOfMotion = extractLong(64 - startingSpot);
@@ -609,10 +1021,13 @@ void Ublox_GPS::processUBXpacket(ubxPacket *msg)
       moduleQueried.SIV = true;
       moduleQueried.fixType = true;
       moduleQueried.carrierSolution = true;
+      moduleQueried.gnssFixOk = true;
       moduleQueried.verticalVelocity = true;
       moduleQueried.groundSpeed = true;
       moduleQueried.headingOfMotion = true;
       moduleQueried.pDOP = true;
+      moduleQueried.horizontalAccEst = true;
+      moduleQueried.verticalAccEst = true;
     }
     else if (msg->id == UBX_NAV_HPPOSLLH && msg->len == 36)
     {
@@ -651,126 +1066,132 @@ void Ublox_GPS::processUBXpacket(ubxPacket *msg)
   }
 }
 
-//Given a packet and payload, send everything including CRC bytes via I2C port
+//Given a packet and payload, send everything including CRC bytes via the selected port
 UbloxStatus_e Ublox_GPS::sendCommand(ubxPacket outgoingUBX, uint16_t maxWait)
 {
-  UbloxStatus_e retVal = UBLOX_STATUS_SUCCESS;
+  return (sendCommand(outgoingUBX.cls, outgoingUBX.id, outgoingUBX.payload, outgoingUBX.len, maxWait));
+}
 
-  calcChecksum(&outgoingUBX); //Sets checksum A and B bytes of the packet
+//Send a message straight from the caller's payload (no staging copy) and, if maxWait > 0,
+//wait for the ACK or response
+UbloxStatus_e Ublox_GPS::sendCommand(uint8_t msgClass, uint8_t msgID, const uint8_t *payload, uint16_t len, uint16_t maxWait)
+{
+  UbloxStatus_e retVal = UBLOX_STATUS_SUCCESS;
 
   if (_printDebug == true)
   {
+    ubxPacket view = {msgClass, msgID, len, 0, 0, (uint8_t *)payload, 0, 0, false};
     printf("\nSending: ");
-    printPacket(&outgoingUBX);
+    printPacket(&view);
   }
 
-  if (commType == COMM_TYPE_I2C)
-  {
-    retVal = sendI2cCommand(outgoingUBX, maxWait);
-    if (retVal != UBLOX_STATUS_SUCCESS)
-    {
-      debugPrintln("Send I2C Command failed");
-      return retVal;
-    }
-  }
-  else if (commType == COMM_TYPE_SERIAL)
+  retVal = sendFrame(msgClass, msgID, payload, len);
+  if (retVal != UBLOX_STATUS_SUCCESS)
   {
-    debugPrintln("sendCommand: Serial interface not yet implemented");
-    //sendSerialCommand(outgoingUBX);
+    debugPrintln("sendCommand: send failed");
+    return retVal;
   }
 
   if (maxWait > 0)
   {
     //Depending on what we just sent, either we need to look for an ACK or not
-    if (outgoingUBX.cls == UBX_CLASS_CFG)
+    if (msgClass == UBX_CLASS_CFG)
     {
       debugPrintln("sendCommand: Waiting for ACK response");
-      retVal = waitForACKResponse(outgoingUBX.cls, outgoingUBX.id, maxWait); //Wait for Ack response
+      retVal = waitForACKResponse(msgClass, msgID, maxWait); //Wait for Ack response
     }
     else
     {
       debugPrintln("sendCommand: Waiting for No ACK response");
-      retVal = waitForNoACKResponse(outgoingUBX.cls, outgoingUBX.id, maxWait); //Wait for Ack response
+      retVal = waitForNoACKResponse(msgClass, msgID, maxWait); //Wait for Ack response
     }
   }
   return retVal;
 }
 
+//Send one UBX frame on the selected port. The checksum is worked out as the bytes go out,
+//so the payload is read once and never copied.
+UbloxStatus_e Ublox_GPS::sendFrame(uint8_t msgClass, uint8_t msgID, const uint8_t *payload, uint16_t len)
+{
+  if (commType == COMM_TYPE_I2C)
+    return (sendI2cFrame(msgClass, msgID, payload, len));
+  else if (commType == COMM_TYPE_SERIAL)
+  {
+    sendSerialFrame(msgClass, msgID, payload, len);
+    return (UBLOX_STATUS_SUCCESS);
+  }
+  return (UBLOX_STATUS_INVALID_OPERATION);
+}
 
-
-//Returns false if sensor fails to respond to I2C traffic
+//Given a packet and payload, send everything including CRC bytes via I2C port
+//(kept for callers of the packet API; the checksum is recomputed while sending)
 UbloxStatus_e Ublox_GPS::sendI2cCommand(ubxPacket outgoingUBX, uint16_t maxWait)
 {
-  char buf[MAX_PAYLOAD_SIZE];
-  char nak;
-  char addr = _gpsI2Caddress<<1; // We need 8-bit version of address
-  _i2c->lock(); // Lock I2C connection during this method
-
-  //Point at 0xFF data register
-  buf[0] = 0xFF;
-  nak = _i2c->write(addr, buf, 1);
-  if (nak) {
-    _i2c->unlock();
-    return UBLOX_STATUS_I2C_COMM_FAILURE;
-  }
+  return (sendI2cFrame(outgoingUBX.cls, outgoingUBX.id, outgoingUBX.payload, outgoingUBX.len));
+}
 
-  //Write header bytes
-  buf[0] = UBX_SYNCH_1;
-  buf[1] = UBX_SYNCH_2;
-  buf[2] = outgoingUBX.cls;
-  buf[3] = outgoingUBX.id;
-  buf[4] = outgoingUBX.len & 0xFF;
-  buf[5] = outgoingUBX.len >> 8;
-  nak = _i2c->write(addr, buf, 6, false);  
-  if (nak) {
-    _i2c->unlock();
-    return UBLOX_STATUS_I2C_COMM_FAILURE;
-  }
+//Write a whole UBX frame as one I2C write transaction, one byte at a time from the
+//header, the caller's payload and the running checksum.
+//The receiver takes any write of 2 or more bytes as message data (a 1 byte write only
+//sets the register address), so no register pointer write is needed first.
+UbloxStatus_e Ublox_GPS::sendI2cFrame(uint8_t msgClass, uint8_t msgID, const uint8_t *payload, uint16_t len)
+{
+  uint8_t header[6] = {UBX_SYNCH_1, UBX_SYNCH_2, msgClass, msgID, (uint8_t)(len & 0xFF), (uint8_t)(len >> 8)};
+  uint8_t checksumA = 0;
+  uint8_t checksumB = 0;
+  bool acked;
 
-  //Write payload. Limit the sends into 32 byte chunks
-  //This code based on ublox: https://forum.u-blox.com/index.php/20528/how-to-use-i2c-to-get-the-nmea-frames
-  uint16_t bytesToSend = outgoingUBX.len;
+  _i2c->lock(); // Lock I2C connection during this method
+  _i2c->start();
+  acked = (_i2c->write(_gpsI2Caddress << 1) == 1); //write(int) returns 1 on ACK
 
-  //"The number of data bytes must be at least 2 to properly distinguish
-  //from the write access to set the address counter in random read accesses."
-  uint16_t startSpot = 0;
-  while (bytesToSend > 1)
+  for (uint8_t i = 0; acked && i < 6; i++)
   {
-    uint8_t len = bytesToSend;
-    if (len > I2C_BUFFER_LENGTH)
-      len = I2C_BUFFER_LENGTH;
-
-    for (uint16_t x = 0; x < len; x++) {
-      buf[x] = outgoingUBX.payload[startSpot + x];
-    }
-    nak = _i2c->write(addr, buf, len, false);  
-    if (nak) {
-      _i2c->unlock();
-      return UBLOX_STATUS_I2C_COMM_FAILURE;
+    if (i >= 2)
+    {
+      checksumA += header[i];
+      checksumB += checksumA;
     }
-
-    //*outgoingUBX.payload += len; //Move the pointer forward
-    startSpot += len; //Move the pointer forward
-    bytesToSend -= len;
+    acked = (_i2c->write(header[i]) == 1);
   }
-
-  //Write checksum
-  if (bytesToSend == 1) { // include trailing payload byte if exists
-    buf[0] = outgoingUBX.payload[startSpot];
-    buf[1] = outgoingUBX.checksumA;
-    buf[2] = outgoingUBX.checksumB;
-    nak = _i2c->write(addr, buf, 3);
-  } else {
-    buf[0] = outgoingUBX.checksumA;
-    buf[1] = outgoingUBX.checksumB;
-    nak = _i2c->write(addr, buf, 2);
+  for (uint16_t i = 0; acked && i < len; i++)
+  {
+    checksumA += payload[i];
+    checksumB += checksumA;
+    acked = (_i2c->write(payload[i]) == 1);
   }
+  if (acked)
+    acked = (_i2c->write(checksumA) == 1);
+  if (acked)
+    acked = (_i2c->write(checksumB) == 1);
+
+  _i2c->stop();
   _i2c->unlock();
-  if (nak) {
+  _busCounters.transactions++;
+
+  if (!acked)
     return UBLOX_STATUS_I2C_COMM_FAILURE;
-  } else {
-    return UBLOX_STATUS_SUCCESS;
-  }
+  return UBLOX_STATUS_SUCCESS;
+}
+
+//Given a packet and payload, send everything including CRC bytes over the UART
+void Ublox_GPS::sendSerialCommand(ubxPacket outgoingUBX)
+{
+  sendSerialFrame(outgoingUBX.cls, outgoingUBX.id, outgoingUBX.payload, outgoingUBX.len);
+}
+
+//BufferedSerial copies into its transmit ring anyway, so send the caller's payload as it is
+//and checksum it with the block routine
+void Ublox_GPS::sendSerialFrame(uint8_t msgClass, uint8_t msgID, const uint8_t *payload, uint16_t len)
+{
+  uint8_t header[6] = {UBX_SYNCH_1, UBX_SYNCH_2, msgClass, msgID, (uint8_t)(len & 0xFF), (uint8_t)(len >> 8)};
+  uint8_t checksum[2] = {0, 0};
+  fletcherChecksum(&header[2], 4, checksum[0], checksum[1]);
+  fletcherChecksum(payload, len, checksum[0], checksum[1]);
+
+  _serialPort->write(header, 6);
+  _serialPort->write(payload, len);
+  _serialPort->write(checksum, 2);
 }
 
 //Returns true if I2C device ack's
@@ -787,13 +1208,13 @@ bool Ublox_GPS::isConnected()
   else if (commType == COMM_TYPE_SERIAL)
   {
     // Query navigation rate to see whether we get a meaningful response
-    // packetCfg.cls = UBX_CLASS_CFG;
-    // packetCfg.id = UBX_CFG_RATE;
-    // packetCfg.len = 0;
-    // packetCfg.startingSpot = 0;
+    packetCfg.cls = UBX_CLASS_CFG;
+    packetCfg.id = UBX_CFG_RATE;
+    packetCfg.len = 0;
+    packetCfg.startingSpot = 0;
 
-    // return sendCommand(packetCfg);
-    return false; // Not implemented yet
+    UbloxStatus_e status = sendCommand(packetCfg);
+    return (status == UBLOX_STATUS_DATA_SENT || status == UBLOX_STATUS_DATA_RECEIVED);
   }
   return false;
 }
@@ -802,26 +1223,47 @@ bool Ublox_GPS::isConnected()
 //This is called before we send a command message
 void Ublox_GPS::calcChecksum(ubxPacket *msg)
 {
+  uint8_t header[4] = {msg->cls, msg->id, (uint8_t)(msg->len & 0xFF), (uint8_t)(msg->len >> 8)};
+
   msg->checksumA = 0;
   msg->checksumB = 0;
+  fletcherChecksum(header, 4, msg->checksumA, msg->checksumB);
+  fletcherChecksum(msg->payload, msg->len, msg->checksumA, msg->checksumB);
+}
 
-  msg->checksumA += msg->cls;
-  msg->checksumB += msg->checksumA;
-
-  msg->checksumA += msg->id;
-  msg->checksumB += msg->checksumA;
+//Add a block of bytes to a running "8-Bit Fletcher" checksum (A += byte, B += A for each byte)
+//Gives the same result as the byte at a time version but works a 32-bit word at a time:
+//over four bytes b0..b3, A gains b0+b1+b2+b3 and B gains 4A + 4b0 + 3b1 + 2b2 + b3.
+//A and B are kept in 32-bit registers and only cut to 8 bits at the end. The low byte
+//of a 32-bit sum is the sum mod 256 even after the register wraps, so this is exact
+//for any length.
+void Ublox_GPS::fletcherChecksum(const uint8_t *data, uint16_t len, uint8_t &checksumA, uint8_t &checksumB)
+{
+  uint32_t a = checksumA;
+  uint32_t b = checksumB;
 
-  msg->checksumA += (msg->len & 0xFF);
-  msg->checksumB += msg->checksumA;
+  while (len >= 8)
+  {
+    uint32_t w0, w1;
+    memcpy(&w0, data, 4); //Cortex-M3 allows unaligned LDR, so this is one load (little endian)
+    memcpy(&w1, data + 4, 4);
 
-  msg->checksumA += (msg->len >> 8);
-  msg->checksumB += msg->checksumA;
+    b += 4 * a + 4 * (w0 & 0xFF) + 3 * ((w0 >> 8) & 0xFF) + 2 * ((w0 >> 16) & 0xFF) + (w0 >> 24);
+    a += (w0 & 0xFF) + ((w0 >> 8) & 0xFF) + ((w0 >> 16) & 0xFF) + (w0 >> 24);
+    b += 4 * a + 4 * (w1 & 0xFF) + 3 * ((w1 >> 8) & 0xFF) + 2 * ((w1 >> 16) & 0xFF) + (w1 >> 24);
+    a += (w1 & 0xFF) + ((w1 >> 8) & 0xFF) + ((w1 >> 16) & 0xFF) + (w1 >> 24);
 
-  for (uint16_t i = 0; i < msg->len; i++)
+    data += 8;
+    len -= 8;
+  }
+  while (len--)
   {
-    msg->checksumA += msg->payload[i];
-    msg->checksumB += msg->checksumA;
+    a += *data++;
+    b += a;
   }
+
+  checksumA = a;
+  checksumB = b;
 }
 
 //Given a message and a byte, add to rolling "8-Bit Fletcher" checksum
@@ -832,6 +1274,12 @@ void Ublox_GPS::addToChecksum(uint8_t incoming)
   rollingChecksumB += rollingChecksumA;
 }
 
+//Given a block of bytes, add to rolling "8-Bit Fletcher" checksum
+void Ublox_GPS::addToChecksum(const uint8_t *data, uint16_t len)
+{
+  fletcherChecksum(data, len, rollingChecksumA, rollingChecksumB);
+}
+
 //Pretty prints the current ubxPacket
 void Ublox_GPS::printPacket(ubxPacket *packet)
 {
@@ -949,7 +1397,7 @@ UbloxStatus_e Ublox_GPS::waitForACKResponse(uint8_t requestedClass, uint8_t requ
       }
     } //checkUblox == true
 
-    wait_us(500);
+    waitForData(std::chrono::milliseconds(maxTime) - _pollingTimer.elapsed_time());
   } //while (_pollingTimer.elapsed_time() < std::chrono::milliseconds(maxTime))
 
   //TODO add check here if config went valid but we never got the following ack
@@ -1016,7 +1464,7 @@ UbloxStatus_e Ublox_GPS::waitForNoACKResponse(uint8_t requestedClass, uint8_t re
       }
     }
 
-    wait_us(500);
+    waitForData(std::chrono::milliseconds(maxTime) - _pollingTimer.elapsed_time());
   }
 
   if (_printDebug == true)
@@ -1496,6 +1944,31 @@ bool Ublox_GPS::setSurveyMode(uint8_t mode, uint16_t observationTime, float requ
   return (sendCommand(packetCfg, maxWait)); //Wait for ack
 }
 
+//Change the dynamic platform model and, optionally, the measurement period together.
+//On receivers configured with VALSET both keys go in one CFG-VALSET, so a flight phase change
+//costs a single ACKed write. Older receivers use CFG-NAV5 and CFG-RATE (a poll and a write each).
+//measRate is in ms; 0 leaves the navigation rate unchanged.
+bool Ublox_GPS::setNavigationModel(DynamicModel_e newDynamicModel, uint16_t measRate, uint8_t layer, uint16_t maxWait)
+{
+  if (supportsValset())
+  {
+    newCfgValset8(UBLOX_CFG_NAVSPG_DYNMODEL, newDynamicModel, layer);
+    if (measRate > 0)
+      addCfgValset16(UBLOX_CFG_RATE_MEAS, measRate);
+    if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_SENT)
+      return (false);
+    if (measRate > 0)
+      i2cPollingWait = std::chrono::milliseconds(measRate / 4);
+    return (true);
+  }
+
+  if (!setDynamicModel(newDynamicModel, maxWait))
+    return (false);
+  if (measRate > 0)
+    return (setMeasurementRate(measRate, maxWait));
+  return (true);
+}
+
 //Begin Survey-In for NEO-M8P
 bool Ublox_GPS::enableSurveyMode(uint16_t observationTime, float requiredAccuracy, uint16_t maxWait)
 {
@@ -1626,49 +2099,134 @@ bool Ublox_GPS::setI2COutput(uint8_t comSettings, uint16_t maxWait)
 //Max is 40Hz(?!)
 bool Ublox_GPS::setNavigationFrequency(uint8_t navFreq, uint16_t maxWait)
 {
+  if (navFreq == 0)
+    return (false);
+  return (setMeasurementRate(1000 / navFreq, maxWait));
+}
 
-  //Adjust the I2C polling timeout based on update rate
-  i2cPollingWait = std::chrono::milliseconds(1000 / (navFreq * 4)); //This is the time to wait between checks for new I2C data
+//Set the measurement period in ms. Unlike setNavigationFrequency this can also
+//set rates slower than 1 Hz, and put back exactly what getMeasurementRate read.
+bool Ublox_GPS::setMeasurementRate(uint16_t measRate, uint16_t maxWait)
+{
+  if (measRate == 0)
+    return (false);
 
-  //Query the module for the latest lat/long
   packetCfg.cls = UBX_CLASS_CFG;
   packetCfg.id = UBX_CFG_RATE;
   packetCfg.len = 0;
   packetCfg.startingSpot = 0;
 
-  if (sendCommand(packetCfg, maxWait) == false) //This will load the payloadCfg array with current settings of the given register
-    return (false);                             //If command send fails then bail
-
-  uint16_t measurementRate = 1000 / navFreq;
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_RECEIVED) //This will load the payloadCfg array with current settings of the given register
+    return (false);                                                   //If command send fails then bail
 
   //payloadCfg is now loaded with current bytes. Change only the ones we need to
-  payloadCfg[0] = measurementRate & 0xFF; //measRate LSB
-  payloadCfg[1] = measurementRate >> 8;   //measRate MSB
+  payloadCfg[0] = measRate & 0xFF; //measRate LSB
+  payloadCfg[1] = measRate >> 8;   //measRate MSB
 
-  return (sendCommand(packetCfg, maxWait));
-}
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_SENT)
+    return (false);
 
-//Get the rate at which the module is outputting nav solutions
-uint8_t Ublox_GPS::getNavigationFrequency(uint16_t maxWait)
+  //Adjust the I2C polling timeout based on update rate
+  i2cPollingWait = std::chrono::milliseconds(measRate / 4); //This is the time to wait between checks for new I2C data
+  return (true);
+}
+
+//Set the rate of the high navigation rate solution (UBX-CFG-HNR). HNR messages such as HNR-PVT
+//are output at this rate once enabled (e.g. with subscribe). The I2C polling interval is shortened
+//to match, as with setNavigationFrequency.
+bool Ublox_GPS::setHNRNavigationRate(uint8_t rate, uint16_t maxWait)
 {
-  //Query the module for the latest lat/long
+  if (rate == 0 || rate > 30)
+    return (false);
+
   packetCfg.cls = UBX_CLASS_CFG;
-  packetCfg.id = UBX_CFG_RATE;
-  packetCfg.len = 0;
+  packetCfg.id = UBX_CFG_HNR;
+  packetCfg.len = 4;
   packetCfg.startingSpot = 0;
 
-  if (sendCommand(packetCfg, maxWait) == false) //This will load the payloadCfg array with current settings of the given register
-    return (0);                                 //If command send fails then bail
+  payloadCfg[0] = rate; //highNavRate (Hz)
+  payloadCfg[1] = 0;
+  payloadCfg[2] = 0;
+  payloadCfg[3] = 0;
+
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_SENT)
+    return (false);
+
+  std::chrono::milliseconds wait(1000 / (rate * 4));
+  if (wait < i2cPollingWait)
+    i2cPollingWait = wait;
+  return (true);
+}
+
+std::chrono::milliseconds Ublox_GPS::getI2CpollingWait()
+{
+  return (i2cPollingWait);
+}
 
-  uint16_t measurementRate = 0;
+void Ublox_GPS::setI2CpollingWait(std::chrono::milliseconds wait)
+{
+  i2cPollingWait = wait;
+}
 
-  //payloadCfg is now loaded with current bytes. Get what we need
-  measurementRate = extractInt(0); //Pull from payloadCfg at measRate LSB
+//Configure the TIMEPULSE output with UBX-CFG-TP5 (time pulse 0). The pulse is only output once the
+//receiver is locked to GNSS time, with its rising edge aligned to the top of the UTC (or GPS) second.
+//Each pulse is announced by TIM-TP, which carries the time of the pulse that follows it.
+bool Ublox_GPS::setTimePulse(uint32_t periodUs, uint32_t lengthUs, bool utc, uint16_t maxWait)
+{
+  if (lengthUs >= periodUs)
+    return (false);
+
+  packetCfg.cls = UBX_CLASS_CFG;
+  packetCfg.id = UBX_CFG_TP5;
+  packetCfg.len = 32;
+  packetCfg.startingSpot = 0;
+
+  for (uint8_t x = 0; x < 32; x++)
+    payloadCfg[x] = 0;
+  payloadCfg[0] = 0; //tpIdx: TIMEPULSE
+  payloadCfg[1] = 1; //version
+  //antCableDelay and rfGroupDelay left at 0
+  for (uint8_t x = 0; x < 4; x++)
+  {
+    payloadCfg[8 + x] = periodUs >> (8 * x);	//freqPeriod (not locked)
+    payloadCfg[12 + x] = periodUs >> (8 * x); //freqPeriodLock
+    payloadCfg[20 + x] = lengthUs >> (8 * x); //pulseLenRatioLock (pulseLenRatio 0: no pulse until locked)
+  }
+  //flags: active, lockGnssFreq, lockedOtherSet, isLength, alignToTow, polarity (rising edge on the second)
+  uint32_t flags = 0x01 | 0x02 | 0x04 | 0x10 | 0x20 | 0x40;
+  if (!utc)
+    flags |= (1 << 7); //gridUtcGnss: GPS
+  payloadCfg[28] = flags & 0xFF;
+  payloadCfg[29] = flags >> 8;
+
+  return (sendCommand(packetCfg, maxWait) == UBLOX_STATUS_DATA_SENT);
+}
+
+//Get the rate at which the module is outputting nav solutions
+uint8_t Ublox_GPS::getNavigationFrequency(uint16_t maxWait)
+{
+  uint16_t measurementRate = getMeasurementRate(maxWait);
+  if (measurementRate == 0 || measurementRate > 1000)
+    return (0); //Slower than 1 Hz does not fit the return value
 
   measurementRate = 1000 / measurementRate; //This may return an int when it's a float, but I'd rather not return 4 bytes
   return (measurementRate);
 }
 
+//Get the measurement period in ms
+uint16_t Ublox_GPS::getMeasurementRate(uint16_t maxWait)
+{
+  packetCfg.cls = UBX_CLASS_CFG;
+  packetCfg.id = UBX_CFG_RATE;
+  packetCfg.len = 0;
+  packetCfg.startingSpot = 0;
+
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_RECEIVED) //This will load the payloadCfg array with current settings of the given register
+    return (0);                                                       //If command send fails then bail
+
+  return (extractInt(0)); //measRate
+}
+
 //In case no config access to the GPS is possible and PVT is send cyclically already
 //set config to suitable parameters
 bool Ublox_GPS::assumeAutoPVT(bool enabled, bool implicitUpdate)
@@ -1730,6 +2288,250 @@ bool Ublox_GPS::configureMessage(uint8_t msgClass, uint8_t msgID, uint8_t portID
   return (sendCommand(packetCfg, maxWait));
 }
 
+//Add msgClass/msgID to the auto-message registry and turn the message on for our port
+//Returns false if the registry is full or the receiver does not ACK
+bool Ublox_GPS::subscribe(uint8_t msgClass, uint8_t msgID, Callback<void(const ubxPacket *)> callback, uint8_t sendRate, uint16_t maxWait)
+{
+  return (addSubscription(msgClass, msgID, callback, NULL, 0, sendRate, maxWait));
+}
+
+bool Ublox_GPS::addSubscription(uint8_t msgClass, uint8_t msgID, Callback<void(const ubxPacket *)> callback, uint8_t *storage, uint16_t storageSize, uint8_t sendRate, uint16_t maxWait)
+{
+  ubxSubscription *sub = registerMessage(msgClass, msgID, callback, storage, storageSize);
+  if (sub == NULL)
+    return (false);
+
+  uint8_t portID = (commType == COMM_TYPE_SERIAL) ? COM_PORT_UART1 : COM_PORT_I2C;
+  configureMessage(msgClass, msgID, portID, sendRate, maxWait);
+  if (commandAck != UBX_ACK_ACK)
+  {
+    sub->inUse = false;
+    return (false);
+  }
+  return (true);
+}
+
+//Add (or replace) a registry entry without configuring the receiver. Used directly for messages
+//that are only sent on request, such as LOG-BATCH.
+ubxSubscription *Ublox_GPS::registerMessage(uint8_t msgClass, uint8_t msgID, Callback<void(const ubxPacket *)> callback, uint8_t *storage, uint16_t storageSize)
+{
+  ubxSubscription *sub = findSubscription(msgClass, msgID);
+  for (int i = 0; sub == NULL && i < UBX_MAX_SUBSCRIPTIONS; i++)
+  {
+    if (!subscriptions[i].inUse)
+      sub = &subscriptions[i];
+  }
+  if (sub == NULL)
+  {
+    debugPrintln("subscribe: registry full");
+    return (NULL);
+  }
+
+  sub->cls = msgClass;
+  sub->id = msgID;
+  sub->callback = callback;
+  sub->storage = storage;
+  sub->storageSize = storageSize;
+  sub->fresh = false;
+  sub->count = 0;
+  sub->inUse = true;
+  return (sub);
+}
+
+//Turn the message off and remove it from the registry
+bool Ublox_GPS::unsubscribe(uint8_t msgClass, uint8_t msgID, uint16_t maxWait)
+{
+  ubxSubscription *sub = findSubscription(msgClass, msgID);
+  if (sub == NULL)
+    return (false);
+  sub->inUse = false;
+
+  uint8_t portID = (commType == COMM_TYPE_SERIAL) ? COM_PORT_UART1 : COM_PORT_I2C;
+  configureMessage(msgClass, msgID, portID, 0, maxWait);
+  return (commandAck == UBX_ACK_ACK);
+}
+
+//Returns true if the storage slot for msgClass/msgID was updated since the last call
+bool Ublox_GPS::isMessageFresh(uint8_t msgClass, uint8_t msgID)
+{
+  ubxSubscription *sub = findSubscription(msgClass, msgID);
+  if (sub == NULL || !sub->fresh)
+    return (false);
+  sub->fresh = false;
+  return (true);
+}
+
+uint32_t Ublox_GPS::getMessageCount(uint8_t msgClass, uint8_t msgID)
+{
+  ubxSubscription *sub = findSubscription(msgClass, msgID);
+  return (sub == NULL ? 0 : sub->count);
+}
+
+ubxSubscription *Ublox_GPS::findSubscription(uint8_t msgClass, uint8_t msgID)
+{
+  for (int i = 0; i < UBX_MAX_SUBSCRIPTIONS; i++)
+  {
+    if (subscriptions[i].inUse && subscriptions[i].cls == msgClass && subscriptions[i].id == msgID)
+      return (&subscriptions[i]);
+  }
+  return (NULL);
+}
+
+//Send a request without waiting for the answer. Returns a token for requestStatus/requestPacket,
+//or -1 if all UBX_REQUEST_POOL_SIZE slots are in use or the send failed.
+//CFG polls (see isConfigPoll) are answered with data and an ACK, other CFG messages with an
+//ACK only, and everything else with data only.
+int8_t Ublox_GPS::sendRequest(uint8_t msgClass, uint8_t msgID, const uint8_t *payload, uint16_t len)
+{
+  int8_t token = -1;
+  for (int8_t i = 0; i < UBX_REQUEST_POOL_SIZE; i++)
+  {
+    if (!requests[i].inUse)
+    {
+      token = i;
+      break;
+    }
+  }
+  if (token < 0)
+  {
+    debugPrintln("sendRequest: request pool full");
+    return (-1);
+  }
+
+  ubxRequest *req = &requests[token];
+  req->cls = msgClass;
+  req->id = msgID;
+  req->expectAck = (msgClass == UBX_CLASS_CFG);
+  req->expectData = (msgClass != UBX_CLASS_CFG || isConfigPoll(msgID, len));
+  req->acked = false;
+  req->gotData = false;
+  req->status = UBLOX_STATUS_PENDING;
+  req->sequence = requestSequence++;
+  req->packet = {msgClass, msgID, 0, 0, 0, requestPayload[token], 0, 0, false};
+
+  //Send straight from the caller's payload, no wait
+  req->inUse = true; //Before sending so a fast answer is matched
+  if (sendFrame(msgClass, msgID, payload, len) != UBLOX_STATUS_SUCCESS)
+  {
+    req->inUse = false;
+    return (-1);
+  }
+  return (token);
+}
+
+//Process incoming data until every pending request has been answered or maxWait ms have passed
+UbloxStatus_e Ublox_GPS::waitForRequests(uint16_t maxWait)
+{
+  Timer timer;
+  timer.start();
+  while (pendingRequests() > 0 && timer.elapsed_time() < std::chrono::milliseconds(maxWait))
+  {
+    if (checkUblox() == false)
+      waitForData(std::chrono::milliseconds(maxWait) - timer.elapsed_time());
+  }
+
+  if (pendingRequests() == 0)
+    return (UBLOX_STATUS_SUCCESS);
+  for (int i = 0; i < UBX_REQUEST_POOL_SIZE; i++)
+  {
+    if (requests[i].inUse && requests[i].status == UBLOX_STATUS_PENDING)
+      requests[i].status = UBLOX_STATUS_TIMEOUT;
+  }
+  return (UBLOX_STATUS_TIMEOUT);
+}
+
+UbloxStatus_e Ublox_GPS::requestStatus(int8_t token)
+{
+  if (token < 0 || token >= UBX_REQUEST_POOL_SIZE || !requests[token].inUse)
+    return (UBLOX_STATUS_INVALID_ARG);
+  return (requests[token].status);
+}
+
+ubxPacket *Ublox_GPS::requestPacket(int8_t token)
+{
+  if (token < 0 || token >= UBX_REQUEST_POOL_SIZE || !requests[token].inUse)
+    return (NULL);
+  return (&requests[token].packet);
+}
+
+void Ublox_GPS::releaseRequest(int8_t token)
+{
+  if (token >= 0 && token < UBX_REQUEST_POOL_SIZE)
+    requests[token].inUse = false;
+}
+
+uint8_t Ublox_GPS::pendingRequests()
+{
+  uint8_t count = 0;
+  for (int i = 0; i < UBX_REQUEST_POOL_SIZE; i++)
+  {
+    if (requests[i].inUse && requests[i].status == UBLOX_STATUS_PENDING)
+      count++;
+  }
+  return (count);
+}
+
+//An empty payload polls any CFG message. CFG-PRT, CFG-TP5 and CFG-INF take a 1 byte port or
+//protocol selector, CFG-MSG a 2 byte class/ID, and CFG-VALGET is always a poll.
+bool Ublox_GPS::isConfigPoll(uint8_t msgID, uint16_t len)
+{
+  if (len <= 1)
+    return (true);
+  if (msgID == UBX_CFG_MSG)
+    return (len == 2);
+  return (msgID == UBX_CFG_VALGET);
+}
+
+ubxRequest *Ublox_GPS::findRequest(uint8_t msgClass, uint8_t msgID, bool ack)
+{
+  ubxRequest *oldest = NULL;
+  for (int i = 0; i < UBX_REQUEST_POOL_SIZE; i++)
+  {
+    ubxRequest *req = &requests[i];
+    if (!req->inUse || req->status != UBLOX_STATUS_PENDING || req->cls != msgClass || req->id != msgID)
+      continue;
+    if (ack ? (!req->expectAck || req->acked) : (!req->expectData || req->gotData))
+      continue;
+    if (oldest == NULL || (int32_t)(req->sequence - oldest->sequence) < 0)
+      oldest = req;
+  }
+  return (oldest);
+}
+
+//Match a valid incoming packet (ACK/NAK or data) to the oldest request it answers
+void Ublox_GPS::matchRequest(ubxPacket *msg)
+{
+  ubxRequest *req;
+  if (msg->cls == UBX_CLASS_ACK)
+  {
+    req = findRequest(msg->payload[0], msg->payload[1], true);
+    if (req == NULL)
+      return;
+    if (msg->id == UBX_ACK_NACK)
+    {
+      req->status = UBLOX_STATUS_COMMAND_UNKNOWN;
+      return;
+    }
+    req->acked = true;
+  }
+  else
+  {
+    req = findRequest(msg->cls, msg->id, false);
+    if (req == NULL)
+      return;
+    uint16_t len = (msg->len < UBX_REQUEST_PAYLOAD_SIZE) ? msg->len : UBX_REQUEST_PAYLOAD_SIZE;
+    memcpy(req->packet.payload, msg->payload, len);
+    req->packet.len = len;
+    req->packet.checksumA = msg->checksumA;
+    req->packet.checksumB = msg->checksumB;
+    req->packet.valid = true;
+    req->gotData = true;
+  }
+
+  if ((req->acked || !req->expectAck) && (req->gotData || !req->expectData))
+    req->status = req->expectData ? UBLOX_STATUS_DATA_RECEIVED : UBLOX_STATUS_DATA_SENT;
+}
+
 //Enable a given message type, default of 1 per update rate (usually 1 per second)
 bool Ublox_GPS::enableMessage(uint8_t msgClass, uint8_t msgID, uint8_t portID, uint8_t rate, uint16_t maxWait)
 {
@@ -1867,7 +2669,7 @@ bool Ublox_GPS::addGeofence(int32_t latitude, int32_t longitude, uint32_t radius
     payloadCfg[54] = currentGeofenceParams.rads[3] >> 16;
     payloadCfg[55] = currentGeofenceParams.rads[3] >> 24;
   }
-  return (sendCommand(packetCfg, maxWait)); //Wait for ack
+  return (sendCommand(packetCfg, maxWait) == UBLOX_STATUS_DATA_SENT); //Wait for ack
 }
 
 //Clear all geofences using UBX-CFG-GEOFENCE
@@ -1889,7 +2691,7 @@ bool Ublox_GPS::clearGeofences(uint16_t maxWait)
 
   currentGeofenceParams.numFences = 0; // Zero the number of geofences currently in use
 
-  return (sendCommand(packetCfg, maxWait)); //Wait for ack
+  return (sendCommand(packetCfg, maxWait) == UBLOX_STATUS_DATA_SENT); //Wait for ack
 }
 
 //Clear the antenna control settings using UBX-CFG-ANT
@@ -1918,7 +2720,7 @@ bool Ublox_GPS::getGeofenceState(geofenceState &currentGeofenceState, uint16_t m
   packetCfg.len = 0;
   packetCfg.startingSpot = 0;
 
-  if (sendCommand(packetCfg, maxWait) == false) //Ask module for the geofence status. Loads into payloadCfg.
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_RECEIVED) //Ask module for the geofence status. Loads into payloadCfg.
     return (false);
 
   currentGeofenceState.status = payloadCfg[5];    // Extract the status
@@ -2338,6 +3140,17 @@ uint8_t Ublox_GPS::getCarrierSolutionType(uint16_t maxWait)
   return (carrierSolution);
 }
 
+//Get the gnssFixOK flag: the fix is within the DOP and accuracy masks
+bool Ublox_GPS::getGnssFixOk(uint16_t maxWait)
+{
+  if (moduleQueried.gnssFixOk == false)
+    getPVT(maxWait);
+  moduleQueried.gnssFixOk = false; //Since we are about to give this to user, mark this data as stale
+  moduleQueried.all = false;
+
+  return (gnssFixOk);
+}
+
 // Get the vertical velocity in mm/s, positive = down (added by John Larkin)
 int32_t Ublox_GPS::getVerticalVelocity(uint16_t maxWait)
 {
@@ -2381,6 +3194,28 @@ uint16_t Ublox_GPS::getPDOP(uint16_t maxWait)
   return (pDOP);
 }
 
+//Get the horizontal accuracy estimate from NAV-PVT in mm
+uint32_t Ublox_GPS::getHorizontalAccEst(uint16_t maxWait)
+{
+  if (moduleQueried.horizontalAccEst == false)
+    getPVT(maxWait);
+  moduleQueried.horizontalAccEst = false; //Since we are about to give this to user, mark this data as stale
+  moduleQueried.all = false;
+
+  return (horizontalAccEst);
+}
+
+//Get the vertical accuracy estimate from NAV-PVT in mm
+uint32_t Ublox_GPS::getVerticalAccEst(uint16_t maxWait)
+{
+  if (moduleQueried.verticalAccEst == false)
+    getPVT(maxWait);
+  moduleQueried.verticalAccEst = false; //Since we are about to give this to user, mark this data as stale
+  moduleQueried.all = false;
+
+  return (verticalAccEst);
+}
+
 //Get the current protocol version of the Ublox module we're communicating with
 //This is helpful when deciding if we should call the high-precision Lat/Long (HPPOSLLH) or the regular (POSLLH)
 uint8_t Ublox_GPS::getProtocolVersionHigh(uint16_t maxWait)
@@ -2458,6 +3293,302 @@ bool Ublox_GPS::getProtocolVersion(uint16_t maxWait)
   return (false); //We failed
 }
 
+//Read the unique chip ID (UBX-SEC-UNIQID). The ID is 5 bytes on M8 receivers and 6 on F9;
+//shorter IDs are padded with zeros so every ID fills UBX_UNIQID_LENGTH bytes.
+bool Ublox_GPS::getUniqueChipId(uint8_t id[UBX_UNIQID_LENGTH], uint16_t maxWait)
+{
+  packetCfg.cls = UBX_CLASS_SEC;
+  packetCfg.id = UBX_SEC_UNIQID;
+  packetCfg.len = 0;
+  packetCfg.startingSpot = 0;
+
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_RECEIVED)
+    return (false);
+
+  //Payload is version (1 byte), reserved (3 bytes), then the ID
+  if (packetCfg.len < 9)
+    return (false);
+  uint16_t idLength = packetCfg.len - 4;
+  if (idLength > UBX_UNIQID_LENGTH)
+    idLength = UBX_UNIQID_LENGTH;
+  memset(id, 0, UBX_UNIQID_LENGTH);
+  memcpy(id, &payloadCfg[4], idLength);
+  return (true);
+}
+
+//Find out what the receiver supports: chip ID, protocol version, high precision firmware and which of
+//the optional messages it answers. The message polls go out in batches through the request pool, so
+//the whole probe takes a few round-trips. Store the result and hand it to setCapabilities next boot.
+bool Ublox_GPS::probeCapabilities(UbloxCapabilities &caps, uint16_t maxWait)
+{
+  memset(&caps, 0, sizeof(caps));
+  if (getUniqueChipId(caps.uniqueId, maxWait) == false)
+    return (false);
+  moduleQueried.versionNumber = false;
+  if (getProtocolVersion(maxWait) == false)
+    return (false);
+  caps.protocolHigh = versionHigh;
+  caps.protocolLow = versionLow;
+  caps.highPrecision = highPrecisionReceiver;
+
+  struct capabilityProbe
+  {
+    uint8_t cls;
+    uint8_t id;
+    uint16_t bit;
+  };
+  const capabilityProbe probes[] = {
+      {UBX_CLASS_NAV, UBX_NAV_HPPOSLLH, UBX_CAP_NAV_HPPOSLLH},
+      {UBX_CLASS_HNR, UBX_HNR_PVT, UBX_CAP_HNR_PVT},
+      {UBX_CLASS_MON, UBX_MON_HW, UBX_CAP_MON_HW},
+      {UBX_CLASS_MON, UBX_MON_RF, UBX_CAP_MON_RF},
+      {UBX_CLASS_NAV, UBX_NAV_GEOFENCE, UBX_CAP_NAV_GEOFENCE},
+      {UBX_CLASS_TIM, UBX_TIM_TP, UBX_CAP_TIM_TP},
+      {UBX_CLASS_CFG, UBX_CFG_BATCH, UBX_CAP_CFG_BATCH},
+      {UBX_CLASS_CFG, UBX_CFG_VALGET, UBX_CAP_CFG_VALGET},
+  };
+  const uint8_t probeCount = sizeof(probes) / sizeof(probes[0]);
+  const uint8_t valgetPayload[8] = {0, 0, 0, 0, 0x01, 0x00, 0x21, 0x30}; //Version 0, RAM layer, key CFG-RATE-MEAS
+
+  //An answer (data or ACK) means the message is supported. A NAK or silence means it is not.
+  int8_t tokens[UBX_REQUEST_POOL_SIZE];
+  uint8_t next = 0;
+  while (next < probeCount)
+  {
+    uint8_t first = next;
+    uint8_t batch = 0;
+    while (next < probeCount && batch < UBX_REQUEST_POOL_SIZE)
+    {
+      bool valget = (probes[next].cls == UBX_CLASS_CFG && probes[next].id == UBX_CFG_VALGET);
+      tokens[batch] = sendRequest(probes[next].cls, probes[next].id, valget ? valgetPayload : NULL, valget ? 8 : 0);
+      if (tokens[batch] < 0)
+        break;
+      batch++;
+      next++;
+    }
+    if (batch == 0)
+      return (false); //Request pool is busy or the receiver stopped answering
+
+    waitForRequests(maxWait);
+    for (uint8_t i = 0; i < batch; i++)
+    {
+      UbloxStatus_e status = requestStatus(tokens[i]);
+      if (status == UBLOX_STATUS_DATA_RECEIVED || status == UBLOX_STATUS_DATA_SENT)
+        caps.messages |= probes[first + i].bit;
+      releaseRequest(tokens[i]);
+    }
+  }
+  caps.valset = (caps.messages & UBX_CAP_CFG_VALGET) != 0;
+
+  if (_printDebug == true)
+    printf("Capabilities: protocol %d.%d, messages 0x%04X%s%s\r\n", caps.protocolHigh, caps.protocolLow, caps.messages,
+           caps.highPrecision ? ", high precision" : "", caps.valset ? ", VALSET" : "");
+
+  setCapabilities(caps);
+  return (true);
+}
+
+//Load a stored probe result. The protocol version and high precision flag are marked as known so
+//getProtocolVersionHigh/Low and hasHighPrecisionReceiver no longer poll MON-VER.
+void Ublox_GPS::setCapabilities(const UbloxCapabilities &caps)
+{
+  _capabilities = caps;
+  _capabilitiesKnown = true;
+  versionHigh = caps.protocolHigh;
+  versionLow = caps.protocolLow;
+  highPrecisionReceiver = caps.highPrecision;
+  moduleQueried.versionNumber = true;
+}
+
+//True if the receiver is configured with CFG-VALSET/VALGET rather than the legacy CFG messages
+bool Ublox_GPS::supportsValset(uint16_t maxWait)
+{
+  if (_capabilitiesKnown)
+    return (_capabilities.valset);
+  return (getProtocolVersionHigh(maxWait) >= 27);
+}
+
+//Configure receiver-side batching with UBX-CFG-BATCH. bufferSize is the number of epochs the
+//receiver sets aside (it reserves the memory when batching is enabled). extraPvt adds iTOW, tAcc
+//and pDOP to each entry.
+bool Ublox_GPS::setBatching(bool enable, uint16_t bufferSize, bool extraPvt, uint16_t notifyThreshold, uint8_t pioId, bool pioActiveLow, uint16_t maxWait)
+{
+  packetCfg.cls = UBX_CLASS_CFG;
+  packetCfg.id = UBX_CFG_BATCH;
+  packetCfg.len = 8;
+  packetCfg.startingSpot = 0;
+
+  uint8_t flags = 0;
+  if (enable)
+    flags |= 0x01;
+  if (extraPvt)
+    flags |= 0x04;
+  if (notifyThreshold > 0)
+  {
+    flags |= 0x20; //pioEnable
+    if (pioActiveLow)
+      flags |= 0x40;
+  }
+
+  payloadCfg[0] = 0; //Message version
+  payloadCfg[1] = flags;
+  payloadCfg[2] = bufferSize & 0xFF;
+  payloadCfg[3] = bufferSize >> 8;
+  payloadCfg[4] = notifyThreshold & 0xFF;
+  payloadCfg[5] = notifyThreshold >> 8;
+  payloadCfg[6] = pioId;
+  payloadCfg[7] = 0;
+
+  return (sendCommand(packetCfg, maxWait) == UBLOX_STATUS_DATA_SENT);
+}
+
+bool Ublox_GPS::getBatchStatus(UBX_MON_BATCH_data_t &status, uint16_t maxWait)
+{
+  packetCfg.cls = UBX_CLASS_MON;
+  packetCfg.id = UBX_MON_BATCH;
+  packetCfg.len = 0;
+  packetCfg.startingSpot = 0;
+
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_RECEIVED || packetCfg.len < sizeof(status))
+    return (false);
+  memcpy(&status, payloadCfg, sizeof(status));
+  return (true);
+}
+
+//Poll a MON message and copy its payload. Messages shorter than minLen are treated as no answer;
+//anything beyond size is dropped.
+bool Ublox_GPS::pollMonitor(uint8_t id, uint8_t *data, uint16_t size, uint16_t minLen, uint16_t maxWait)
+{
+  packetCfg.cls = UBX_CLASS_MON;
+  packetCfg.id = id;
+  packetCfg.len = 0;
+  packetCfg.startingSpot = 0;
+
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_RECEIVED || packetCfg.len < minLen)
+    return (false);
+  memset(data, 0, size);
+  memcpy(data, payloadCfg, (packetCfg.len < size) ? packetCfg.len : size);
+  return (true);
+}
+
+bool Ublox_GPS::getHardwareStatus(UBX_MON_HW_data_t &status, uint16_t maxWait)
+{
+  return (pollMonitor(UBX_MON_HW, (uint8_t *)&status, sizeof(status), sizeof(status), maxWait));
+}
+
+bool Ublox_GPS::getRFStatus(UBX_MON_RF_data_t &status, uint16_t maxWait)
+{
+  if (!pollMonitor(UBX_MON_RF, (uint8_t *)&status, sizeof(status), 4, maxWait))
+    return (false);
+  if (status.nBlocks > UBX_MON_RF_MAX_BLOCKS)
+    status.nBlocks = UBX_MON_RF_MAX_BLOCKS;
+  if (packetCfg.len < 4 + 24 * status.nBlocks)
+    status.nBlocks = (packetCfg.len - 4) / 24;
+  return (true);
+}
+
+bool Ublox_GPS::getRxBufferStatus(UBX_MON_RXBUF_data_t &status, uint16_t maxWait)
+{
+  return (pollMonitor(UBX_MON_RXBUF, (uint8_t *)&status, sizeof(status), sizeof(status), maxWait));
+}
+
+bool Ublox_GPS::getTxBufferStatus(UBX_MON_TXBUF_data_t &status, uint16_t maxWait)
+{
+  return (pollMonitor(UBX_MON_TXBUF, (uint8_t *)&status, sizeof(status), sizeof(status), maxWait));
+}
+
+//The thresholds and algorithm bits of CFG-ITFM are left as the receiver has them (u-blox recommend the
+//defaults); only the enable bits are changed.
+bool Ublox_GPS::setJammingMonitor(bool enable, uint16_t maxWait)
+{
+  packetCfg.cls = UBX_CLASS_CFG;
+  packetCfg.id = UBX_CFG_ITFM;
+  packetCfg.len = 0;
+  packetCfg.startingSpot = 0;
+
+  if (sendCommand(packetCfg, maxWait) != UBLOX_STATUS_DATA_RECEIVED || packetCfg.len < 8)
+    return (false);
+
+  if (enable)
+  {
+    payloadCfg[3] |= 0x80; //config: enable
+    payloadCfg[5] |= 0x40; //config2: enable2 (bit 14)
+  }
+  else
+  {
+    payloadCfg[3] &= ~0x80;
+    payloadCfg[5] &= ~0x40;
+  }
+  packetCfg.len = 8;
+  packetCfg.startingSpot = 0;
+  return (sendCommand(packetCfg, maxWait) == UBLOX_STATUS_DATA_SENT);
+}
+
+//Drain the receiver's batch buffer. LOG-RETRIEVEBATCH is sent with sendMonFirst so MON-BATCH
+//arrives first and says how many LOG-BATCH entries follow; checkUblox is then called until they
+//have all been processed. On I2C the entries are read in large blocks by checkUbloxI2C.
+//The two registry entries are borrowed: a subscription the caller already had to MON-BATCH or
+//LOG-BATCH is put back as it was when the drain ends.
+int16_t Ublox_GPS::retrieveBatch(Callback<void(const UBX_LOG_BATCH_data_t &)> entry, uint16_t maxWait)
+{
+  ubxSubscription savedMon = {}; //inUse stays false if there was no entry
+  ubxSubscription savedLog = {};
+  ubxSubscription *sub = findSubscription(UBX_CLASS_MON, UBX_MON_BATCH);
+  if (sub != NULL)
+    savedMon = *sub;
+  sub = findSubscription(UBX_CLASS_LOG, UBX_LOG_BATCH);
+  if (sub != NULL)
+    savedLog = *sub;
+
+  UBX_MON_BATCH_data_t status;
+  if (registerMessage(UBX_CLASS_MON, UBX_MON_BATCH, nullptr, (uint8_t *)&status, sizeof(status)) == NULL)
+    return (-1);
+  if (registerMessage(UBX_CLASS_LOG, UBX_LOG_BATCH, callback(this, &Ublox_GPS::batchEntryReceived), NULL, 0) == NULL)
+  {
+    *findSubscription(UBX_CLASS_MON, UBX_MON_BATCH) = savedMon;
+    return (-1);
+  }
+  _batchCallback = entry;
+  _batchReceived = 0;
+
+  const uint8_t request[4] = {0, 0x01, 0, 0}; //Version 0, sendMonFirst
+  bool monReceived = false;
+  if (sendFrame(UBX_CLASS_LOG, UBX_LOG_RETRIEVEBATCH, request, sizeof(request)) == UBLOX_STATUS_SUCCESS)
+  {
+    Timer timer;
+    timer.start();
+    while (timer.elapsed_time() < std::chrono::milliseconds(maxWait))
+    {
+      monReceived = isMessageFresh(UBX_CLASS_MON, UBX_MON_BATCH) || monReceived;
+      if (monReceived && _batchReceived >= status.fillLevel)
+        break;
+      if (checkUblox() == false)
+        waitForData(std::chrono::milliseconds(maxWait) - timer.elapsed_time());
+    }
+  }
+
+  *findSubscription(UBX_CLASS_MON, UBX_MON_BATCH) = savedMon;
+  *findSubscription(UBX_CLASS_LOG, UBX_LOG_BATCH) = savedLog;
+  _batchCallback = nullptr;
+
+  if (!monReceived)
+    return (-1);
+  if (_printDebug == true && _batchReceived < status.fillLevel)
+    printf("retrieveBatch: %d of %d entries received\r\n", _batchReceived, status.fillLevel);
+  return (_batchReceived);
+}
+
+void Ublox_GPS::batchEntryReceived(const ubxPacket *msg)
+{
+  UBX_LOG_BATCH_data_t batch;
+  if (msg->len < sizeof(batch))
+    return;
+  memcpy(&batch, msg->payload, sizeof(batch));
+  _batchReceived++;
+  if (_batchCallback)
+    _batchCallback(batch);
+}
+
 //Mark all the PVT data as read/stale. This is handy to get data alignment after CRC failure
 void Ublox_GPS::flushPVT()
 {
@@ -2483,6 +3614,8 @@ void Ublox_GPS::flushPVT()
   moduleQueried.groundSpeed = false;
   moduleQueried.headingOfMotion = false;
   moduleQueried.pDOP = false;
+  moduleQueried.horizontalAccEst = false;
+  moduleQueried.verticalAccEst = false;
 }
 
 //Relative Positioning Information in NED frame
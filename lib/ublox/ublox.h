@@ -1,5 +1,5 @@
 /****************************************************************************
- * Class for interfacing with a Ublox GPS module via I2C (DDC)
+ * Class for interfacing with a Ublox GPS module via I2C (DDC) or UART
  * 
  * Written for Mbed OS 5 by John M. Larkin (February 2020)
  * Updated for Mbed OS 6 by John M. Larkin (July 2021)
@@ -46,14 +46,36 @@
 
 #include <mbed.h>
 #include <chrono>
+#include <type_traits>
+#include "NMEAParser.h"
 
 using namespace std::chrono;
 
+#ifndef UBX_MAX_SUBSCRIPTIONS
+#define UBX_MAX_SUBSCRIPTIONS 8 //Number of class/id pairs that can be registered with subscribe()
+#endif
+
+#ifndef UBX_REQUEST_POOL_SIZE
+#define UBX_REQUEST_POOL_SIZE 4 //Number of sendRequest requests that can be outstanding at once
+#endif
+
+#ifndef UBX_REQUEST_PAYLOAD_SIZE
+#define UBX_REQUEST_PAYLOAD_SIZE 96 //Answer kept per request (HNR-PVT is 72 bytes); longer answers are cut to this length
+#endif
+
 #ifndef MAX_PAYLOAD_SIZE
 #define MAX_PAYLOAD_SIZE 256 //We need ~220 bytes for getProtocolVersion on most ublox modules
 //#define MAX_PAYLOAD_SIZE 768 //Worst case: UBX_CFG_VALSET packet with 64 keyIDs each with 64 bit values
 #endif
 
+#ifndef UBX_NAV_SAT_MAX_SVS
+#define UBX_NAV_SAT_MAX_SVS 64 //Satellites in the largest NAV-SAT a subscription can receive (8 + 12 bytes per SV)
+#endif
+
+#ifndef UBX_SUBSCRIPTION_PAYLOAD_SIZE
+#define UBX_SUBSCRIPTION_PAYLOAD_SIZE (8 + 12 * UBX_NAV_SAT_MAX_SVS) //Receive buffer for subscribed messages, sized for NAV-SAT (the largest; LOG-BATCH is 100 bytes). Longer ones are dropped
+#endif
+
 
 #define I2C_BUFFER_LENGTH 32
 
@@ -75,6 +97,7 @@ enum UbloxStatus_e
 	UBLOX_STATUS_DATA_SENT,
 	UBLOX_STATUS_DATA_RECEIVED,
 	UBLOX_STATUS_I2C_COMM_FAILURE,
+	UBLOX_STATUS_PENDING, //Request sent with sendRequest, no answer yet
 };
 
 enum DynamicModel_e {
@@ -107,6 +130,265 @@ struct ubxPacket
 	bool valid; //Goes true when both checksums pass
 };
 
+struct ubxRequest // One outstanding request in the request pool (see sendRequest)
+{
+	bool inUse;
+	uint8_t cls;
+	uint8_t id;
+	bool expectAck;		  // CFG messages are answered with ACK or NAK
+	bool expectData;	  // Polls are answered with a message of the same cls/id
+	bool acked;
+	bool gotData;
+	UbloxStatus_e status; // UBLOX_STATUS_PENDING until answered
+	uint32_t sequence;	  // Older requests are matched first
+	ubxPacket packet;	  // The response, payload points into the pool
+};
+
+// Bits of UbloxCapabilities.messages, set when the receiver answered a poll of that message
+#define UBX_CAP_NAV_HPPOSLLH 0x0001
+#define UBX_CAP_HNR_PVT 0x0002
+#define UBX_CAP_MON_HW 0x0004
+#define UBX_CAP_MON_RF 0x0008
+#define UBX_CAP_NAV_GEOFENCE 0x0010
+#define UBX_CAP_TIM_TP 0x0020
+#define UBX_CAP_CFG_BATCH 0x0040
+#define UBX_CAP_CFG_VALGET 0x0080
+
+#define UBX_UNIQID_LENGTH 6 //SEC-UNIQID is 5 bytes on M8 (padded with 0) and 6 bytes on F9
+
+struct UbloxCapabilities // What a receiver supports (see probeCapabilities). Small enough to keep in FRAM.
+{
+	uint8_t uniqueId[UBX_UNIQID_LENGTH]; // Chip ID from SEC-UNIQID
+	uint8_t protocolHigh;				 // PROTVER XX.00 from MON-VER
+	uint8_t protocolLow;				 // PROTVER 00.XX from MON-VER
+	bool highPrecision;					 // FW string marks a high precision (HPG) receiver
+	bool valset;						 // CFG-VALSET/VALGET configuration interface (protocol 27 and above)
+	uint16_t messages;					 // UBX_CAP_ bits
+};
+
+struct ubxSubscription // One entry of the auto-message registry (see subscribe)
+{
+	bool inUse;
+	uint8_t cls;
+	uint8_t id;
+	Callback<void(const ubxPacket *)> callback; // Called with each valid message, or empty
+	uint8_t *storage;		// Payload is copied here when no callback is given
+	uint16_t storageSize;
+	volatile bool fresh;	// Storage holds a message not yet seen by isMessageFresh
+	uint32_t count;			// Number of valid messages received
+};
+
+// Payloads for subscribe() storage slots. Packed so they match the UBX byte
+// layout (the LPC1768 is little endian like UBX).
+struct __attribute__((packed)) UBX_NAV_STATUS_data_t
+{
+	uint32_t iTOW;	// GPS time of week (ms)
+	uint8_t gpsFix; // 0 no fix, 2 2D, 3 3D, 4 GNSS + dead reckoning, 5 time only
+	uint8_t flags;	// Bit 0 gpsFixOk, bit 1 diffSoln, bit 2 wknSet, bit 3 towSet
+	uint8_t fixStat;
+	uint8_t flags2;
+	uint32_t ttff; // Time to first fix (ms)
+	uint32_t msss; // Milliseconds since startup or reset
+};
+
+struct __attribute__((packed)) UBX_NAV_DOP_data_t
+{
+	uint32_t iTOW; // GPS time of week (ms)
+	uint16_t gDOP; // All DOP values are scaled by 0.01
+	uint16_t pDOP;
+	uint16_t tDOP;
+	uint16_t vDOP;
+	uint16_t hDOP;
+	uint16_t nDOP;
+	uint16_t eDOP;
+};
+
+// One batched navigation epoch (LOG-BATCH, 100 bytes). Sent by the receiver when a batch is
+// retrieved with retrieveBatch. Fields marked extraPvt/extraOdo are only valid if batching was
+// configured with those options (see contentValid).
+struct __attribute__((packed)) UBX_LOG_BATCH_data_t
+{
+	uint8_t version;
+	uint8_t contentValid; // Bit 0 extraPvt fields valid, bit 1 extraOdo fields valid
+	uint16_t msgCnt;	  // Message counter, increments with each batched epoch
+	uint32_t iTOW;		  // GPS time of week (ms), extraPvt
+	uint16_t year;		  // UTC date and time
+	uint8_t month;
+	uint8_t day;
+	uint8_t hour;
+	uint8_t min;
+	uint8_t sec;
+	uint8_t valid;	  // Bit 0 validDate, bit 1 validTime
+	uint32_t tAcc;	  // Time accuracy (ns), extraPvt
+	int32_t fracSec;  // Fraction of second (ns)
+	uint8_t fixType;  // 0 no fix, 2 2D, 3 3D, 4 GNSS + dead reckoning, 5 time only
+	uint8_t flags;	  // Bit 0 gnssFixOK
+	uint8_t flags2;
+	uint8_t numSV;
+	int32_t lon;	  // Degrees * 10^-7
+	int32_t lat;	  // Degrees * 10^-7
+	int32_t height;	  // mm above ellipsoid
+	int32_t hMSL;	  // mm above mean sea level
+	uint32_t hAcc;	  // mm
+	uint32_t vAcc;	  // mm
+	int32_t velN;	  // mm/s
+	int32_t velE;	  // mm/s
+	int32_t velD;	  // mm/s (positive downward)
+	int32_t gSpeed;	  // mm/s
+	int32_t headMot;  // Degrees * 10^-5
+	uint32_t sAcc;	  // mm/s
+	uint32_t headAcc; // Degrees * 10^-5
+	uint16_t pDOP;	  // * 0.01, extraPvt
+	uint8_t reserved2[2];
+	uint32_t distance;		// Ground distance since last reset (m), extraOdo
+	uint32_t totalDistance; // extraOdo
+	uint32_t distanceStd;	// extraOdo
+	uint8_t reserved3[4];
+};
+
+// High rate PVT (HNR-PVT, 72 bytes) from ADR/UDR receivers, output at the CFG-HNR rate (up to 30 Hz).
+// There is no vertical velocity; speed is the 3D speed and gSpeed its horizontal part.
+struct __attribute__((packed)) UBX_HNR_PVT_data_t
+{
+	uint32_t iTOW; // GPS time of week (ms)
+	uint16_t year; // UTC date and time
+	uint8_t month;
+	uint8_t day;
+	uint8_t hour;
+	uint8_t min;
+	uint8_t sec;
+	uint8_t valid;	 // Bit 0 validDate, bit 1 validTime
+	int32_t nano;	 // Fraction of second (ns)
+	uint8_t gpsFix;	 // 0 no fix, 2 2D, 3 3D, 4 GNSS + dead reckoning, 5 time only
+	uint8_t flags;	 // Bit 0 gpsFixOK, bit 5 headVehValid
+	uint8_t reserved1[2];
+	int32_t lon;	 // Degrees * 10^-7
+	int32_t lat;	 // Degrees * 10^-7
+	int32_t height;	 // mm above ellipsoid
+	int32_t hMSL;	 // mm above mean sea level
+	int32_t gSpeed;	 // Ground speed (mm/s)
+	int32_t speed;	 // 3D speed (mm/s)
+	int32_t headMot; // Degrees * 10^-5
+	int32_t headVeh; // Degrees * 10^-5
+	uint32_t hAcc;	 // mm
+	uint32_t vAcc;	 // mm
+	uint32_t sAcc;	 // mm/s
+	uint32_t headAcc; // Degrees * 10^-5
+	uint8_t reserved2[4];
+};
+
+// Time pulse data (TIM-TP, 16 bytes): the time of the next time pulse, sent before that pulse
+struct __attribute__((packed)) UBX_TIM_TP_data_t
+{
+	uint32_t towMS;	   // Time of week of the next pulse (ms)
+	uint32_t towSubMS; // Submillisecond part (ms * 2^-32)
+	int32_t qErr;	   // Quantization error of the pulse (ps)
+	uint16_t week;	   // Week number
+	uint8_t flags;	   // Bit 0 timeBase (0 GNSS, 1 UTC), bit 1 utc available, bit 4 qErrInvalid
+	uint8_t refInfo;
+};
+
+// Geofence status (NAV-GEOFENCE, 8 + 2 * numFences bytes, at most 4 fences)
+struct __attribute__((packed)) UBX_NAV_GEOFENCE_data_t
+{
+	uint32_t iTOW;		// GPS time of week of the navigation epoch (ms)
+	uint8_t version;
+	uint8_t status;		// 0 - Geofencing not available or not reliable; 1 - Geofencing active
+	uint8_t numFences;	// Number of geofences
+	uint8_t combState;	// Combined state of all geofences: 0 - Unknown; 1 - Inside; 2 - Outside
+	struct
+	{
+		uint8_t state;	// 0 - Unknown; 1 - Inside; 2 - Outside
+		uint8_t reserved;
+	} fences[4];
+};
+
+// Hardware status (MON-HW, 60 bytes, M8 and earlier)
+struct __attribute__((packed)) UBX_MON_HW_data_t
+{
+	uint32_t pinSel;
+	uint32_t pinBank;
+	uint32_t pinDir;
+	uint32_t pinVal;
+	uint16_t noisePerMS; // Noise level as measured by the GPS core
+	uint16_t agcCnt;	 // AGC monitor (0 - 8191)
+	uint8_t aStatus;	 // Antenna status: 0 INIT, 1 DONTKNOW, 2 OK, 3 SHORT, 4 OPEN
+	uint8_t aPower;		 // Antenna power: 0 OFF, 1 ON, 2 DONTKNOW
+	uint8_t flags;		 // Bits 2-3 jammingState: 0 unknown or disabled, 1 ok, 2 warning, 3 critical
+	uint8_t reserved1;
+	uint32_t usedMask;
+	uint8_t VP[17];
+	uint8_t jamInd;		 // CW jamming indicator (0 no CW jamming - 255 strong CW jamming)
+	uint8_t reserved2[2];
+	uint32_t pinIrq;
+	uint32_t pullH;
+	uint32_t pullL;
+};
+
+// RF information (MON-RF, 4 + 24 * nBlocks bytes, protocol 27 and above). One block per RF path.
+#define UBX_MON_RF_MAX_BLOCKS 2
+struct __attribute__((packed)) UBX_MON_RF_data_t
+{
+	uint8_t version;
+	uint8_t nBlocks;
+	uint8_t reserved0[2];
+	struct
+	{
+		uint8_t blockId;	 // 0 L1, 1 L2 or L5
+		uint8_t flags;		 // Bits 0-1 jammingState: 0 unknown or disabled, 1 ok, 2 warning, 3 critical
+		uint8_t antStatus;	 // As MON-HW aStatus
+		uint8_t antPower;	 // As MON-HW aPower
+		uint32_t postStatus;
+		uint8_t reserved1[4];
+		uint16_t noisePerMS;
+		uint16_t agcCnt;	 // 0 - 8191
+		uint8_t jamInd;		 // 0 - 255
+		int8_t ofsI;
+		uint8_t magI;
+		int8_t ofsQ;
+		uint8_t magQ;
+		uint8_t reserved2[3];
+	} blocks[UBX_MON_RF_MAX_BLOCKS];
+};
+
+// Receiver buffer status (MON-RXBUF, 24 bytes). Index 0 is the I2C (DDC) port.
+struct __attribute__((packed)) UBX_MON_RXBUF_data_t
+{
+	uint16_t pending[6];  // Bytes waiting to be processed
+	uint8_t usage[6];	  // Current usage (%)
+	uint8_t peakUsage[6]; // Peak usage (%)
+};
+
+// Transmitter buffer status (MON-TXBUF, 28 bytes). Index 0 is the I2C (DDC) port.
+struct __attribute__((packed)) UBX_MON_TXBUF_data_t
+{
+	uint16_t pending[6];  // Bytes waiting to be read by the host
+	uint8_t usage[6];	  // Current usage (%)
+	uint8_t peakUsage[6]; // Peak usage (%)
+	uint8_t tUsage;		  // Usage of all ports (%)
+	uint8_t tPeakUsage;
+	uint8_t errors;		  // Bits 0-5 limit reached (per port), bit 6 mem, bit 7 alloc (buffer full, output lost)
+	uint8_t reserved1;
+};
+
+struct __attribute__((packed)) UBX_MON_BATCH_data_t
+{
+	uint8_t version;
+	uint8_t reserved1[3];
+	uint16_t fillLevel;		// Epochs waiting in the batch buffer
+	uint16_t dropsAll;		// Epochs dropped since batching was enabled
+	uint16_t dropsSinceMon; // Epochs dropped since the last MON-BATCH
+	uint16_t nextMsgCnt;	// msgCnt of the next LOG-BATCH
+};
+
+struct UbloxBusCounters // I2C activity of checkUbloxI2C, returned by getBusCounters
+{
+	uint32_t transactions; // I2C writes and reads issued (each is one START...STOP or repeated START)
+	uint32_t polls;		   // Number of times the byte count registers were read
+	uint32_t emptyPolls;   // Polls that found no bytes waiting
+	uint32_t pollsSkipped; // Checks answered from the TX-ready pin without using the bus
+};
+
 struct geofenceState // Struct to hold the results returned by getGeofenceState
 {
 	uint8_t status;	// Geofencing status: 0 - Geofencing not available or not reliable; 1 - Geofencing active
@@ -152,6 +434,7 @@ const uint8_t UBX_CFG_DAT = 0x06;		//Set User-defined Datum or The currently def
 const uint8_t UBX_CFG_DGNSS = 0x70;		//DGNSS configuration
 const uint8_t UBX_CFG_GEOFENCE = 0x69;  //Geofencing configuration. Used to configure a geofence
 const uint8_t UBX_CFG_GNSS = 0x3E;		//GNSS system configuration
+const uint8_t UBX_CFG_HNR = 0x5C;		//High Navigation Rate settings (ADR/UDR products)
 const uint8_t UBX_CFG_INF = 0x02;		//Depending on packet length, either: poll configuration for one protocol, or information message configuration
 const uint8_t UBX_CFG_ITFM = 0x39;		//Jamming/Interference Monitor configuration
 const uint8_t UBX_CFG_LOGFILTER = 0x47; //Data Logger Configuration
@@ -217,6 +500,7 @@ const uint8_t UBX_INF_TEST = 0x03;	//ASCII output with test contents
 const uint8_t UBX_INF_WARNING = 0x01; //ASCII output with warning contents
 
 //The following are used to configure LOG UBX messages (loggings messages).  Descriptions from UBX messages overview (ZED_F9P Interface Description Document page 34)
+const uint8_t UBX_LOG_BATCH = 0x11;		   //Batched data (one navigation epoch per message)
 const uint8_t UBX_LOG_CREATE = 0x07;		   //Create Log File
 const uint8_t UBX_LOG_ERASE = 0x03;			   //Erase Logged Data
 const uint8_t UBX_LOG_FINDTIME = 0x0E;		   //Find index of a log entry based on a given time, or response to FINDTIME requested
@@ -225,6 +509,7 @@ const uint8_t UBX_LOG_RETRIEVEPOSEXTRA = 0x0F; //Odometer log entry
 const uint8_t UBX_LOG_RETRIEVEPOS = 0x0B;	  //Position fix log entry
 const uint8_t UBX_LOG_RETRIEVESTRING = 0x0D;   //Byte string log entry
 const uint8_t UBX_LOG_RETRIEVE = 0x09;		   //Request log data
+const uint8_t UBX_LOG_RETRIEVEBATCH = 0x10;	   //Request batch data
 const uint8_t UBX_LOG_STRING = 0x04;		   //Store arbitrary string on on-board flash
 
 //The following are used to configure MGA UBX messages (Multiple GNSS Assistance Messages).  Descriptions from UBX messages overview (ZED_F9P Interface Description Document page 34)
@@ -259,6 +544,7 @@ const uint8_t UBX_MGA_QZSS_ALM = 0x05;		 //QZSS Almanac Assistance
 const uint8_t UBX_MGA_QZAA_HEALTH = 0x05;	//QZSS Health Assistance
 
 //The following are used to configure the MON UBX messages (monitoring messages). Descriptions from UBX messages overview (ZED_F9P Interface Description Document page 35)
+const uint8_t UBX_MON_BATCH = 0x32; //Data batching buffer status
 const uint8_t UBX_MON_COMMS = 0x36; //Comm port information
 const uint8_t UBX_MON_GNSS = 0x28;  //Information message major GNSS selection
 const uint8_t UBX_MON_HW2 = 0x0B;   //Extended Hardware Status
@@ -311,6 +597,11 @@ const uint8_t UBX_RXM_SFRBX = 0x13; //Boradcast Navigation Data Subframe
 //The following are used to configure the SEC UBX messages (security feature messages). Descriptions from UBX messages overview (ZED_F9P Interface Description Document page 36)
 const uint8_t UBX_SEC_UNIQID = 0x03; //Unique chip ID
 
+//The following are used to configure the HNR UBX messages (high rate navigation results)
+const uint8_t UBX_HNR_PVT = 0x00; //High rate output of PVT solution
+const uint8_t UBX_HNR_ATT = 0x01; //Attitude solution
+const uint8_t UBX_HNR_INS = 0x02; //Vehicle dynamics information
+
 //The following are used to configure the TIM UBX messages (timing messages). Descriptions from UBX messages overview (ZED_F9P Interface Description Document page 36)
 const uint8_t UBX_TIM_TM2 = 0x03;  //Time mark data
 const uint8_t UBX_TIM_TP = 0x01;   //Time Pulse Timedata
@@ -360,6 +651,10 @@ const uint8_t VAL_LAYER_RAM = (1 << 0);
 const uint8_t VAL_LAYER_BBR = (1 << 1);
 const uint8_t VAL_LAYER_FLASH = (1 << 2);
 
+//Full 32-bit keys for the settings changed in flight
+const uint32_t UBLOX_CFG_NAVSPG_DYNMODEL = 0x20110021; //U1, DynamicModel_e
+const uint32_t UBLOX_CFG_RATE_MEAS = 0x30210001;		 //U2, ms between measurements
+
 //Below are various Groups, IDs, and sizes for various settings
 //These can be used to call getVal/setVal/delVal
 const uint8_t VAL_GROUP_I2COUTPROT = 0x72;
@@ -379,18 +674,27 @@ class Ublox_GPS
 {
 public:
 	Ublox_GPS(I2C* i2c, uint8_t deviceAddress = 0x42);
+	Ublox_GPS(BufferedSerial* serial); //serial needs to be set to the receiver's UART1 baud rate (9600 by default)
   bool isConnected(); //Returns true if device answers on _gpsI2Caddress address
   bool checkUblox();		//Checks module with user selected commType
 	bool checkUbloxI2C();	//Method for I2C polling of data, passing any new bytes to process()
+	bool checkUbloxSerial(); //Method for serial polling of data, passing any new bytes to process()
 
 	void process(uint8_t incoming);							   //Processes NMEA and UBX binary sentences one byte at a time
+	void process(const uint8_t *data, uint16_t len);		   //Processes a block of bytes, filing UBX payload spans in one pass
 	void processUBX(uint8_t incoming, ubxPacket *incomingUBX); //Given a character, file it away into the uxb packet structure
 	void processRTCMframe(uint8_t incoming);				   //Monitor the incoming bytes for start and length bytes
 	void processUBXpacket(ubxPacket *msg);				   //Once a packet has been received and validated, identify this packet's class/id and update internal flags
 	
   void calcChecksum(ubxPacket *msg);											   //Sets the checksumA and checksumB of a given messages
+  static void fletcherChecksum(const uint8_t *data, uint16_t len, uint8_t &checksumA, uint8_t &checksumB); //Adds a block of bytes to a running 8-bit Fletcher checksum
 	UbloxStatus_e sendCommand(ubxPacket outgoingUBX, uint16_t maxWait = 250); //Given a packet and payload, send everything including CRC bytes, return true if we got a response
+	UbloxStatus_e sendCommand(uint8_t msgClass, uint8_t msgID, const uint8_t *payload, uint16_t len, uint16_t maxWait = 250); //Send straight from a const payload (no copy), checksum computed while sending
 	UbloxStatus_e sendI2cCommand(ubxPacket outgoingUBX, uint16_t maxWait = 250);
+	UbloxStatus_e sendFrame(uint8_t msgClass, uint8_t msgID, const uint8_t *payload, uint16_t len); //Send one frame on the selected port without waiting for an answer
+	UbloxStatus_e sendI2cFrame(uint8_t msgClass, uint8_t msgID, const uint8_t *payload, uint16_t len); //Whole frame in a single I2C write transaction
+	void sendSerialFrame(uint8_t msgClass, uint8_t msgID, const uint8_t *payload, uint16_t len);
+	void sendSerialCommand(ubxPacket outgoingUBX);
 	
   void printPacket(ubxPacket *packet); //Useful for debugging
 
@@ -399,8 +703,23 @@ public:
 
 	bool setI2CAddress(uint8_t deviceAddress, uint16_t maxTime = 250);							  //Changes the I2C address of the Ublox module
 
+	//TX-ready: the receiver drives a PIO when at least thresholdBytes are waiting in its DDC buffer.
+	//With it wired to an mbed pin, checkUbloxI2C only uses the bus when data is waiting and
+	//waitForACKResponse/waitForNoACKResponse sleep until the pin fires instead of polling.
+	bool setTxReady(PinName pin, uint8_t gpsPIO = 6, bool activeLow = false, uint16_t thresholdBytes = 8, uint16_t maxWait = 250); //Configure TX-ready on the DDC port (CFG-PRT) and attach the interrupt
+	bool disableTxReady(uint16_t maxWait = 250); //Turn TX-ready off in the receiver and go back to timed polling
+	bool txReadyAsserted();						 //Returns true if TX-ready is in use and the pin says data is waiting
+	UbloxBusCounters getBusCounters();			 //Returns the I2C activity counters
+	void resetBusCounters();
+
 	bool setNavigationFrequency(uint8_t navFreq, uint16_t maxWait = 250); //Set the number of nav solutions sent per second
-	uint8_t getNavigationFrequency(uint16_t maxWait = 250);					 //Get the number of nav solutions sent per second currently being output by module
+	bool setMeasurementRate(uint16_t measRate, uint16_t maxWait = 250);	  //Set the time between nav solutions in ms (CFG-RATE measRate), including rates slower than 1 Hz
+	bool setHNRNavigationRate(uint8_t rate, uint16_t maxWait = 1100);	  //Set the high rate navigation (HNR-PVT) output rate, 1-30 Hz (ADR/UDR receivers only)
+	std::chrono::milliseconds getI2CpollingWait();						  //Time between I2C polls, shortened by setNavigationFrequency and setHNRNavigationRate
+	void setI2CpollingWait(std::chrono::milliseconds wait);				  //e.g. to put back the wait saved before a temporary rate change
+	bool setTimePulse(uint32_t periodUs = 1000000, uint32_t lengthUs = 100000, bool utc = true, uint16_t maxWait = 1100); //Configure TIMEPULSE (CFG-TP5) to pulse, rising edge on the second, only while locked
+	uint8_t getNavigationFrequency(uint16_t maxWait = 250);					 //Get the number of nav solutions sent per second currently being output by module (0 if no answer or slower than 1 Hz)
+	uint16_t getMeasurementRate(uint16_t maxWait = 250);					 //Get the time between nav solutions in ms (0 if no answer)
 	bool saveConfiguration(uint16_t maxWait = 250);						 //Save current configuration to flash and BBR (battery backed RAM)
 	bool factoryDefault(uint16_t maxWait = 250);							 //Reset module to factory defaults
 
@@ -428,10 +747,13 @@ public:
 	uint8_t getSIV(uint16_t maxWait = getPVTmaxWait);				  //Returns number of sats used in fix
 	uint8_t getFixType(uint16_t maxWait = getPVTmaxWait);			  //Returns the type of fix: 0=no, 3=3D, 4=GNSS+Deadreckoning
 	uint8_t getCarrierSolutionType(uint16_t maxWait = getPVTmaxWait); //Returns RTK solution: 0=no, 1=float solution, 2=fixed solution
+	bool getGnssFixOk(uint16_t maxWait = getPVTmaxWait);			  //Returns the NAV-PVT gnssFixOK flag (fix within the receiver's DOP and accuracy masks)
   int32_t getVerticalVelocity(uint16_t maxWait = getPVTmaxWait); // Return vertical velocity in mm/s (down = positive)
 	int32_t getGroundSpeed(uint16_t maxWait = getPVTmaxWait);		  //Returns speed in mm/s
 	int32_t getHeading(uint16_t maxWait = getPVTmaxWait);			  //Returns heading in degrees * 10^-7
 	uint16_t getPDOP(uint16_t maxWait = getPVTmaxWait);				  //Returns positional dillution of precision * 10^-2
+	uint32_t getHorizontalAccEst(uint16_t maxWait = getPVTmaxWait);	  //Returns the NAV-PVT horizontal accuracy estimate in mm
+	uint32_t getVerticalAccEst(uint16_t maxWait = getPVTmaxWait);	  //Returns the NAV-PVT vertical accuracy estimate in mm
 	uint16_t getYear(uint16_t maxWait = getPVTmaxWait);
 	uint8_t getMonth(uint16_t maxWait = getPVTmaxWait);
 	uint8_t getDay(uint16_t maxWait = getPVTmaxWait);
@@ -456,6 +778,30 @@ public:
 	bool getPortSettings(uint8_t portID, uint16_t maxWait = 250);					//Returns the current protocol bits in the UBX-CFG-PRT command for a given port
 	bool setI2COutput(uint8_t comSettings, uint16_t maxWait = 250);   //Configure I2C port to output UBX, NMEA, RTCM3 or a combination thereof
 
+	//Request pool. Several CFG/poll requests can be in flight at once; each answer (ACK/NAK or
+	//response message) is matched to the oldest pending request with the same cls/id.
+	//Typical use: send a batch with sendRequest, call waitForRequests once, then read each
+	//result with requestStatus/requestPacket and free it with releaseRequest.
+	int8_t sendRequest(uint8_t msgClass, uint8_t msgID, const uint8_t *payload = NULL, uint16_t len = 0); //Returns a token, or -1 if the pool is full or the send failed
+	UbloxStatus_e waitForRequests(uint16_t maxWait = 1100); //Process incoming data until every request is answered. Unanswered ones become UBLOX_STATUS_TIMEOUT.
+	UbloxStatus_e requestStatus(int8_t token);			   //UBLOX_STATUS_PENDING, DATA_SENT (ACK), DATA_RECEIVED, COMMAND_UNKNOWN (NAK) or TIMEOUT
+	ubxPacket *requestPacket(int8_t token);				   //Response to a poll (valid once status is UBLOX_STATUS_DATA_RECEIVED), at most UBX_REQUEST_PAYLOAD_SIZE bytes
+	void releaseRequest(int8_t token);
+	uint8_t pendingRequests();
+
+	//Auto-message registry. The receiver is told to send msgClass/msgID on our port every
+	//sendRate navigation solutions, and each valid message is passed to the callback (or copied
+	//into the storage slot) as it is processed. This happens in whichever thread calls checkUblox.
+	bool subscribe(uint8_t msgClass, uint8_t msgID, Callback<void(const ubxPacket *)> callback, uint8_t sendRate = 1, uint16_t maxWait = 250);
+	template <typename T, typename = typename std::enable_if<!std::is_function<T>::value>::type> //Function pointers go to the callback version
+	bool subscribe(uint8_t msgClass, uint8_t msgID, T *slot, uint8_t sendRate = 1, uint16_t maxWait = 250) //Copy each payload into *slot (e.g. UBX_NAV_DOP_data_t)
+	{
+		return addSubscription(msgClass, msgID, nullptr, (uint8_t *)slot, sizeof(T), sendRate, maxWait);
+	}
+	bool unsubscribe(uint8_t msgClass, uint8_t msgID, uint16_t maxWait = 250); //Stop the message and free its registry entry
+	bool isMessageFresh(uint8_t msgClass, uint8_t msgID);						//Returns true (once) when the storage slot has been updated
+	uint32_t getMessageCount(uint8_t msgClass, uint8_t msgID);					//Number of valid messages received for a subscription
+
 	//Functions to turn on/off message types for a given port ID (see COM_PORT_I2C, etc above)
 	bool configureMessage(uint8_t msgClass, uint8_t msgID, uint8_t portID, uint8_t sendRate, uint16_t maxWait = 250);
 	bool enableMessage(uint8_t msgClass, uint8_t msgID, uint8_t portID, uint8_t sendRate = 1, uint16_t maxWait = 250);
@@ -496,6 +842,33 @@ public:
 	uint8_t getProtocolVersionLow(uint16_t maxWait = 500);  //Returns the PROTVER 00.XX from UBX-MON-VER register
 	bool getProtocolVersion(uint16_t maxWait = 500);		//Queries module, loads low/high bytes
 
+	//Capability probe. probeCapabilities asks the receiver once (MON-VER, then batched polls of the
+	//optional messages) so the answer can be stored, e.g. in FRAM keyed by the chip ID. Handing a stored
+	//copy to setCapabilities lets the driver choose its code paths at boot without any round-trips.
+	bool getUniqueChipId(uint8_t id[UBX_UNIQID_LENGTH], uint16_t maxWait = 1100); //Reads SEC-UNIQID
+	bool probeCapabilities(UbloxCapabilities &caps, uint16_t maxWait = 1100);	   //Fills caps (including the chip ID) from the receiver
+	void setCapabilities(const UbloxCapabilities &caps);						   //Use a stored probe result instead of asking the receiver
+	bool capabilitiesKnown() { return (_capabilitiesKnown); }
+	bool hasCapability(uint16_t messageBit) { return (_capabilitiesKnown && (_capabilities.messages & messageBit)); } //False until probed or set
+	bool supportsValset(uint16_t maxWait = 500);										 //True on protocol 27 and above
+
+	//Receiver-side batching (CFG-BATCH, M8 protocol 23 and above). The receiver buffers one entry per
+	//navigation epoch so the MCU can sleep; retrieveBatch then drains the whole buffer in one go and
+	//hands each LOG-BATCH entry to the callback (in the calling thread), oldest first.
+	//With notifyThreshold and pioId set, the receiver asserts that PIO when the buffer fills to the threshold.
+	bool setBatching(bool enable, uint16_t bufferSize = 128, bool extraPvt = true, uint16_t notifyThreshold = 0, uint8_t pioId = 0, bool pioActiveLow = false, uint16_t maxWait = 1100);
+	bool getBatchStatus(UBX_MON_BATCH_data_t &status, uint16_t maxWait = 1100);						   //Polls MON-BATCH (fill level and drops)
+	int16_t retrieveBatch(Callback<void(const UBX_LOG_BATCH_data_t &)> entry, uint16_t maxWait = 2000); //Returns number of entries received, or -1 if the receiver did not answer
+
+	//Receiver health. MON-HW is answered by M8 and earlier, MON-RF by protocol 27 and above
+	//(see UBX_CAP_MON_HW and UBX_CAP_MON_RF). The jamming state is only reported while the
+	//interference monitor (CFG-ITFM) is enabled.
+	bool getHardwareStatus(UBX_MON_HW_data_t &status, uint16_t maxWait = 1100);	//Polls MON-HW
+	bool getRFStatus(UBX_MON_RF_data_t &status, uint16_t maxWait = 1100);			//Polls MON-RF (blocks beyond UBX_MON_RF_MAX_BLOCKS are dropped)
+	bool getRxBufferStatus(UBX_MON_RXBUF_data_t &status, uint16_t maxWait = 1100); //Polls MON-RXBUF
+	bool getTxBufferStatus(UBX_MON_TXBUF_data_t &status, uint16_t maxWait = 1100); //Polls MON-TXBUF
+	bool setJammingMonitor(bool enable, uint16_t maxWait = 1100);					//Turns the CFG-ITFM interference monitor on or off, keeping its thresholds
+
 	bool getRELPOSNED(uint16_t maxWait = 1100); //Get Relative Positioning Information of the NED frame
 
   //Support for geofences
@@ -509,6 +882,9 @@ public:
 
 	//Change the dynamic platform model using UBX-CFG-NAV5
 	bool setDynamicModel(DynamicModel_e newDynamicModel = DYN_MODEL_PORTABLE, uint16_t maxWait = 1100);
+	//Change the dynamic model and (if measRate is not 0) the measurement period in ms together. On protocol 27
+	//and above this is a single CFG-VALSET; older receivers fall back to CFG-NAV5 and CFG-RATE.
+	bool setNavigationModel(DynamicModel_e newDynamicModel, uint16_t measRate = 0, uint8_t layer = VAL_LAYER_RAM, uint16_t maxWait = 1100);
 
   bool hasHighPrecisionReceiver(uint16_t maxWait = 1100);
 
@@ -568,10 +944,13 @@ public:
 	uint8_t SIV;			 //Number of satellites used in position solution
 	uint8_t fixType;		 //Tells us when we have a solution aka lock
 	uint8_t carrierSolution; //Tells us when we have an RTK float/fixed solution
+	bool gnssFixOk;			 //NAV-PVT flags bit 0
   int32_t verticalVelocity; // mm/s (with positive downward)
 	int32_t groundSpeed;	 //mm/s
 	int32_t headingOfMotion; //degrees * 10^-5
 	uint16_t pDOP;			 //Positional dilution of precision
+	uint32_t horizontalAccEst; //mm, from NAV-PVT
+	uint32_t verticalAccEst;	 //mm, from NAV-PVT
 	uint8_t versionLow;		 //Loaded from getProtocolVersion().
 	uint8_t versionHigh;
   bool highPrecisionReceiver; // Loaded from getProtocolVersion()
@@ -595,18 +974,21 @@ public:
 
   void setNMEAOutputPort(BufferedSerial &nmeaOutputPort);	//Sets the internal variable for the port to direct NMEA characters to
 
+	//GGA, RMC, VTG and GSA sentences are parsed as they arrive and update the same fields as NAV-PVT,
+	//so the getters keep working if the receiver only outputs NMEA (call checkUblox() first).
+	const NMEAFix &getNMEAFix() { return (_nmea.fix()); }
+	uint32_t getNMEASentences() { return (_nmea.sentences()); }
+	uint32_t getNMEAChecksumErrors() { return (_nmea.checksum_errors()); }
+
 	const char *statusString(UbloxStatus_e stat); //Pretty print the return value
 
 
+  bool setSerialRate(uint32_t baudrate, uint8_t uartPort = COM_PORT_UART1, uint16_t maxWait = 250); //Changes the serial baud rate of the Ublox module (and ours), uartPort should be COM_PORT_UART1/2
+  bool setUART1Output(uint8_t comSettings, uint16_t maxWait = 250); //Configure UART1 port to output UBX, NMEA, RTCM3 or a combination thereof
+	bool setUART2Output(uint8_t comSettings, uint16_t maxWait = 250); //Configure UART2 port to output UBX, NMEA, RTCM3 or a combination thereof
+
   // Arduino specific, needs translation
   /*
-	//serialPort needs to be perviously initialized to correct baud rate
-	boolean begin(Stream &serialPort); //Returns true if module is detected
-  boolean checkUbloxSerial(); //Method for serial polling of data, passing any new bytes to process()
-  void sendSerialCommand(ubxPacket outgoingUBX);
-  void setSerialRate(uint32_t baudrate, uint8_t uartPort = COM_PORT_UART1, uint16_t maxTime = 250); //Changes the serial baud rate of the Ublox module, uartPort should be COM_PORT_UART1/2
-  boolean setUART1Output(uint8_t comSettings, uint16_t maxWait = 250); //Configure UART1 port to output UBX, NMEA, RTCM3 or a combination thereof
-	boolean setUART2Output(uint8_t comSettings, uint16_t maxWait = 250); //Configure UART2 port to output UBX, NMEA, RTCM3 or a combination thereof
 	boolean setUSBOutput(uint8_t comSettings, uint16_t maxWait = 250);   //Configure USB port to output UBX, NMEA, RTCM3 or a combination thereof
 	boolean setSPIOutput(uint8_t comSettings, uint16_t maxWait = 250);   //Configure SPI port to output UBX, NMEA, RTCM3 or a combination thereof
   */
@@ -616,7 +998,7 @@ public:
   void processRTCM(uint8_t incoming) __attribute__((weak));  //Given rtcm byte, do something with it. User can overwrite if desired to pipe bytes to radio, internet, etc.
   void processNMEA(char incoming) __attribute__((weak)); //Given a NMEA character, do something with it. User can overwrite if desired to use something like tinyGPS or MicroNMEA libraries
   */
-  void processNMEA(char incoming); // Non-weak version
+  void processNMEA(char incoming); // Non-weak version (echoes to the NMEA port and feeds the NMEA parser)
   void processRTCM(uint8_t incoming); // Non-weak version
 
 
@@ -635,8 +1017,10 @@ private:
 	{
 		CLASS_NONE = 0,
 		CLASS_ACK,
-		CLASS_NOT_AN_ACK
+		CLASS_NOT_AN_ACK,
+		CLASS_SUBSCRIBED
 	} ubxFrameClass = CLASS_NONE;
+	uint8_t ubxFrameClassByte; //Class of a non-ACK frame, held until the ID shows which packet it goes to
 
 	enum commTypes
 	{
@@ -650,11 +1034,31 @@ private:
 	uint16_t extractInt(uint8_t spotToStart);  //Combine two bytes from payload into int
 	uint8_t extractByte(uint8_t spotToStart);  //Get byte from payload
 	void addToChecksum(uint8_t incoming);	  //Given an incoming byte, adjust rollingChecksumA/B
+	bool addSubscription(uint8_t msgClass, uint8_t msgID, Callback<void(const ubxPacket *)> callback, uint8_t *storage, uint16_t storageSize, uint8_t sendRate, uint16_t maxWait);
+	ubxSubscription *registerMessage(uint8_t msgClass, uint8_t msgID, Callback<void(const ubxPacket *)> callback, uint8_t *storage, uint16_t storageSize); //Registry entry only, nothing sent to the receiver
+	void batchEntryReceived(const ubxPacket *msg); //LOG-BATCH callback used by retrieveBatch
+	bool pollMonitor(uint8_t id, uint8_t *data, uint16_t size, uint16_t minLen, uint16_t maxWait); //Polls a MON message into data
+	ubxSubscription *findSubscription(uint8_t msgClass, uint8_t msgID);
+	ubxRequest *findRequest(uint8_t msgClass, uint8_t msgID, bool ack); //Oldest pending request waiting for an ACK/NAK (ack = true) or data from msgClass/msgID
+	static bool isConfigPoll(uint8_t msgID, uint16_t len); //CFG message that is answered with data as well as an ACK
+	void matchRequest(ubxPacket *msg);								   //Give a received packet to the request it answers
+	void dataReadyISR();					  //TX-ready pin went active or serial data arrived
+	void waitForData(std::chrono::microseconds timeout); //Sleep until more data may be waiting (TX-ready or serial interrupt, or 500us)
+	void addToChecksum(const uint8_t *data, uint16_t len); //Given a block of bytes, adjust rollingChecksumA/B
+	uint16_t processUBXpayload(const uint8_t *data, uint16_t len, ubxPacket *incomingUBX); //File a span of payload bytes into the packet, returns number of bytes used
+	uint16_t payloadSize(const ubxPacket *packet); //Size of the payload array behind packetAck, packetCfg or packetSub
+	bool isSubscribedFrame(uint8_t msgClass, uint8_t msgID); //Frame goes to packetSub rather than packetCfg
 
 	//Variables
-	I2C* _i2c;				//The generic connection to user's chosen I2C hardware
+	I2C* _i2c = NULL;				//The generic connection to user's chosen I2C hardware
+	BufferedSerial* _serialPort = NULL; //The UART connection when using COMM_TYPE_SERIAL
   Timer _pollingTimer; // Timer for polling delays
 
+	InterruptIn* _txReadyPin = NULL; //Receiver TX-ready output, NULL when polling
+	bool _txReadyActiveLow = false;
+	Semaphore _dataReady{0, 1};		 //Released by dataReadyISR
+	UbloxBusCounters _busCounters = {0, 0, 0, 0};
+
 	uint8_t _gpsI2Caddress = 0x42; //Default 7-bit unshifted address of the ublox 6/7/8/M8/F9 series
 	//This can be changed using the ublox configuration software
 
@@ -664,9 +1068,12 @@ private:
 	uint8_t payloadAck[2];
 	uint8_t payloadCfg[MAX_PAYLOAD_SIZE];
 
+	uint8_t payloadSub[UBX_SUBSCRIPTION_PAYLOAD_SIZE]; //Subscribed messages, so they never overwrite a command or poll answer in payloadCfg
+
 	//Init the packet structures and init them with pointers to the payloadAck and payloadCfg arrays
 	ubxPacket packetAck = {0, 0, 0, 0, 0, payloadAck, 0, 0, false};
 	ubxPacket packetCfg = {0, 0, 0, 0, 0, payloadCfg, 0, 0, false};
+	ubxPacket packetSub = {0, 0, 0, 0, 0, payloadSub, 0, 0, false};
 
 	//Limit checking of new data to every X ms
 	//If we are expecting an update every X Hz then we should check every half that amount of time
@@ -677,6 +1084,15 @@ private:
 	bool autoPVT = false;			  //Whether autoPVT is enabled or not
 	bool autoPVTImplicitUpdate = true; // Whether autoPVT is triggered by accessing stale data (=true) or by a call to checkUblox (=false)
 	uint8_t commandAck = UBX_ACK_NONE;	//This goes to UBX_ACK_ACK after we send a command and it's ack'd
+	ubxSubscription subscriptions[UBX_MAX_SUBSCRIPTIONS] = {};
+	ubxRequest requests[UBX_REQUEST_POOL_SIZE] = {};
+	uint8_t requestPayload[UBX_REQUEST_POOL_SIZE][UBX_REQUEST_PAYLOAD_SIZE];
+	uint32_t requestSequence = 0;
+	UbloxCapabilities _capabilities = {};
+	bool _capabilitiesKnown = false;
+	Callback<void(const UBX_LOG_BATCH_data_t &)> _batchCallback;
+	uint16_t _batchReceived = 0;
+	bool ubxFrameAsync = false; //Frame being received is NAV-PVT, subscribed or a pool response, so it is stored from payload byte 0
 	uint16_t ubxFrameCounter;			  //It counts all UBX frame. [Fixed header(2bytes), CLS(1byte), ID(1byte), length(2bytes), payload(x bytes), checksums(2bytes)]
 
 	uint8_t rollingChecksumA; //Rolls forward as we receive incoming bytes. Checked against the last two A/B checksum bytes
@@ -705,10 +1121,13 @@ private:
 		uint32_t SIV : 1;
 		uint32_t fixType : 1;
 		uint32_t carrierSolution : 1;
+		uint32_t gnssFixOk : 1;
     uint32_t verticalVelocity : 1;
 		uint32_t groundSpeed : 1;
 		uint32_t headingOfMotion : 1;
 		uint32_t pDOP : 1;
+		uint32_t horizontalAccEst : 1;
+		uint32_t verticalAccEst : 1;
 		uint32_t versionNumber : 1;
 	} moduleQueried;
 
@@ -727,6 +1146,9 @@ private:
 
 	uint16_t rtcmLen = 0;
 
+	NMEAParser _nmea;
+	void processNMEAsentence(uint8_t sentence); //Copy a parsed NMEA sentence into the NAV-PVT fields
+
   BufferedSerial *_nmeaOutputPort = NULL; //The user can assign an output port to print NMEA sentences if they wish
 
   // Arduino specific, needs translation
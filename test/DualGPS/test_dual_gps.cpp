@@ -0,0 +1,114 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+#include "DualGPS.h"
+
+/* Two receivers with failover and blending.
+ * The selection tests need no hardware. The last test needs receivers at
+ * 0x42 and 0x43 on the I2C bus; it checks that both deliver fixes and
+ * prints how long one update takes as a bench line.
+ */
+
+I2C i2c(p9,p10);
+Ublox_GPS gps1(&i2c, 0x42);
+Ublox_GPS gps2(&i2c, 0x43);
+DualGPS dual(&gps1, &gps2);
+
+GPSReceiverState make_state(int32_t latitude, int32_t altitude, uint32_t hAcc, uint32_t vAcc, uint8_t SIV) {
+  GPSReceiverState s;
+  s.fix = {true, SIV, 1623508200, latitude, -1174172000, altitude, -5000, 7200, 9000000};
+  s.fixType = 3;
+  s.pDOP = 150;
+  s.hAcc = hAcc;
+  s.vAcc = vAcc;
+  s.fresh = true;
+  return s;
+}
+
+void test_failover() {
+  GPSFix fix;
+  GPSReceiverState a = make_state(477543000, 25600000, 3000, 5000, 10);
+  GPSReceiverState b = make_state(477543020, 25600500, 3000, 5000, 10);
+
+  a.fresh = false;            // primary stopped answering
+  TEST_ASSERT_EQUAL(DGPS_SECONDARY, DualGPS::choose(a, b, true, fix));
+  TEST_ASSERT_EQUAL(477543020, fix.latitude);
+
+  a.fresh = true;
+  b.fix.SIV = 3;              // too few satellites
+  TEST_ASSERT_EQUAL(DGPS_PRIMARY, DualGPS::choose(a, b, true, fix));
+  TEST_ASSERT_EQUAL(477543000, fix.latitude);
+
+  b.fix.SIV = 10;
+  a.fix.positionFix = false;  // 2D or no fix
+  TEST_ASSERT_EQUAL(DGPS_SECONDARY, DualGPS::choose(a, b, true, fix));
+
+  b.fresh = false;
+  TEST_ASSERT_EQUAL(DGPS_NO_FIX, DualGPS::choose(a, b, true, fix));
+  TEST_ASSERT_FALSE(fix.positionFix);
+}
+
+void test_selection() {
+  GPSFix fix;
+  GPSReceiverState a = make_state(477543000, 25600000, 3000, 5000, 10);
+  GPSReceiverState b = make_state(477543020, 25600500, 2000, 5000, 10);
+  TEST_ASSERT_EQUAL(DGPS_SECONDARY, DualGPS::choose(a, b, false, fix));
+  b.hAcc = 3000;
+  b.fix.SIV = 12;
+  TEST_ASSERT_EQUAL(DGPS_SECONDARY, DualGPS::choose(a, b, false, fix));
+  b.fix.SIV = 10;
+  TEST_ASSERT_EQUAL(DGPS_PRIMARY, DualGPS::choose(a, b, false, fix));
+}
+
+void test_blending() {
+  GPSFix fix;
+  GPSReceiverState a = make_state(477543000, 25600000, 3000, 6000, 10);
+  GPSReceiverState b = make_state(477543100, 25601000, 3000, 2000, 9);
+
+  // Equal hAcc splits the latitude evenly; vAcc 6 m vs 2 m weights altitude 9:1 toward b
+  TEST_ASSERT_EQUAL(DGPS_BLENDED, DualGPS::choose(a, b, true, fix));
+  TEST_ASSERT_EQUAL(477543050, fix.latitude);
+  TEST_ASSERT_EQUAL(-1174172000, fix.longitude);
+  TEST_ASSERT_EQUAL(25600900, fix.altitudeMSL);
+
+  // 100 m apart with 3 m accuracies: they disagree, so the better one is used alone
+  b.fix.latitude = 477552000;
+  TEST_ASSERT_EQUAL(DGPS_PRIMARY, DualGPS::choose(a, b, true, fix));
+  TEST_ASSERT_EQUAL(477543000, fix.latitude);
+}
+
+void test_two_receivers() {
+  if (!gps1.isConnected() || !gps2.isConnected())
+    TEST_IGNORE_MESSAGE("Two GPS receivers not present");
+  TEST_ASSERT_EQUAL(2, dual.begin());
+  ThisThread::sleep_for(2s);
+
+  GPSFix fix;
+  Timer t;
+  t.start();
+  int source = dual.update(fix);
+  t.stop();
+  GPSReceiverState s1, s2;
+  dual.receiver(0, s1);
+  dual.receiver(1, s2);
+  TEST_ASSERT_TRUE(s1.fresh);
+  TEST_ASSERT_TRUE(s2.fresh);
+  if (s1.fix.positionFix || s2.fix.positionFix)
+    TEST_ASSERT_TRUE(source != DGPS_NO_FIX);
+  unsigned long us = (unsigned long)t.elapsed_time().count();
+  printf("bench,dual_gps_update_us,1,%lu,%lu\n", us, us);
+
+  gps1.setAutoPVT(false);
+  gps2.setAutoPVT(false);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_failover);
+  RUN_TEST(test_selection);
+  RUN_TEST(test_blending);
+  RUN_TEST(test_two_receivers);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,82 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include <math.h>
+#include "ublox.h"
+#include "SBDmessage.h"
+#include "DynamicsRecorder.h"
+
+/* High rate navigation (HNR) recorder.
+ * The burst test replays a synthetic 30 Hz HNR-PVT sequence (5 m/s climb,
+ * burst, free fall to 30 m/s) and needs no hardware. The live test needs an
+ * ADR/UDR receiver with HNR-PVT on the I2C bus.
+ */
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+DynamicsRecorder recorder(&gps);
+
+void test_hnr_layout() {
+  TEST_ASSERT_EQUAL(72, sizeof(UBX_HNR_PVT_data_t));
+}
+
+void test_burst_summary() {
+  UBX_HNR_PVT_data_t pvt;
+  memset(&pvt, 0, sizeof(pvt));
+  pvt.flags = 0x01;
+  pvt.gSpeed = 3000;
+  pvt.headMot = 9000000;
+  recorder.take_summary();
+  float h = 30000000, velD = -5000;   // mm, mm/s (positive down)
+  for (int i = 0; i < 300; i++) {
+    if ((i > 150) && (velD < 30000)) velD += 9806.0f / 30;
+    h -= velD / 30;
+    pvt.iTOW = 100000 + (i * 1000 + 15) / 30;
+    pvt.hMSL = (int32_t)h;
+    pvt.speed = (int32_t)sqrtf(3000.0f * 3000 + velD * velD);
+    recorder.add(pvt);
+  }
+  DynamicsSummary summary = recorder.take_summary();
+  TEST_ASSERT_EQUAL(300, summary.samples);
+  TEST_ASSERT_INT_WITHIN(1000, 9806, summary.peakAcceleration);
+  TEST_ASSERT_INT_WITHIN(500, 30000, summary.maxDescentRate);
+  TEST_ASSERT_EQUAL(DYN_RING_SIZE, recorder.count());
+  DynamicsSample s;
+  TEST_ASSERT_TRUE(recorder.get(0, s));
+  TEST_ASSERT_TRUE(s.velD > 2900);
+
+  // A new summary starts after each take
+  TEST_ASSERT_EQUAL(0, recorder.take_summary().samples);
+
+  SBDmessage msg;
+  msg.generateDynamicsBytes(summary);
+  TEST_ASSERT_EQUAL(summary.peakAcceleration / 100, ((uint8_t)msg.getByte(28) << 8) | (uint8_t)msg.getByte(29));
+  TEST_ASSERT_EQUAL(summary.maxDescentRate / 100, ((uint8_t)msg.getByte(30) << 8) | (uint8_t)msg.getByte(31));
+}
+
+void test_live_hnr() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  std::chrono::milliseconds wait = gps.getI2CpollingWait();
+  if (!recorder.start(30))
+    TEST_IGNORE_MESSAGE("Receiver does not support HNR-PVT");
+  recorder.take_summary();
+  Timer t;
+  t.start();
+  while (t.elapsed_time() < 2s)
+    gps.checkUblox();
+  TEST_ASSERT_TRUE(recorder.stop());
+  TEST_ASSERT_EQUAL(wait.count(), gps.getI2CpollingWait().count());
+  DynamicsSummary summary = recorder.take_summary();
+  printf("bench,hnr_solutions_2s,1,%d,%d\n", summary.samples, summary.samples);
+  TEST_ASSERT_TRUE(summary.samples >= 50);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_hnr_layout);
+  RUN_TEST(test_burst_summary);
+  RUN_TEST(test_live_hnr);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,133 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+#include "FixHistory.h"
+
+/* Receiver-side batching (CFG-BATCH) and the fix history.
+ * The first two tests need no hardware. The drain test needs an M8 receiver
+ * (protocol 23 or later) on the I2C bus: it batches at 4 Hz for 5 s while
+ * the MCU sleeps, then drains everything in one retrieveBatch call and
+ * prints the bus transactions used as a bench line.
+ */
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+FixHistory history;
+
+UBX_LOG_BATCH_data_t make_entry(uint16_t msgCnt) {
+  UBX_LOG_BATCH_data_t entry;
+  memset(&entry, 0, sizeof(entry));
+  entry.contentValid = 0x01;
+  entry.msgCnt = msgCnt;
+  entry.year = 2021;
+  entry.month = 6;
+  entry.day = 12;
+  entry.hour = 14;
+  entry.min = 30;
+  entry.sec = msgCnt % 60;
+  entry.valid = 0x03;
+  entry.fixType = 3;
+  entry.flags = 0x01;
+  entry.numSV = 11;
+  entry.lat = 477543000;
+  entry.lon = -1174172000;
+  entry.hMSL = 25600000 + msgCnt;
+  entry.velD = -5000;
+  entry.gSpeed = 7200;
+  entry.headMot = 9000000;
+  return entry;
+}
+
+void test_batch_layout() {
+  TEST_ASSERT_EQUAL(100, sizeof(UBX_LOG_BATCH_data_t));
+  TEST_ASSERT_EQUAL(12, sizeof(UBX_MON_BATCH_data_t));
+}
+
+void test_from_batch() {
+  GPSFix fix;
+  UBX_LOG_BATCH_data_t entry = make_entry(0);
+  FixHistory::from_batch(entry, fix);
+  TEST_ASSERT_TRUE(fix.positionFix);
+  TEST_ASSERT_EQUAL(11, fix.SIV);
+  TEST_ASSERT_EQUAL(1623508200, fix.syncTime);  // 2021-06-12 14:30:00 UTC
+  TEST_ASSERT_EQUAL(477543000, fix.latitude);
+  TEST_ASSERT_EQUAL(-1174172000, fix.longitude);
+  TEST_ASSERT_EQUAL(25600000, fix.altitudeMSL);
+  TEST_ASSERT_EQUAL(-5000, fix.verticalVelocity);
+
+  entry.fixType = 2;        // 2D, no usable altitude
+  FixHistory::from_batch(entry, fix);
+  TEST_ASSERT_FALSE(fix.positionFix);
+  entry.fixType = 4;        // GNSS + dead reckoning
+  FixHistory::from_batch(entry, fix);
+  TEST_ASSERT_TRUE(fix.positionFix);
+  entry.flags = 0;          // gnssFixOK clear
+  FixHistory::from_batch(entry, fix);
+  TEST_ASSERT_FALSE(fix.positionFix);
+  entry.valid = 0x01;       // time not valid
+  FixHistory::from_batch(entry, fix);
+  TEST_ASSERT_EQUAL(0, fix.syncTime);
+}
+
+void test_history_ring() {
+  GPSFix fix;
+  history.clear();
+  TEST_ASSERT_FALSE(history.get(0, fix));
+  for (int i = 0; i < FIX_HISTORY_SIZE + 5; i++)
+    history.add_batch_entry(make_entry(i));
+  TEST_ASSERT_EQUAL(FIX_HISTORY_SIZE, history.count());
+  TEST_ASSERT_EQUAL(FIX_HISTORY_SIZE + 5, history.total());
+  TEST_ASSERT_TRUE(history.get(0, fix));
+  TEST_ASSERT_EQUAL(25600000 + FIX_HISTORY_SIZE + 4, fix.altitudeMSL);
+  TEST_ASSERT_TRUE(history.get(FIX_HISTORY_SIZE - 1, fix));
+  TEST_ASSERT_EQUAL(25600000 + 5, fix.altitudeMSL);
+  TEST_ASSERT_FALSE(history.get(FIX_HISTORY_SIZE, fix));
+}
+
+void test_drain_batch() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  if (gps.getProtocolVersionHigh() < 23)
+    TEST_IGNORE_MESSAGE("Receiver does not support batching");
+  gps.setNavigationFrequency(4);
+  TEST_ASSERT_TRUE(gps.setBatching(true, 32));
+  history.clear();
+  ThisThread::sleep_for(5s);
+
+  UBX_MON_BATCH_data_t status;
+  TEST_ASSERT_TRUE(gps.getBatchStatus(status));
+  TEST_ASSERT_TRUE(status.fillLevel >= 15);
+
+  // The drain borrows the MON-BATCH registry entry and must give it back
+  UBX_MON_BATCH_data_t monitor;
+  TEST_ASSERT_TRUE(gps.subscribe(UBX_CLASS_MON, UBX_MON_BATCH, &monitor, 0));
+
+  gps.resetBusCounters();
+  int n = history.drain(&gps);
+  UbloxBusCounters bus = gps.getBusCounters();
+  TEST_ASSERT_TRUE(gps.unsubscribe(UBX_CLASS_MON, UBX_MON_BATCH));
+  TEST_ASSERT_TRUE(n >= status.fillLevel);
+  TEST_ASSERT_EQUAL(n < FIX_HISTORY_SIZE ? n : FIX_HISTORY_SIZE, history.count());
+
+  // Entries come oldest first, so the newest fix has the latest time
+  GPSFix newest, older;
+  TEST_ASSERT_TRUE(history.get(0, newest));
+  TEST_ASSERT_TRUE(history.get(1, older));
+  TEST_ASSERT_TRUE(newest.syncTime >= older.syncTime);
+
+  TEST_ASSERT_TRUE(gps.setBatching(false));
+  gps.setNavigationFrequency(1);
+  printf("bench,ubx_batch_drain_transactions,%d,%lu,%lu\n", n, (unsigned long)bus.transactions,
+    (unsigned long)(n > 0 ? bus.transactions / n : 0));
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_batch_layout);
+  RUN_TEST(test_from_batch);
+  RUN_TEST(test_history_ring);
+  RUN_TEST(test_drain_batch);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
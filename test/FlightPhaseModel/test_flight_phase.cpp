@@ -0,0 +1,145 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+#include "FlightPhaseModel.h"
+
+/* Dynamic model switching by flight phase.
+ * The simulated flight needs no hardware: a FlightPhaseModel without a
+ * receiver is fed a pad wait, ascent, burst, descent and landing, with the
+ * accuracy estimates improving after each switch. The last test needs a
+ * receiver and times the combined model and rate change.
+ */
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+
+int reportsReceived;
+
+void report_received(FlightPhase phase, const ModelSwitchReport &r) {
+  reportsReceived++;
+}
+
+GPSFix make_fix(time_t t, int32_t altitude, int32_t velD, int32_t gSpeed) {
+  GPSFix fix;
+  fix.positionFix = true;
+  fix.SIV = 10;
+  fix.syncTime = t;
+  fix.latitude = 477543000;
+  fix.longitude = -1174172000;
+  fix.altitudeMSL = altitude;
+  fix.verticalVelocity = velD;
+  fix.groundSpeed = gSpeed;
+  fix.heading = 0;
+  return fix;
+}
+
+void test_default_models() {
+  TEST_ASSERT_EQUAL(DYN_MODEL_STATIONARY, FlightPhaseModel::default_model(FPM_PHASE_PAD));
+  TEST_ASSERT_EQUAL(DYN_MODEL_AIRBORNE1g, FlightPhaseModel::default_model(FPM_PHASE_ASCENT));
+  TEST_ASSERT_EQUAL(DYN_MODEL_AIRBORNE4g, FlightPhaseModel::default_model(FPM_PHASE_BURST));
+  TEST_ASSERT_EQUAL(DYN_MODEL_PORTABLE, FlightPhaseModel::default_model(FPM_PHASE_LANDED));
+}
+
+void test_simulated_flight() {
+  FlightPhaseModel phases(NULL);
+  ModelSwitchReport r;
+  time_t t = 1623508200;
+  int32_t h = 600000;
+  reportsReceived = 0;
+  phases.attach(report_received);
+  TEST_ASSERT_TRUE(phases.begin());
+
+  // 20 s on the pad, including one noisy fix
+  for (int i = 0; i < 20; i++, t++)
+    TEST_ASSERT_FALSE(phases.update(make_fix(t, h + (i == 10 ? 40000 : 0), 0, 0), 2000, 4000));
+  TEST_ASSERT_EQUAL(FPM_PHASE_PAD, phases.phase());
+
+  // Ascent at 5 m/s until 30 km
+  int changedAt = -1;
+  for (int i = 0; h < 30000000; i++, t++) {
+    h += 5000;
+    if (phases.update(make_fix(t, h, -5000, 3000), 2500, 5000) && changedAt < 0) changedAt = i;
+  }
+  TEST_ASSERT_EQUAL(FPM_PHASE_ASCENT, phases.phase());
+  TEST_ASSERT_TRUE(changedAt >= FPM_CONFIRM_FIXES - 1);
+  TEST_ASSERT_TRUE(changedAt < 10);
+  TEST_ASSERT_TRUE(phases.report(FPM_PHASE_ASCENT, r));
+  TEST_ASSERT_TRUE(r.complete);
+  TEST_ASSERT_EQUAL(DYN_MODEL_AIRBORNE1g, r.model);
+  TEST_ASSERT_TRUE(r.hAccBefore >= 2000);
+  TEST_ASSERT_EQUAL(2500, r.hAccAfter);
+  TEST_ASSERT_EQUAL(5000, r.vAccAfter);
+
+  // Burst: 30 m/s descent
+  for (int i = 0; i < FPM_CONFIRM_FIXES; i++, t++) {
+    h -= 30000;
+    phases.update(make_fix(t, h, 30000, 8000), 4000, 9000);
+  }
+  TEST_ASSERT_EQUAL(FPM_PHASE_BURST, phases.phase());
+  for (int i = 0; i < FPM_QUALITY_WINDOW; i++, t++) {
+    h -= 25000;
+    phases.update(make_fix(t, h, 25000, 8000), 3000, 4000);
+  }
+  TEST_ASSERT_TRUE(phases.report(FPM_PHASE_BURST, r));
+  TEST_ASSERT_TRUE(r.complete);
+  // The window before the switch still holds the last of the ascent
+  TEST_ASSERT_EQUAL(((FPM_QUALITY_WINDOW - FPM_CONFIRM_FIXES) * 5000 + FPM_CONFIRM_FIXES * 9000) / FPM_QUALITY_WINDOW, r.vAccBefore);
+  TEST_ASSERT_EQUAL(4000, r.vAccAfter);
+
+  // Burst model is held for FPM_BURST_HOLD s, then descent under canopy
+  while (phases.phase() == FPM_PHASE_BURST) {
+    h -= 10000;
+    phases.update(make_fix(t++, h, 10000, 5000), 3000, 6000);
+  }
+  TEST_ASSERT_EQUAL(FPM_PHASE_DESCENT, phases.phase());
+  while (h > 700000) {
+    h -= 6000;
+    phases.update(make_fix(t++, h, 6000, 4000), 3000, 6000);
+  }
+  TEST_ASSERT_EQUAL(FPM_PHASE_DESCENT, phases.phase());
+
+  // On the ground
+  for (int i = 0; i < FPM_LANDED_FIXES; i++, t++)
+    phases.update(make_fix(t, h, 100, 200), 2000, 3000);
+  TEST_ASSERT_EQUAL(FPM_PHASE_LANDED, phases.phase());
+  for (int i = 0; i < FPM_QUALITY_WINDOW; i++, t++)
+    phases.update(make_fix(t, h, 0, 0), 1500, 2500);
+  TEST_ASSERT_TRUE(phases.report(FPM_PHASE_LANDED, r));
+  TEST_ASSERT_EQUAL(DYN_MODEL_PORTABLE, r.model);
+  TEST_ASSERT_TRUE(r.vAccAfter < r.vAccBefore);
+  TEST_ASSERT_EQUAL(4, reportsReceived);
+}
+
+void test_forced_phase() {
+  FlightPhaseModel phases(NULL);
+  ModelSwitchReport r;
+  phases.begin();
+  TEST_ASSERT_FALSE(phases.report(FPM_PHASE_LANDED, r));
+  TEST_ASSERT_TRUE(phases.set_phase(FPM_PHASE_LANDED));
+  TEST_ASSERT_EQUAL(FPM_PHASE_LANDED, phases.phase());
+  TEST_ASSERT_TRUE(phases.report(FPM_PHASE_LANDED, r));
+  TEST_ASSERT_FALSE(r.complete);
+}
+
+void test_switch_on_receiver() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  Timer t;
+  t.start();
+  TEST_ASSERT_TRUE(gps.setNavigationModel(DYN_MODEL_AIRBORNE4g, 250));
+  t.stop();
+  TEST_ASSERT_TRUE(gps.setNavigationModel(DYN_MODEL_PORTABLE, 1000));
+  unsigned long us = (unsigned long)t.elapsed_time().count();
+  printf("bench,ubx_phase_switch_us,1,%lu,%lu\n", us, us);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_default_models);
+  RUN_TEST(test_simulated_flight);
+  RUN_TEST(test_forced_phase);
+  RUN_TEST(test_switch_on_receiver);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,80 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+#include "cypress_fm24w256.h"
+#include "GPSCapabilityCache.h"
+
+/* Capability probe and FRAM cache. Needs the receiver and the FRAM on the
+ * I2C bus. The cache region is formatted, so the first load() probes the
+ * receiver and the second one must come from FRAM. Both times are printed as
+ * bench lines (microseconds).
+ */
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+Cypress_FRAM fram(&i2c,0);
+GPSCapabilityCache cache(&fram, &gps);
+
+void test_unique_chip_id() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  uint8_t id[UBX_UNIQID_LENGTH];
+  uint8_t again[UBX_UNIQID_LENGTH];
+  TEST_ASSERT_TRUE(gps.getUniqueChipId(id));
+  TEST_ASSERT_TRUE(gps.getUniqueChipId(again));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(id, again, UBX_UNIQID_LENGTH);
+}
+
+void test_probe_then_cached() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  if (cache.format() != FRAM_SUCCESS)
+    TEST_IGNORE_MESSAGE("FRAM not present");
+  TEST_ASSERT_EQUAL(GPSC_SUCCESS, cache.begin());
+  Timer t;
+
+  t.start();
+  TEST_ASSERT_EQUAL(GPSC_SUCCESS, cache.load());
+  t.stop();
+  long probeUs = t.elapsed_time().count();
+  TEST_ASSERT_FALSE(cache.cached());
+  uint8_t protocol = gps.versionHigh;
+  bool highPrecision = gps.highPrecisionReceiver;
+  TEST_ASSERT_TRUE(protocol > 0);
+  TEST_ASSERT_TRUE(gps.hasCapability(UBX_CAP_MON_HW)); // MON-HW is answered by every supported receiver
+
+  gps.versionHigh = 0;
+  t.reset();
+  t.start();
+  TEST_ASSERT_EQUAL(GPSC_SUCCESS, cache.load());
+  t.stop();
+  long cachedUs = t.elapsed_time().count();
+  TEST_ASSERT_TRUE(cache.cached());
+  TEST_ASSERT_EQUAL_UINT8(protocol, gps.versionHigh);
+  TEST_ASSERT_EQUAL(highPrecision, gps.hasHighPrecisionReceiver());
+  TEST_ASSERT_EQUAL(protocol >= 27, gps.supportsValset());
+  TEST_ASSERT_TRUE(cachedUs < probeUs);
+
+  printf("bench,gps_capabilities_probe_us,1,%ld,%ld\n", probeUs, probeUs);
+  printf("bench,gps_capabilities_cached_us,1,%ld,%ld\n", cachedUs, cachedUs);
+}
+
+void test_forget() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  if (!cache.cached())
+    TEST_IGNORE_MESSAGE("Nothing cached");
+  TEST_ASSERT_EQUAL(FRAM_SUCCESS, cache.forget());
+  TEST_ASSERT_EQUAL(GPSC_SUCCESS, cache.load());
+  TEST_ASSERT_FALSE(cache.cached());
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_unique_chip_id);
+  RUN_TEST(test_probe_then_cached);
+  RUN_TEST(test_forget);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
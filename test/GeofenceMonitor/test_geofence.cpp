@@ -0,0 +1,216 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+#include "GeofenceMonitor.h"
+
+/* Receiver geofences.
+ * The first four tests feed synthetic NAV-GEOFENCE reports. The last two
+ * program a fence around the receiver's own position (need a GPS fix) and
+ * check that the receiver reports being inside it. The PIO test also needs
+ * TEST_PIO_DRIVE jumpered to TEST_PIO_PIN, standing in for the receiver's PIO.
+ */
+
+#define TEST_PIO_PIN p23
+#define TEST_PIO_DRIVE p22
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+
+const int32_t launchLat = 477543000;
+const int32_t launchLon = -1174172000;
+
+UBX_NAV_GEOFENCE_data_t make_report(uint8_t status, uint8_t fence0, uint8_t fence1) {
+  UBX_NAV_GEOFENCE_data_t r;
+  memset(&r, 0, sizeof(r));
+  r.status = status;
+  r.numFences = 2;
+  r.fences[0].state = fence0;
+  r.fences[1].state = fence1;
+  r.combState = ((fence0 == GEOFENCE_INSIDE) || (fence1 == GEOFENCE_INSIDE)) ? GEOFENCE_INSIDE : GEOFENCE_OUTSIDE;
+  return r;
+}
+
+int callbacks = 0;
+GeofenceEvent lastEvent;
+
+void on_crossing(const GeofenceEvent &e) {
+  callbacks++;
+  lastEvent = e;
+}
+
+void test_crossings() {
+  GeofenceMonitor monitor(&gps);
+  TEST_ASSERT_EQUAL(0, monitor.add_fence(GEOFENCE_LAUNCH_SITE, launchLat, launchLon, 5000));
+  TEST_ASSERT_EQUAL(1, monitor.add_fence(GEOFENCE_RECOVERY, 476000000, -1172000000, 20000));
+  monitor.attach(callback(on_crossing));
+  callbacks = 0;
+  Kernel::Clock::time_point t0 = Kernel::Clock::now();
+
+  // First known states are not crossings
+  TEST_ASSERT_EQUAL(0, monitor.add_report(make_report(1, GEOFENCE_INSIDE, GEOFENCE_OUTSIDE), t0));
+  TEST_ASSERT_TRUE(monitor.active());
+  TEST_ASSERT_EQUAL(GEOFENCE_INSIDE, monitor.state(0));
+  TEST_ASSERT_EQUAL(0, monitor.add_report(make_report(1, GEOFENCE_INSIDE, GEOFENCE_OUTSIDE), t0 + 1s));
+
+  // Leaving the launch site, through an unknown epoch
+  TEST_ASSERT_EQUAL(0, monitor.add_report(make_report(1, GEOFENCE_UNKNOWN, GEOFENCE_OUTSIDE), t0 + 2s));
+  TEST_ASSERT_EQUAL(GEOFENCE_INSIDE, monitor.state(0));
+  TEST_ASSERT_EQUAL(1, monitor.add_report(make_report(1, GEOFENCE_OUTSIDE, GEOFENCE_OUTSIDE), t0 + 3s));
+  TEST_ASSERT_EQUAL(1, callbacks);
+  TEST_ASSERT_EQUAL(0, lastEvent.fence);
+  TEST_ASSERT_EQUAL(GEOFENCE_LAUNCH_SITE, lastEvent.role);
+  TEST_ASSERT_EQUAL(GEOFENCE_INSIDE, lastEvent.from);
+  TEST_ASSERT_EQUAL(GEOFENCE_OUTSIDE, lastEvent.to);
+  TEST_ASSERT_TRUE(lastEvent.time == t0 + 3s);
+
+  // Landing in the recovery zone
+  TEST_ASSERT_EQUAL(1, monitor.add_report(make_report(1, GEOFENCE_OUTSIDE, GEOFENCE_INSIDE), t0 + 100s));
+  TEST_ASSERT_EQUAL(2, monitor.crossings());
+  GeofenceEvent e;
+  TEST_ASSERT_TRUE(monitor.event(0, e));
+  TEST_ASSERT_EQUAL(GEOFENCE_RECOVERY, e.role);
+  TEST_ASSERT_TRUE(monitor.event(1, e));
+  TEST_ASSERT_EQUAL(GEOFENCE_LAUNCH_SITE, e.role);
+  TEST_ASSERT_FALSE(monitor.event(2, e));
+}
+
+void test_unreliable() {
+  GeofenceMonitor monitor(&gps);
+  monitor.add_fence(GEOFENCE_AIRSPACE, launchLat, launchLon, 1000);
+  monitor.add_fence(GEOFENCE_OTHER, launchLat, launchLon, 2000);
+  TEST_ASSERT_EQUAL(2, monitor.add_fence(GEOFENCE_OTHER, 0, 0, 1));
+  TEST_ASSERT_EQUAL(3, monitor.add_fence(GEOFENCE_OTHER, 0, 0, 1));
+  TEST_ASSERT_EQUAL(-1, monitor.add_fence(GEOFENCE_OTHER, 0, 0, 1));   // the receiver holds four
+  Kernel::Clock::time_point t0 = Kernel::Clock::now();
+  monitor.add_report(make_report(1, GEOFENCE_INSIDE, GEOFENCE_INSIDE), t0);
+  // Receiver without a reliable fix: states are ignored
+  TEST_ASSERT_EQUAL(0, monitor.add_report(make_report(0, GEOFENCE_OUTSIDE, GEOFENCE_OUTSIDE), t0 + 1s));
+  TEST_ASSERT_FALSE(monitor.active());
+  TEST_ASSERT_EQUAL(GEOFENCE_INSIDE, monitor.state(0));
+  TEST_ASSERT_EQUAL(0, monitor.crossings());
+  TEST_ASSERT_EQUAL(GEOFENCE_UNKNOWN, monitor.state(5));
+}
+
+void test_report_frame() {
+  GeofenceMonitor monitor(&gps);
+  monitor.add_fence(GEOFENCE_LAUNCH_SITE, launchLat, launchLon, 5000);
+  monitor.add_fence(GEOFENCE_RECOVERY, 476000000, -1172000000, 20000);
+  char data[GEOFENCE_REPORT_LENGTH];
+  TEST_ASSERT_EQUAL(0, monitor.build_report(NULL, data));
+
+  SBDmessage msg;
+  msg.missionID = 42;
+  msg.setMissionID(SBD_FLIGHT_MODE_FLIGHT);
+  msg.generateCommandModuleBytes(7.5, 20.0, -40.0);
+  monitor.set_report(NULL, &msg);
+  Kernel::Clock::time_point t0 = Kernel::Clock::now();
+  monitor.add_report(make_report(1, GEOFENCE_INSIDE, GEOFENCE_OUTSIDE), t0);
+  monitor.add_report(make_report(1, GEOFENCE_OUTSIDE, GEOFENCE_OUTSIDE), t0 + 1s);
+
+  GPSFix fix = {true, 9, 1623508200, 477900000, -1174000000, 30000000, -5000, 7200, 9000000};
+  TEST_ASSERT_EQUAL(SBD_CM_LENGTH + 3, monitor.build_report(&fix, data));
+  TEST_ASSERT_EQUAL_MEMORY(msg.data(), data, 2);                    // mission ID
+  TEST_ASSERT_EQUAL_MEMORY(msg.data() + 22, data + 22, 6);          // command module bytes
+  TEST_ASSERT_EQUAL(1, data[2] & 0x01);                            // GPS fix
+  TEST_ASSERT_EQUAL(0, msg.getByte(2) & 0x01);                     // the message itself is untouched
+  TEST_ASSERT_EQUAL(2, data[SBD_CM_LENGTH]);
+  TEST_ASSERT_EQUAL(0x10 | (GEOFENCE_LAUNCH_SITE << 2) | GEOFENCE_OUTSIDE, data[SBD_CM_LENGTH + 1]);
+  TEST_ASSERT_EQUAL((GEOFENCE_RECOVERY << 2) | GEOFENCE_OUTSIDE, data[SBD_CM_LENGTH + 2]);
+}
+
+// Fix bits left in the routine message by an earlier frame are not carried
+// into a report
+void test_report_stale_bits() {
+  GeofenceMonitor monitor(&gps);
+  monitor.add_fence(GEOFENCE_LAUNCH_SITE, launchLat, launchLon, 5000);
+  SBDmessage msg;
+  msg.missionID = 42;
+  msg.setMissionID(SBD_FLIGHT_MODE_FLIGHT);
+  monitor.set_report(NULL, &msg);
+  char data[GEOFENCE_REPORT_LENGTH];
+
+  GPSFix east = {true, 9, 1623508200, 477900000, -1174000000, 30000000, -5000, 7200, 9000000};
+  msg.generateGPSBytes(east);
+  TEST_ASSERT_EQUAL(0x03, msg.getByte(2) & 0x03);                   // fix, heading east
+  GPSFix lost = east;
+  lost.positionFix = false;
+  lost.heading = 27000000;                                          // heading west
+  monitor.build_report(&lost, data);
+  TEST_ASSERT_EQUAL(0, data[2] & 0x03);
+
+  msg.generatePredictedGPSBytes(east);
+  TEST_ASSERT_EQUAL(SBD_STATUS_EXTRAPOLATED, msg.getByte(36) & SBD_STATUS_EXTRAPOLATED);
+  monitor.build_report(&east, data);
+  TEST_ASSERT_EQUAL(0, data[36] & SBD_STATUS_EXTRAPOLATED);
+  TEST_ASSERT_EQUAL(0x03, data[2] & 0x03);
+}
+
+void test_fence_on_receiver() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  if (!gps.getPVT() || (gps.getFixType() != 3))
+    TEST_IGNORE_MESSAGE("No 3D fix");
+  GeofenceMonitor monitor(&gps);
+  monitor.add_fence(GEOFENCE_LAUNCH_SITE, gps.getLatitude(), gps.getLongitude(), 1000);
+  TEST_ASSERT_EQUAL(GEOFENCE_SUCCESS, monitor.begin());
+
+  Timer t;
+  t.start();
+  while ((monitor.state(0) == GEOFENCE_UNKNOWN) && (t.elapsed_time() < 10s)) {
+    gps.checkUblox();
+    monitor.update();
+    ThisThread::sleep_for(100ms);
+  }
+  TEST_ASSERT_TRUE(monitor.active());
+  TEST_ASSERT_EQUAL(GEOFENCE_INSIDE, monitor.state(0));
+  TEST_ASSERT_EQUAL(0, monitor.crossings());
+  gps.unsubscribe(UBX_CLASS_NAV, UBX_NAV_GEOFENCE);
+  TEST_ASSERT_TRUE(gps.clearGeofences());
+}
+
+// A PIO edge polls NAV-GEOFENCE without blocking, and with the periodic
+// output turned off the answer still reaches the monitor through the
+// subscription
+void test_pio_poll() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  if (!gps.getPVT() || (gps.getFixType() != 3))
+    TEST_IGNORE_MESSAGE("No 3D fix");
+  DigitalOut pio(TEST_PIO_DRIVE, 1);
+  GeofenceMonitor monitor(&gps, TEST_PIO_PIN);
+  monitor.add_fence(GEOFENCE_LAUNCH_SITE, gps.getLatitude(), gps.getLongitude(), 1000);
+  TEST_ASSERT_EQUAL(GEOFENCE_SUCCESS, monitor.begin());
+  TEST_ASSERT_TRUE(gps.configureMessage(UBX_CLASS_NAV, UBX_NAV_GEOFENCE, COM_PORT_I2C, 0));
+  ThisThread::sleep_for(1500ms);
+  gps.checkUblox();
+  monitor.update();
+  uint32_t before = gps.getMessageCount(UBX_CLASS_NAV, UBX_NAV_GEOFENCE);
+
+  pio = 0;                    // fence entered
+  Timer t;
+  t.start();
+  monitor.update();
+  TEST_ASSERT_TRUE(t.elapsed_time() < 100ms);
+  while ((monitor.state(0) == GEOFENCE_UNKNOWN) && (t.elapsed_time() < 1s)) {
+    gps.checkUblox();
+    monitor.update();
+    ThisThread::sleep_for(20ms);
+  }
+  TEST_ASSERT_EQUAL(before + 1, gps.getMessageCount(UBX_CLASS_NAV, UBX_NAV_GEOFENCE));
+  TEST_ASSERT_EQUAL(GEOFENCE_INSIDE, monitor.state(0));
+  gps.unsubscribe(UBX_CLASS_NAV, UBX_NAV_GEOFENCE);
+  TEST_ASSERT_TRUE(gps.clearGeofences());
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_crossings);
+  RUN_TEST(test_unreliable);
+  RUN_TEST(test_report_frame);
+  RUN_TEST(test_report_stale_bits);
+  RUN_TEST(test_fence_on_receiver);
+  RUN_TEST(test_pio_poll);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
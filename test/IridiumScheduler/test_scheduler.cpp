@@ -0,0 +1,88 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "IridiumScheduler.h"
+
+/* Session scheduling from signal samples given directly (no modem needed).
+ * A 2 s period with a 1 s window keeps the timing tests short.
+ */
+
+void test_estimate() {
+  IridiumScheduler scheduler(NULL);
+  TEST_ASSERT_EQUAL(-1, scheduler.current_bars());
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 5.5f / 6, scheduler.success_estimate(5));
+
+  scheduler.add_sample(5);
+  scheduler.add_sample(4);
+  scheduler.add_sample(5);
+  TEST_ASSERT_EQUAL(5, scheduler.current_bars());
+
+  // The outcome counts against the bars at the start of the session, not
+  // whatever CSQF reads once it is over
+  int bars = 1;
+  scheduler.record_session(false, bars, 20000ms, 0);
+  scheduler.record_session(false, bars, 20000ms, 0);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 5.5f / 6, scheduler.success_estimate(5));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, (2 * 1.5f / 6) / 4, scheduler.success_estimate(1));
+
+  scheduler.record_session(true, 5, 10000ms, 100);
+  SchedulerMetrics m = scheduler.get_metrics();
+  TEST_ASSERT_EQUAL(3, m.sessions);
+  TEST_ASSERT_EQUAL(1, m.successes);
+  TEST_ASSERT_EQUAL(16666, m.avgSessionMs);
+  TEST_ASSERT_EQUAL(100, m.bytesDelivered);
+  // 725 mW for 50 s over 100 bytes
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 362.5f, m.energyPerByte);
+}
+
+void test_pull_forward() {
+  IridiumScheduler scheduler(NULL);
+  scheduler.set_period(2s, 1s);
+  for (int i = 0; i < 3; i++)
+    scheduler.add_sample(5);
+  scheduler.record_session(true, 5, 1000ms, 50);
+  TEST_ASSERT_FALSE(scheduler.should_transmit());     // window not open yet
+  ThisThread::sleep_for(1100ms);
+  TEST_ASSERT_TRUE(scheduler.should_transmit());      // good signal, go early
+}
+
+void test_defer() {
+  IridiumScheduler scheduler(NULL);
+  scheduler.set_period(2s, 1s);
+  for (int i = 0; i < 4; i++)
+    scheduler.record_session(false, 0, 1000ms, 0);
+  for (int i = 0; i < 3; i++)
+    scheduler.add_sample(0);
+  TEST_ASSERT_TRUE(scheduler.success_estimate(0) < SCHED_DEFER_PROB);
+
+  // Poor signal waits, but never beyond one transmit period
+  ThisThread::sleep_for(1600ms);
+  TEST_ASSERT_FALSE(scheduler.should_transmit());
+  TEST_ASSERT_TRUE(scheduler.time_to_deadline() <= 400ms);
+  ThisThread::sleep_for(500ms);
+  TEST_ASSERT_TRUE(scheduler.should_transmit());
+  TEST_ASSERT_TRUE(scheduler.time_to_deadline() == 0ms);
+}
+
+void test_slack_limit() {
+  IridiumScheduler scheduler(NULL);
+  scheduler.set_period(2s, 10s);                      // slack is cut to the period
+  scheduler.record_session(true, 3, 1000ms, 50);
+  TEST_ASSERT_TRUE(scheduler.time_to_deadline() <= 2000ms);
+  TEST_ASSERT_TRUE(scheduler.time_to_deadline() > 1500ms);
+  TEST_ASSERT_TRUE(scheduler.time_to_window() == 0ms);
+
+  scheduler.set_period(2s, 1s);
+  TEST_ASSERT_TRUE(scheduler.time_to_window() <= 1000ms);
+  TEST_ASSERT_TRUE(scheduler.time_to_window() > 500ms);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_estimate);
+  RUN_TEST(test_pull_forward);
+  RUN_TEST(test_defer);
+  RUN_TEST(test_slack_limit);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
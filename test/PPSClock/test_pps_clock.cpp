@@ -0,0 +1,177 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+#include "PPSClock.h"
+
+/* Time pulse disciplined clock.
+ * All but the last test feed synthetic TIM-TP messages and pulse edges from
+ * a ticker running 20 ppm slow. The last test needs the receiver's
+ * TIMEPULSE output jumpered to TEST_PPS_PIN and a GPS fix.
+ */
+
+#define TEST_PPS_PIN p21
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+PPSClock ppsClock(&gps, TEST_PPS_PIN);
+
+const uint64_t launchUtc = 1623508200ULL * 1000000;   // 2021-06-12 14:30:00 UTC
+
+UBX_TIM_TP_data_t make_timepulse(uint32_t seconds) {
+  UBX_TIM_TP_data_t tp;
+  memset(&tp, 0, sizeof(tp));
+  tp.week = 2161;
+  tp.towMS = (570600 + seconds) * 1000;
+  tp.flags = 0x03;    // UTC time base, UTC available
+  return tp;
+}
+
+// Local time (us) of a UTC offset for a ticker 20 ppm slow, starting at 5 s
+uint64_t slow_local(uint64_t utcOffset) {
+  return 5000000 + utcOffset - utcOffset / 50000;
+}
+
+void test_timepulse_utc() {
+  UBX_TIM_TP_data_t tp = make_timepulse(0);
+  TEST_ASSERT_TRUE(PPSClock::timepulse_utc(tp) == launchUtc);
+  tp.towMS = 570618000;   // same instant in GPS time
+  tp.flags = 0x02;
+  TEST_ASSERT_TRUE(PPSClock::timepulse_utc(tp) == launchUtc);
+  tp.towMS = 570618250;
+  tp.towSubMS = 0x80000000;   // half a millisecond
+  TEST_ASSERT_TRUE(PPSClock::timepulse_utc(tp) == launchUtc + 250500);
+}
+
+void test_discipline() {
+  PPSClock clock(&gps, TEST_PPS_PIN);
+  TEST_ASSERT_TRUE(clock.to_utc(1000) == 0);
+  for (uint32_t s = 0; s < 20; s++) {
+    uint64_t edge = slow_local((uint64_t)s * 1000000);
+    clock.add_timepulse(make_timepulse(s), edge - 400000);
+    clock.add_pulse(edge);
+  }
+  TEST_ASSERT_EQUAL(20, clock.anchors());
+  TEST_ASSERT_INT_WITHIN(100, 20000, clock.rate_error());
+
+  // Between pulses and after 100 s of holdover the error stays under a microsecond or two
+  uint64_t local = slow_local(19500000);
+  TEST_ASSERT_INT_WITHIN(1, 0, (int64_t)(clock.to_utc(local) - (launchUtc + 19500000)));
+  local = slow_local(119000000);
+  TEST_ASSERT_INT_WITHIN(2, 0, (int64_t)(clock.to_utc(local) - (launchUtc + 119000000)));
+}
+
+void test_unmatched_pulses() {
+  PPSClock clock(&gps, TEST_PPS_PIN);
+  clock.add_pulse(2000000);                 // no TIM-TP yet
+  TEST_ASSERT_EQUAL(0, clock.anchors());
+  clock.add_timepulse(make_timepulse(0), 3000000);
+  clock.add_pulse(3000000 + PPS_MATCH_WINDOW_US + 1);   // too late to be the announced pulse
+  TEST_ASSERT_EQUAL(0, clock.anchors());
+  clock.add_timepulse(make_timepulse(2), 5000000);
+  clock.add_pulse(5600000);
+  clock.add_pulse(6600000);                 // TIM-TP is used once
+  TEST_ASSERT_EQUAL(1, clock.anchors());
+  TEST_ASSERT_TRUE(clock.to_utc(5600000) == launchUtc + 2000000);
+}
+
+void test_wrong_second() {
+  PPSClock clock(&gps, TEST_PPS_PIN);
+  clock.add_timepulse(make_timepulse(2), 5000000);
+  clock.add_pulse(5600000);
+  // The TIM-TP for the 3 s pulse was lost; the 4 s message pairs with the 3 s pulse
+  clock.add_timepulse(make_timepulse(4), 6000000);
+  clock.add_pulse(6600000);
+  TEST_ASSERT_EQUAL(1, clock.anchors());
+  clock.add_timepulse(make_timepulse(4), 7000000);
+  clock.add_pulse(7600000);
+  TEST_ASSERT_EQUAL(2, clock.anchors());
+  TEST_ASSERT_TRUE(clock.to_utc(7600000) == launchUtc + 4000000);
+
+  // After a long holdover the clock takes the receiver's word again
+  uint64_t later = 7600000 + (uint64_t)(PPS_HOLDOVER_S + 10) * 1000000;
+  clock.add_timepulse(make_timepulse(PPS_HOLDOVER_S + 15), later - 400000);
+  clock.add_pulse(later);
+  TEST_ASSERT_EQUAL(3, clock.anchors());
+  TEST_ASSERT_TRUE(clock.to_utc(later) == launchUtc + (uint64_t)(PPS_HOLDOVER_S + 15) * 1000000);
+}
+
+// Local time (us) of a pulse for an exact ticker starting at 5 s
+uint64_t edge_at(uint32_t seconds) {
+  return 5000000 + (uint64_t)seconds * 1000000;
+}
+
+// A TIM-TP read after the pulse it announced must not pair with the next
+// one, even after a holdover long enough that any pair would be taken
+void test_late_timepulse() {
+  PPSClock clock(&gps, TEST_PPS_PIN);
+  for (uint32_t s = 0; s < 3; s++) {
+    clock.add_timepulse(make_timepulse(s), edge_at(s) - 400000);
+    clock.add_pulse(edge_at(s));
+  }
+  TEST_ASSERT_EQUAL(3, clock.anchors());
+  const uint32_t h = PPS_HOLDOVER_S + 10;
+  clock.add_pulse(edge_at(h));                                  // its TIM-TP is still queued
+  clock.add_timepulse(make_timepulse(h), edge_at(h) + 100000);  // read 100 ms late
+  clock.add_pulse(edge_at(h + 1));
+  TEST_ASSERT_EQUAL(3, clock.anchors());
+  TEST_ASSERT_TRUE(clock.to_utc(edge_at(h + 1)) == launchUtc + (uint64_t)(h + 1) * 1000000);
+  clock.add_timepulse(make_timepulse(h + 2), edge_at(h + 2) - 400000);
+  clock.add_pulse(edge_at(h + 2));
+  TEST_ASSERT_EQUAL(4, clock.anchors());
+  TEST_ASSERT_TRUE(clock.to_utc(edge_at(h + 2)) == launchUtc + (uint64_t)(h + 2) * 1000000);
+}
+
+// Before the first anchor a late TIM-TP cannot be spotted. The pairs that
+// follow show the clock a second out, and it re-anchors well before holdover.
+void test_bad_first_anchor() {
+  PPSClock clock(&gps, TEST_PPS_PIN);
+  clock.add_pulse(edge_at(0));
+  clock.add_timepulse(make_timepulse(0), edge_at(0) + 100000);
+  clock.add_pulse(edge_at(1));
+  TEST_ASSERT_EQUAL(1, clock.anchors());
+  TEST_ASSERT_TRUE(clock.to_utc(edge_at(1)) == launchUtc);      // a second behind
+  for (uint32_t s = 2; s < 2 + PPS_RELOCK_PAIRS; s++) {
+    clock.add_timepulse(make_timepulse(s), edge_at(s) - 400000);
+    clock.add_pulse(edge_at(s));
+  }
+  TEST_ASSERT_EQUAL(2, clock.anchors());
+  uint32_t last = 1 + PPS_RELOCK_PAIRS;
+  TEST_ASSERT_TRUE(clock.to_utc(edge_at(last)) == launchUtc + (uint64_t)last * 1000000);
+  clock.add_timepulse(make_timepulse(last + 1), edge_at(last + 1) - 400000);
+  clock.add_pulse(edge_at(last + 1));
+  TEST_ASSERT_EQUAL(3, clock.anchors());
+}
+
+void test_pps_on_receiver() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  TEST_ASSERT_EQUAL(PPS_SUCCESS, ppsClock.begin());
+  Timer t;
+  t.start();
+  while ((ppsClock.anchors() < 3) && (t.elapsed_time() < 6s)) {
+    gps.checkUblox();
+    ThisThread::sleep_for(100ms);
+  }
+  gps.unsubscribe(UBX_CLASS_TIM, UBX_TIM_TP);
+  if (ppsClock.anchors() == 0)
+    TEST_IGNORE_MESSAGE("No time pulse (no fix or TIMEPULSE not wired)");
+  TEST_ASSERT_TRUE(ppsClock.synced());
+  uint64_t a = ppsClock.now();
+  uint64_t b = ppsClock.now();
+  TEST_ASSERT_TRUE(b > a);
+  printf("PPS anchors %lu, rate error %ld ppb\n", (unsigned long)ppsClock.anchors(), (long)ppsClock.rate_error());
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_timepulse_utc);
+  RUN_TEST(test_discipline);
+  RUN_TEST(test_unmatched_pulses);
+  RUN_TEST(test_wrong_second);
+  RUN_TEST(test_late_timepulse);
+  RUN_TEST(test_bad_first_anchor);
+  RUN_TEST(test_pps_on_receiver);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
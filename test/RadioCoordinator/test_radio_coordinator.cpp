@@ -0,0 +1,101 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "RadioCoordinator.h"
+
+/* Bookkeeping of fixes around Iridium sessions, without a modem or GPS.
+ * Sessions are reported with session_started/session_ended and fixes are
+ * given explicit times, so the periods can be checked without waiting.
+ * test_rate_restored needs the receiver on the I2C bus.
+ */
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+
+GPSFix make_fix(bool positionFix) {
+  GPSFix fix = {positionFix, 9, 1623508200, 477543000, -1174172000, 25600000, -5000, 7200, 9000000};
+  return fix;
+}
+
+void test_periods() {
+  RadioCoordinator coordinator(NULL, NULL);
+  Kernel::Clock::time_point t0 = Kernel::Clock::now();
+
+  TEST_ASSERT_TRUE(coordinator.record_fix(make_fix(true), t0));
+  TEST_ASSERT_TRUE(coordinator.record_fix(make_fix(false), t0 + 1s));
+
+  coordinator.session_started(t0 + 2s);
+  TEST_ASSERT_TRUE(coordinator.busy());
+  TEST_ASSERT_EQUAL(RADIO_DURING, coordinator.period(t0 + 3s));
+  TEST_ASSERT_FALSE(coordinator.record_fix(make_fix(false), t0 + 3s));
+  TEST_ASSERT_FALSE(coordinator.record_fix(make_fix(false), t0 + 10s));
+
+  coordinator.session_ended(t0 + 20s);
+  TEST_ASSERT_FALSE(coordinator.busy());
+  TEST_ASSERT_TRUE(coordinator.window_open());
+  TEST_ASSERT_EQUAL(RADIO_AFTER, coordinator.period(t0 + 21s));
+  TEST_ASSERT_FALSE(coordinator.record_fix(make_fix(false), t0 + 21s));
+  TEST_ASSERT_FALSE(coordinator.record_fix(make_fix(true), t0 + 23s));
+  TEST_ASSERT_EQUAL(RADIO_QUIET, coordinator.period(t0 + 20s + milliseconds(RADIO_GUARD_MS)));
+  TEST_ASSERT_TRUE(coordinator.record_fix(make_fix(true), t0 + 30s));
+
+  RadioMetrics m = coordinator.get_metrics();
+  TEST_ASSERT_EQUAL(1, m.sessions);
+  TEST_ASSERT_EQUAL(3, m.fixes[RADIO_QUIET]);
+  TEST_ASSERT_EQUAL(1, m.lost[RADIO_QUIET]);
+  TEST_ASSERT_EQUAL(2, m.fixes[RADIO_DURING]);
+  TEST_ASSERT_EQUAL(2, m.lost[RADIO_DURING]);
+  TEST_ASSERT_EQUAL(2, m.fixes[RADIO_AFTER]);
+  TEST_ASSERT_EQUAL(1, m.lost[RADIO_AFTER]);
+  TEST_ASSERT_EQUAL(3000, m.avgRecoveryMs);   // first good fix 3 s after the session
+}
+
+void test_recovery_average() {
+  RadioCoordinator coordinator(NULL, NULL);
+  Kernel::Clock::time_point t0 = Kernel::Clock::now();
+  coordinator.session_started(t0);
+  coordinator.session_ended(t0 + 10s);
+  coordinator.record_fix(make_fix(true), t0 + 11s);
+  coordinator.record_fix(make_fix(true), t0 + 12s);     // only the first good fix counts
+  coordinator.session_started(t0 + 100s);
+  coordinator.session_ended(t0 + 110s);
+  coordinator.record_fix(make_fix(false), t0 + 111s);
+  coordinator.record_fix(make_fix(true), t0 + 115s);
+  RadioMetrics m = coordinator.get_metrics();
+  TEST_ASSERT_EQUAL(2, m.sessions);
+  TEST_ASSERT_EQUAL(3000, m.avgRecoveryMs);
+}
+
+// The measurement period after the window is the one from before it, even
+// below 1 Hz, unless it was changed while the window was open
+void test_rate_restored() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  RadioCoordinator coordinator(&gps, NULL);
+  TEST_ASSERT_TRUE(gps.setMeasurementRate(2000));
+  Kernel::Clock::time_point ended = Kernel::Clock::now() - seconds(RADIO_WINDOW_S + 1);
+  coordinator.session_started(ended - 10s);
+  coordinator.session_ended(ended);
+  TEST_ASSERT_TRUE(coordinator.window_open());
+  TEST_ASSERT_EQUAL(1000 / RADIO_WINDOW_RATE, gps.getMeasurementRate());
+  coordinator.update();
+  TEST_ASSERT_FALSE(coordinator.window_open());
+  TEST_ASSERT_EQUAL(2000, gps.getMeasurementRate());
+
+  coordinator.session_started(ended - 10s);
+  coordinator.session_ended(ended);
+  TEST_ASSERT_TRUE(gps.setMeasurementRate(500));   // e.g. FlightPhaseModel at burst
+  coordinator.update();
+  TEST_ASSERT_FALSE(coordinator.window_open());
+  TEST_ASSERT_EQUAL(500, gps.getMeasurementRate());
+  gps.setMeasurementRate(1000);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_periods);
+  RUN_TEST(test_recovery_average);
+  RUN_TEST(test_rate_restored);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,128 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+#include "ReceiverHealth.h"
+
+/* Receiver health block.
+ * The first two tests feed synthetic MON-HW, MON-RF and buffer readings and
+ * check the summary and its bytes in the SBD frame. The last test polls a
+ * real receiver.
+ */
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+
+UBX_MON_HW_data_t make_hardware(uint8_t jamInd, uint16_t agcCnt, uint8_t aStatus, uint8_t jammingState) {
+  UBX_MON_HW_data_t hw;
+  memset(&hw, 0, sizeof(hw));
+  hw.jamInd = jamInd;
+  hw.agcCnt = agcCnt;
+  hw.noisePerMS = 80;
+  hw.aStatus = aStatus;
+  hw.aPower = 1;
+  hw.flags = 0x01 | (jammingState << 2);    // rtcCalib set
+  return hw;
+}
+
+void test_summary() {
+  ReceiverHealth health(&gps);
+  health.add_hardware(make_hardware(10, 5000, RH_ANTENNA_OK, 1));
+  health.add_hardware(make_hardware(40, 2000, RH_ANTENNA_OPEN, 2));
+  health.add_hardware(make_hardware(20, 6000, RH_ANTENNA_OK, 1));
+
+  UBX_MON_TXBUF_data_t tx;
+  UBX_MON_RXBUF_data_t rx;
+  memset(&tx, 0, sizeof(tx));
+  memset(&rx, 0, sizeof(rx));
+  tx.peakUsage[0] = 35;
+  tx.peakUsage[1] = 90;         // UART1, not ours
+  rx.peakUsage[0] = 5;
+  health.add_buffers(tx, rx);
+  tx.peakUsage[0] = 100;
+  tx.errors = 0x01;             // I2C limit reached
+  health.add_buffers(tx, rx);
+
+  ReceiverHealthSummary s = health.take_summary();
+  TEST_ASSERT_EQUAL(3, s.samples);
+  TEST_ASSERT_EQUAL(40, s.jamInd);
+  TEST_ASSERT_EQUAL(2000, s.agcCnt);
+  TEST_ASSERT_EQUAL(80, s.noisePerMS);
+  TEST_ASSERT_EQUAL(RH_ANTENNA_OPEN, s.antStatus);   // worst is kept
+  TEST_ASSERT_EQUAL(2, s.jammingState);
+  TEST_ASSERT_TRUE(s.outputLost);
+  TEST_ASSERT_EQUAL(100, s.txPeakUsage);
+  TEST_ASSERT_EQUAL(5, s.rxPeakUsage);
+
+  s = health.take_summary();    // new summary after each frame
+  TEST_ASSERT_EQUAL(0, s.samples);
+  TEST_ASSERT_FALSE(s.outputLost);
+
+  UBX_MON_RF_data_t rf;
+  memset(&rf, 0, sizeof(rf));
+  rf.nBlocks = 2;
+  rf.blocks[0].jamInd = 12;
+  rf.blocks[0].agcCnt = 4000;
+  rf.blocks[0].antStatus = RH_ANTENNA_OK;
+  rf.blocks[0].flags = 1;
+  rf.blocks[1].jamInd = 60;
+  rf.blocks[1].agcCnt = 3500;
+  rf.blocks[1].antStatus = RH_ANTENNA_OK;
+  rf.blocks[1].flags = 3;
+  health.add_rf(rf);
+  s = health.take_summary();
+  TEST_ASSERT_EQUAL(2, s.samples);
+  TEST_ASSERT_EQUAL(60, s.jamInd);
+  TEST_ASSERT_EQUAL(3500, s.agcCnt);
+  TEST_ASSERT_EQUAL(3, s.jammingState);
+  TEST_ASSERT_EQUAL(RH_ANTENNA_OK, s.antStatus);
+}
+
+void test_frame_bytes() {
+  SBDmessage msg;
+  ReceiverHealthSummary s;
+  memset(&s, 0, sizeof(s));
+  msg.generateHealthBytes(s);   // nothing polled: bytes stay 0
+  for (int i = 32; i < SBD_CM_LENGTH; i++)
+    TEST_ASSERT_EQUAL(0, msg.getByte(i));
+
+  s.samples = 1;
+  s.jamInd = 40;
+  s.agcCnt = 8191;
+  s.noisePerMS = 0x0123;
+  s.antStatus = RH_ANTENNA_SHORT;
+  s.jammingState = 2;
+  s.outputLost = true;
+  s.txPeakUsage = 97;
+  s.rxPeakUsage = 4;
+  msg.generateHealthBytes(s);
+  TEST_ASSERT_EQUAL(40, (uint8_t)msg.getByte(32));
+  TEST_ASSERT_EQUAL(200, (uint8_t)msg.getByte(33));  // full scale
+  TEST_ASSERT_EQUAL(0x01, msg.getByte(34));
+  TEST_ASSERT_EQUAL(0x23, msg.getByte(35));
+  TEST_ASSERT_EQUAL(0x03 | (2 << 3) | 0x20, msg.getByte(36));
+  TEST_ASSERT_EQUAL(97, msg.getByte(37));
+  TEST_ASSERT_EQUAL(4, msg.getByte(38));
+}
+
+void test_health_on_receiver() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  ReceiverHealth health(&gps);
+  health.begin();
+  TEST_ASSERT_TRUE(health.update());
+  TEST_ASSERT_FALSE(health.update());   // not due again for RH_PERIOD_S
+  ReceiverHealthSummary s = health.take_summary();
+  TEST_ASSERT_TRUE(s.samples > 0);
+  printf("Jamming %u, AGC %u, noise %u, antenna %u, I2C TX peak %u%%\r\n", s.jamInd, s.agcCnt,
+    s.noisePerMS, s.antStatus, s.txPeakUsage);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_summary);
+  RUN_TEST(test_frame_bytes);
+  RUN_TEST(test_health_on_receiver);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,121 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ATLineReader.h"
+
+/* Parsing and timing of Iridium responses without a modem attached.
+ *
+ * A canned FileHandle replays a modem response forever so ATLineReader and
+ * ATCmdParser can be compared on identical input. Flash cost is compared by
+ * building with and without ATCmdParser::recv calls (pio run -v size output).
+ */
+
+#define BENCH_ITERATIONS 500
+
+class CannedResponse : public FileHandle {
+public:
+  CannedResponse(const char *text) {
+    _text = text;
+    _length = strlen(text);
+    _pos = 0;
+  }
+  ssize_t read(void *buffer, size_t size) override {
+    char *b = (char*)buffer;
+    for (size_t i = 0; i < size; i++) {
+      b[i] = _text[_pos];
+      _pos = (_pos + 1) % _length;
+    }
+    return size;
+  }
+  ssize_t write(const void *buffer, size_t size) override { return size; }
+  off_t seek(off_t offset, int whence = SEEK_SET) override { return 0; }
+  int close() override { return 0; }
+  void rewind() { _pos = 0; }
+private:
+  const char *_text;
+  size_t _length;
+  size_t _pos;
+};
+
+const char sbdixResponse[] = "AT+SBDIX\r+SBDIX: 0, 23, 1, 7, 42, 2\r\n\r\nOK\r\n";
+
+void test_parse_ints() {
+  int v[6];
+  int n = ATLineReader::parse_ints("0, 23, 1, 7, 42, 2", v, 6);
+  TEST_ASSERT_EQUAL(6, n);
+  TEST_ASSERT_EQUAL(0, v[0]);
+  TEST_ASSERT_EQUAL(23, v[1]);
+  TEST_ASSERT_EQUAL(42, v[4]);
+  n = ATLineReader::parse_ints("0, 5, 0, -1, 0, 0", v, 6);
+  TEST_ASSERT_EQUAL(6, n);
+  TEST_ASSERT_EQUAL(-1, v[3]);
+}
+
+void test_parse_uint64() {
+  uint64_t imei = 0;
+  TEST_ASSERT_TRUE(ATLineReader::parse_uint64("300234010753370", &imei));
+  TEST_ASSERT_TRUE(imei == 300234010753370ULL);
+  TEST_ASSERT_FALSE(ATLineReader::parse_uint64("OK", &imei));
+}
+
+void test_reader_lines() {
+  CannedResponse canned("AT+CSQ\r\r\n+CSQ:4\r\n\r\nOK\r\n");
+  ATLineReader reader(&canned);
+  const char *field = reader.wait_for("+CSQ:");
+  TEST_ASSERT_NOT_NULL(field);
+  TEST_ASSERT_EQUAL_STRING("4", field);
+  TEST_ASSERT_TRUE(reader.wait_for_OK());
+}
+
+void test_flush_bounded() {
+  // The canned modem never stops talking, so flush has to give up on its own
+  CannedResponse canned("+CSQ:4\r\nOK\r\n");
+  ATLineReader reader(&canned);
+  reader.flush();
+  TEST_ASSERT_NOT_NULL(reader.read_line());
+}
+
+void test_benchmark_sbdix() {
+  Timer t;
+  int v[6];
+
+  CannedResponse cannedReader(sbdixResponse);
+  ATLineReader reader(&cannedReader);
+  t.start();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) {
+    const char *field = reader.wait_for("+SBDIX:");
+    ATLineReader::parse_ints(field, v, 6);
+    reader.wait_for_OK();
+  }
+  t.stop();
+  long readerUs = duration_cast<microseconds>(t.elapsed_time()).count();
+  TEST_ASSERT_EQUAL(42, v[4]);
+
+  CannedResponse cannedParser(sbdixResponse);
+  ATCmdParser at(&cannedParser, "\r");
+  v[4] = 0;
+  t.reset();
+  t.start();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) {
+    at.recv("+SBDIX: %d,%d,%d,%d,%d,%d\r\n", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]);
+    at.recv("OK");
+  }
+  t.stop();
+  long parserUs = duration_cast<microseconds>(t.elapsed_time()).count();
+  TEST_ASSERT_EQUAL(42, v[4]);
+
+  // Same CSV layout as test/benchmarks (times here are in microseconds)
+  printf("bench,at_sbdix_ATLineReader_us,%d,%ld,%ld\n", BENCH_ITERATIONS, readerUs, readerUs/BENCH_ITERATIONS);
+  printf("bench,at_sbdix_ATCmdParser_us,%d,%ld,%ld\n", BENCH_ITERATIONS, parserUs, parserUs/BENCH_ITERATIONS);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_parse_ints);
+  RUN_TEST(test_parse_uint64);
+  RUN_TEST(test_reader_lines);
+  RUN_TEST(test_flush_bounded);
+  RUN_TEST(test_benchmark_sbdix);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
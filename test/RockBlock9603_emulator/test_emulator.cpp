@@ -0,0 +1,90 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "RockBlock9603.h"
+#include "IridiumScheduler.h"
+
+/* The RockBlock9603 driver and IridiumScheduler against the modem emulator,
+ * so the firmware itself (not the Python harness) is what gets measured.
+ * Wire a USB serial adapter to the modem pins and start the emulator with a
+ * strong, steady sky:
+ *    ./rockblock_emulator.py --serial /dev/ttyUSB0 --bars 5 --volatility 0 --latency 2
+ * Both tests are ignored if nothing answers on the modem pins. The second
+ * runs the scheduler for EMULATOR_RUN and prints a bench line that
+ * tools/bench_report.py can pick up.
+ */
+
+#define EMULATOR_RUN 180s
+#define EMULATOR_PERIOD 30s
+
+RockBlock9603 sat(p9, p10, NC);
+IridiumScheduler scheduler(&sat);
+
+bool delivered(const SessionStatus &ss) {
+  return (ss.moStatus >= 0) && (ss.moStatus <= 4);
+}
+
+void test_mo_buffer_kept() {
+  if (sat.get_IMEI() == 0)
+    TEST_IGNORE_MESSAGE("Modem (or emulator) not present");
+  char frame[50];
+  memset(frame, 0xA5, sizeof(frame));
+  TEST_ASSERT_EQUAL(0, sat.write_binary_message(frame, sizeof(frame)));
+  SessionStatus ss;
+  for (int i = 0; i < 3; i++) {
+    ss = sat.transmit_message();
+    if (delivered(ss)) break;
+  }
+  TEST_ASSERT_TRUE(delivered(ss));
+  // Like a real 9603, the message stays in the MO buffer until AT+SBDD0
+  TEST_ASSERT_EQUAL(1, sat.get_buffer_status().outgoingFlag);
+}
+
+void test_scheduled_sessions() {
+  if (sat.get_IMEI() == 0)
+    TEST_IGNORE_MESSAGE("Modem (or emulator) not present");
+  scheduler.set_period(EMULATOR_PERIOD);
+  char frame[100];
+  int seq = 0;
+  int sent = 0;
+  Timer run;
+  run.start();
+  while (run.elapsed_time() < EMULATOR_RUN) {
+    scheduler.sample();
+    if (!scheduler.should_transmit()) {
+      ThisThread::sleep_for(2s);
+      continue;
+    }
+    memset(frame, seq, sizeof(frame));
+    if (sat.write_binary_message(frame, sizeof(frame)) != 0) {
+      ThisThread::sleep_for(2s);
+      continue;
+    }
+    int bars = scheduler.current_bars();
+    SessionStatus ss = sat.transmit_message();
+    scheduler.record_session(delivered(ss), bars, ss.duration, delivered(ss) ? sizeof(frame) : 0);
+    if (delivered(ss)) {
+      sent++;
+      seq++;
+    }
+  }
+  SchedulerMetrics m = scheduler.get_metrics();
+  TEST_ASSERT_TRUE(m.sessions > 0);
+  TEST_ASSERT_EQUAL(sent, m.successes);
+  // Sessions never wait longer than the period (plus one session and one sample)
+  TEST_ASSERT_TRUE(m.sessions >= (uint32_t)(EMULATOR_RUN / (EMULATOR_PERIOD + 15s)));
+  // Same shape as the benchmark lines: name, iterations, total, per iteration
+  printf("bench,emulator_session_ms,%lu,%lu,%lu\n", (unsigned long)m.sessions,
+    (unsigned long)m.sessions * m.avgSessionMs, (unsigned long)m.avgSessionMs);
+  printf("Delivered %d messages, %lu per hour\n", sent,
+    (unsigned long)sent * 3600 / (unsigned long)duration_cast<seconds>(EMULATOR_RUN).count());
+  scheduler.print_metrics();
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_mo_buffer_kept);
+  RUN_TEST(test_scheduled_sessions);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,139 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "SBDpipeline.h"
+
+/* SBD frame length and the frame pipeline, with stand-in pods, GPS and
+ * sensors (no hardware needed).
+ */
+
+int podRequests = 0;
+int gpsReads = 0;
+
+void pod_request() {
+  podRequests++;
+}
+
+bool pod_ready() {
+  return true;
+}
+
+void pod_collect(SBDmessage *msg) {
+  char data[POD_LENGTH];
+  memset(data, podRequests, sizeof(data));
+  msg->podLengths[0] = 10;
+  msg->loadPodBuffer(1, data);
+}
+
+bool gps_snapshot(GPSFix &fix) {
+  gpsReads++;
+  GPSFix snapshot = {true, 8, 1623508200, 477543000, -1174172000, 700000, 0, 0, 0};
+  fix = snapshot;
+  return true;
+}
+
+void test_msg_length() {
+  SBDmessage msg;
+  char data[POD_LENGTH];
+  memset(data, 0x55, sizeof(data));
+  for (int i = 0; i < MAXPODS; i++) {
+    msg.podLengths[i] = 0;
+    msg.loadPodBuffer(i+1, data);
+  }
+  msg.updateMsgLength();
+  TEST_ASSERT_EQUAL(SBD_CM_LENGTH, msg.msgLength);
+
+  msg.podLengths[0] = 20;
+  msg.podLengths[2] = 30;
+  msg.generatePodBytes();
+  msg.updateMsgLength();
+  TEST_ASSERT_EQUAL(SBD_CM_LENGTH + 21 + 31, msg.msgLength);
+
+  // Pods that do not fit are left out of the length as well as the data
+  for (int i = 0; i < MAXPODS; i++)
+    msg.podLengths[i] = POD_LENGTH;
+  msg.generatePodBytes();
+  msg.updateMsgLength();
+  TEST_ASSERT_TRUE(msg.msgLength <= SBD_LENGTH);
+  TEST_ASSERT_EQUAL(SBD_CM_LENGTH + 4 * (POD_LENGTH + 1), msg.msgLength);
+
+  // A length beyond the pod buffer is cut to POD_LENGTH
+  for (int i = 0; i < MAXPODS; i++)
+    msg.podLengths[i] = 0;
+  msg.podLengths[1] = POD_LENGTH + 30;
+  msg.generatePodBytes();
+  msg.updateMsgLength();
+  TEST_ASSERT_EQUAL(POD_LENGTH, msg.getByte(SBD_CM_LENGTH));
+  TEST_ASSERT_EQUAL(SBD_CM_LENGTH + POD_LENGTH + 1, msg.msgLength);
+}
+
+SBDpipeline pipeline;
+
+void test_pipeline_frame() {
+  pipeline.attach_pod_request(pod_request);
+  pipeline.attach_pod_ready(pod_ready);
+  pipeline.attach_pod_collect(pod_collect);
+  pipeline.attach_gps(gps_snapshot);
+  pipeline.set_mission_ID(42);
+  pipeline.set_pod_timeout(100ms);
+  pipeline.set_max_frame_age(500ms);
+  pipeline.start();
+
+  SBDmessage *frame = pipeline.wait_for_frame(2s);
+  TEST_ASSERT_NOT_NULL(frame);
+  TEST_ASSERT_EQUAL(SBD_CM_LENGTH + 11, frame->msgLength);
+  TEST_ASSERT_EQUAL(1, frame->getByte(2) & 0x01);         // GPS fix
+  TEST_ASSERT_EQUAL(10, frame->getByte(SBD_CM_LENGTH));
+  TEST_ASSERT_TRUE(podRequests > 0);
+  TEST_ASSERT_TRUE(gpsReads > 0);
+  pipeline.release_frame(frame);
+  TEST_ASSERT_EQUAL(1, pipeline.frames_taken());
+}
+
+void test_pipeline_refresh() {
+  // A frame left waiting is rebuilt once it is older than the maximum age
+  SBDmessage *frame = pipeline.wait_for_frame(2s);
+  TEST_ASSERT_NOT_NULL(frame);
+  pipeline.release_frame(frame);
+  uint32_t refreshed = pipeline.frames_refreshed();
+  ThisThread::sleep_for(1200ms);
+  TEST_ASSERT_TRUE(pipeline.frames_refreshed() >= refreshed + 2);
+
+  uint32_t built = pipeline.frames_built();
+  pipeline.invalidate();
+  ThisThread::sleep_for(200ms);
+  TEST_ASSERT_TRUE(pipeline.frames_built() > built);
+}
+
+std::chrono::milliseconds untilWindow = 0ms;
+
+std::chrono::milliseconds next_session() {
+  return untilWindow;
+}
+
+void test_pipeline_session() {
+  // Before the session window the ready frame is kept, not rebuilt every maximum age
+  untilWindow = 3000ms;
+  pipeline.attach_next_session(next_session);
+  pipeline.invalidate();
+  ThisThread::sleep_for(300ms);
+  uint32_t built = pipeline.frames_built();
+  ThisThread::sleep_for(1200ms);
+  TEST_ASSERT_EQUAL(built, pipeline.frames_built());
+
+  // Once a session can start the maximum age applies again
+  untilWindow = 0ms;
+  pipeline.set_max_frame_age(500ms);
+  ThisThread::sleep_for(300ms);
+  TEST_ASSERT_TRUE(pipeline.frames_built() > built);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_msg_length);
+  RUN_TEST(test_pipeline_frame);
+  RUN_TEST(test_pipeline_refresh);
+  RUN_TEST(test_pipeline_session);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,137 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "SBDqueue.h"
+
+/* Outbound queue on the command module FRAM. Every test formats the queue
+ * region (0x0400-0x5C1F), so anything stored there is lost.
+ */
+
+I2C i2c(p9,p10);
+Cypress_FRAM fram(&i2c,0);
+SBDqueue queue(&fram);
+
+int push_message(char id, SBDPriority priority) {
+  char data[10];
+  memset(data, id, sizeof(data));
+  return queue.push(data, sizeof(data), priority);
+}
+
+void test_order() {
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.format());
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('b', SBD_PRIORITY_BULK));
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('r', SBD_PRIORITY_ROUTINE));
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('u', SBD_PRIORITY_URGENT));
+  TEST_ASSERT_EQUAL(3, queue.count());
+
+  char data[SBDQ_DATA_SIZE];
+  int slot = queue.next();
+  TEST_ASSERT_EQUAL(10, queue.read(slot, data, sizeof(data)));
+  TEST_ASSERT_EQUAL('u', data[0]);
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.mark_sent(slot));
+  slot = queue.next();
+  TEST_ASSERT_EQUAL(10, queue.read(slot, data, sizeof(data)));
+  TEST_ASSERT_EQUAL('r', data[0]);
+
+  // A buffer too small for the message is refused, not overrun
+  char small[4];
+  TEST_ASSERT_EQUAL(SBDQ_ERROR_TOO_LONG, queue.read(slot, small, sizeof(small)));
+  TEST_ASSERT_EQUAL(SBDQ_ERROR_TOO_LONG, queue.push(data, 0, SBD_PRIORITY_ROUTINE));
+}
+
+void test_evict_bulk() {
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.format());
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('b', SBD_PRIORITY_BULK));
+  for (int i = 1; i < SBDQ_MAX_SLOTS; i++)
+    TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('r', SBD_PRIORITY_ROUTINE));
+
+  // Bulk has nowhere to go once the only bulk entry is gone
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('r', SBD_PRIORITY_ROUTINE));
+  TEST_ASSERT_EQUAL(0, queue.count(SBD_PRIORITY_BULK));
+  TEST_ASSERT_EQUAL(1, queue.dropped());
+  TEST_ASSERT_EQUAL(SBDQ_ERROR_FULL, push_message('b', SBD_PRIORITY_BULK));
+  TEST_ASSERT_EQUAL(SBDQ_MAX_SLOTS, queue.count());
+}
+
+void test_coalesce_routine() {
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.format());
+  for (int i = 0; i < SBDQ_MAX_SLOTS; i++)
+    TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message(i, SBD_PRIORITY_ROUTINE));
+
+  // Track points are thinned to make room; the newest one is always kept
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message(SBDQ_MAX_SLOTS, SBD_PRIORITY_ROUTINE));
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('u', SBD_PRIORITY_URGENT));
+  TEST_ASSERT_EQUAL(2, queue.dropped());
+  TEST_ASSERT_EQUAL(SBDQ_MAX_SLOTS - 1, queue.count(SBD_PRIORITY_ROUTINE));
+  TEST_ASSERT_EQUAL(1, queue.count(SBD_PRIORITY_URGENT));
+
+  // The oldest points go first: 0 is kept and merged with its neighbor 1
+  char data[SBDQ_DATA_SIZE];
+  int slot = queue.next();
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.mark_sent(slot));     // urgent
+  slot = queue.next();
+  queue.read(slot, data, sizeof(data));
+  TEST_ASSERT_EQUAL(0, data[0]);
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.mark_sent(slot));
+  slot = queue.next();
+  queue.read(slot, data, sizeof(data));
+  TEST_ASSERT_EQUAL(2, data[0]);
+}
+
+void test_retry() {
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.format());
+  TEST_ASSERT_TRUE(queue.time_to_next() < 0ms);
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('r', SBD_PRIORITY_ROUTINE));
+  TEST_ASSERT_TRUE(queue.time_to_next() == 0ms);
+
+  // First retry after 30 s, then 60 s, each with +/- 25% jitter
+  int slot = queue.next();
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.mark_failed(slot));
+  TEST_ASSERT_EQUAL(-1, queue.next());
+  int wait = queue.time_to_next().count();
+  TEST_ASSERT_INT_WITHIN(7600, 30000, wait);
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.mark_failed(slot));
+  wait = queue.time_to_next().count();
+  TEST_ASSERT_INT_WITHIN(15100, 60000, wait);
+
+  // Backoff timers do not survive a reset
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.begin());
+  TEST_ASSERT_EQUAL(slot, queue.next());
+}
+
+void test_begin_frees_bad_slots() {
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.format());
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('a', SBD_PRIORITY_ROUTINE));
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('b', SBD_PRIORITY_ROUTINE));
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('c', SBD_PRIORITY_ROUTINE));
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, push_message('d', SBD_PRIORITY_ROUTINE));
+
+  uint16_t slot0 = SBDQ_SLOT_ADDRESS;
+  uint16_t slot1 = SBDQ_SLOT_ADDRESS + SBDQ_SLOT_SIZE;
+  uint16_t slot2 = SBDQ_SLOT_ADDRESS + 2 * SBDQ_SLOT_SIZE;
+  TEST_ASSERT_EQUAL(FRAM_SUCCESS, fram.write(slot0 + SBDQ_SLOT_HEADER_SIZE + 3, 'x'));  // data
+  TEST_ASSERT_EQUAL(FRAM_SUCCESS, fram.write(slot1 + 1, (char)7));                     // priority
+  TEST_ASSERT_EQUAL(FRAM_SUCCESS, fram.write_uint16(slot2 + 8, SBDQ_DATA_SIZE + 1));  // length
+
+  TEST_ASSERT_EQUAL(SBDQ_SUCCESS, queue.begin());
+  TEST_ASSERT_EQUAL(1, queue.count());
+  TEST_ASSERT_EQUAL(3, queue.dropped());
+  FRAM_Response_Read_Byte state = fram.read(slot0);
+  TEST_ASSERT_EQUAL(FRAM_SUCCESS, state.status);
+  TEST_ASSERT_NOT_EQUAL(SBDQ_SLOT_VALID, (uint8_t)state.data);
+
+  char data[SBDQ_DATA_SIZE];
+  TEST_ASSERT_EQUAL(10, queue.read(queue.next(), data, sizeof(data)));
+  TEST_ASSERT_EQUAL('d', data[0]);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_order);
+  RUN_TEST(test_evict_bulk);
+  RUN_TEST(test_coalesce_routine);
+  RUN_TEST(test_retry);
+  RUN_TEST(test_begin_frees_bad_slots);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
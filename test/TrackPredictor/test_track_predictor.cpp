@@ -0,0 +1,109 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "TrackPredictor.h"
+
+/* Dead reckoning through GPS outages, from synthetic fixes.
+ * The flight climbs at 5 m/s from 700 m with a 10 m/s east wind below
+ * 3000 m and a 20 m/s north wind above it.
+ */
+
+const time_t launchTime = 1623508200;
+
+GPSFix ascent_fix(int s) {
+  int32_t altitude = 700000 + s * 5000;
+  bool high = altitude >= 3000000;
+  GPSFix fix = {true, 10, launchTime + s, 477543000, -1174172000, altitude, -5000,
+    high ? 20000 : 10000, high ? 0 : 9000000};
+  return fix;
+}
+
+void test_ascent() {
+  TrackPredictor predictor;
+  GPSFix fix;
+  TEST_ASSERT_FALSE(predictor.predict(launchTime, fix));     // nothing learned yet
+
+  for (int s = 0; s <= 400; s += 10)
+    predictor.add(ascent_fix(s));         // last fix at 2700 m, still below the change
+  TEST_ASSERT_EQUAL(5000, predictor.vertical_rate());
+  int32_t north, east;
+  TEST_ASSERT_TRUE(predictor.wind(1000000, north, east));
+  TEST_ASSERT_INT_WITHIN(10, 10000, east);
+  TEST_ASSERT_FALSE(predictor.wind(5000000, north, east));
+
+  // 60 s later: 300 m higher and 600 m east (wind is the same up there)
+  TEST_ASSERT_TRUE(predictor.predict(launchTime + 460, fix));
+  TEST_ASSERT_FALSE(fix.positionFix);
+  TEST_ASSERT_EQUAL(0, fix.SIV);
+  TEST_ASSERT_TRUE(fix.syncTime == launchTime + 460);
+  TEST_ASSERT_INT_WITHIN(1000, 3000000, fix.altitudeMSL);
+  TEST_ASSERT_INT_WITHIN(10, 477543000, fix.latitude);
+  // 600 m east at 47.75 deg N is 0.0080169 deg
+  TEST_ASSERT_INT_WITHIN(100, -1174172000 + 80169, fix.longitude);
+  TEST_ASSERT_EQUAL(-5000, fix.verticalVelocity);
+  TEST_ASSERT_INT_WITHIN(10, 10000, fix.groundSpeed);
+  TEST_ASSERT_INT_WITHIN(100000, 9000000, fix.heading);
+
+  TEST_ASSERT_FALSE(predictor.predict(launchTime + 400 + TP_MAX_OUTAGE_S + 1, fix));
+  TEST_ASSERT_FALSE(predictor.predict(launchTime + 399, fix));
+}
+
+void test_descent() {
+  TrackPredictor predictor;
+  for (int s = 0; s <= 1000; s += 10)
+    predictor.add(ascent_fix(s));         // up to 5700 m
+
+  // Burst at 5700 m, then falling at 20 m/s with the north wind
+  GPSFix fix = ascent_fix(1000);
+  fix.verticalVelocity = 20000;
+  fix.syncTime = launchTime + 1010;
+  predictor.add(fix);
+  TEST_ASSERT_EQUAL(-20000, predictor.vertical_rate());   // restarted at burst
+
+  // Slower in thicker air: after 60 s less than 1200 m lower
+  GPSFix p;
+  TEST_ASSERT_TRUE(predictor.predict(launchTime + 1070, p));
+  TEST_ASSERT_TRUE(p.altitudeMSL > 5700000 - 1200000);
+  TEST_ASSERT_TRUE(p.altitudeMSL < 5700000 - 1000000);
+  TEST_ASSERT_TRUE(p.verticalVelocity < 20000);
+  TEST_ASSERT_TRUE(p.latitude > fix.latitude);             // drifting north
+
+  // Below 3000 m the east wind takes over, and the track stops at the ground
+  TEST_ASSERT_TRUE(predictor.predict(launchTime + 1010 + TP_MAX_OUTAGE_S, p));
+  TEST_ASSERT_EQUAL(700000, p.altitudeMSL);
+  TEST_ASSERT_EQUAL(0, p.verticalVelocity);
+  TEST_ASSERT_EQUAL(0, p.groundSpeed);
+  TEST_ASSERT_TRUE(p.longitude > fix.longitude);
+}
+
+void test_frame_flag() {
+  TrackPredictor predictor;
+  predictor.add(ascent_fix(0));
+  GPSFix fix;
+  TEST_ASSERT_TRUE(predictor.predict(launchTime + 30, fix));
+
+  SBDmessage msg;
+  msg.generatePredictedGPSBytes(fix);
+  TEST_ASSERT_EQUAL(0, msg.getByte(2) & 0x01);            // not a GPS fix
+  TEST_ASSERT_EQUAL(SBD_STATUS_EXTRAPOLATED, msg.getByte(36));
+
+  ReceiverHealthSummary health;
+  memset(&health, 0, sizeof(health));
+  health.samples = 1;
+  health.antStatus = 2;
+  msg.generateHealthBytes(health);                        // keeps the flag
+  TEST_ASSERT_EQUAL(SBD_STATUS_EXTRAPOLATED | 2, msg.getByte(36));
+
+  msg.clearMessage();
+  msg.generateGPSBytes(ascent_fix(0));
+  TEST_ASSERT_EQUAL(0, msg.getByte(36));
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_ascent);
+  RUN_TEST(test_descent);
+  RUN_TEST(test_frame_flag);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,253 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+#include "SBDmessage.h"
+#include "cypress_fm24w256.h"
+#include "ADT7410.h"
+#include "ZDU0110RFX.h"
+
+/* Microbenchmarks for the hot paths, timed with the DWT cycle counter.
+ *
+ * Every result is printed as one CSV line:
+ *    bench,<name>,<iterations>,<total cycles>,<cycles per iteration>
+ * tools/bench_report.py collects these lines from the test log and compares
+ * them with a saved baseline.
+ *
+ * FRAM and Zilog benchmarks include the I2C transactions, so they need the
+ * command module board (they are skipped if the device does not answer).
+ */
+
+#define BENCH_ITERATIONS 1000
+#define BENCH_IO_ITERATIONS 100
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+Cypress_FRAM fram(&i2c,0);
+ADT7410 tempSensor(&i2c, 0x90);
+Zilog_SerialBridge bridge(&i2c, 0);
+
+// One 1 Hz epoch of NEO-M8 output in its default NMEA configuration
+const char nmeaEpoch[] =
+  "$GNRMC,143000.00,A,4745.25800,N,11725.03200,W,14.021,87.32,120621,,,A*66\r\n"
+  "$GNVTG,87.32,T,,M,14.021,N,25.967,K,A*14\r\n"
+  "$GNGGA,143000.00,4745.25800,N,11725.03200,W,1,11,0.92,25600.0,M,-18.7,M,,*73\r\n"
+  "$GNGSA,A,3,02,05,12,13,15,18,20,25,29,,,,1.61,0.92,1.32*14\r\n"
+  "$GNGSA,A,3,67,68,77,,,,,,,,,,1.61,0.92,1.32*1E\r\n"
+  "$GPGSV,3,1,11,02,42,061,38,05,55,248,41,12,28,131,35,13,31,297,40*79\r\n"
+  "$GPGSV,3,2,11,15,65,192,44,18,22,094,33,20,11,316,29,25,14,046,31*7E\r\n"
+  "$GPGSV,3,3,11,29,45,156,42,30,03,228,,31,01,270,*49\r\n"
+  "$GLGSV,1,1,03,67,41,040,36,68,73,312,39,77,22,262,30*56\r\n"
+  "$GNGLL,4745.25800,N,11725.03200,W,143000.00,A,A*6F\r\n";
+
+uint8_t pvtPayload[92];
+uint8_t pvtFrame[100];
+
+void cycle_counter_start() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void bench_report(const char* name, int iterations, uint32_t cycles) {
+  printf("bench,%s,%d,%lu,%lu\n", name, iterations, (unsigned long)cycles,
+    (unsigned long)(cycles / iterations));
+}
+
+// Build a valid NAV-PVT frame (sync, header, payload, checksum)
+void build_pvt_frame() {
+  for (int i = 0; i < 92; i++)
+    pvtPayload[i] = (uint8_t)(i * 7);
+  pvtPayload[20] = 3; // 3D fix
+  ubxPacket packet = {UBX_CLASS_NAV, UBX_NAV_PVT, 92, 0, 0, pvtPayload, 0, 0, false};
+  gps.calcChecksum(&packet);
+  pvtFrame[0] = UBX_SYNCH_1;
+  pvtFrame[1] = UBX_SYNCH_2;
+  pvtFrame[2] = packet.cls;
+  pvtFrame[3] = packet.id;
+  pvtFrame[4] = packet.len & 0xFF;
+  pvtFrame[5] = packet.len >> 8;
+  memcpy(&pvtFrame[6], pvtPayload, 92);
+  pvtFrame[98] = packet.checksumA;
+  pvtFrame[99] = packet.checksumB;
+}
+
+void test_ubx_calc_checksum() {
+  ubxPacket packet = {UBX_CLASS_NAV, UBX_NAV_PVT, 92, 0, 0, pvtPayload, 0, 0, false};
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+    gps.calcChecksum(&packet);
+  uint32_t cycles = DWT->CYCCNT - start;
+  TEST_ASSERT_EQUAL_UINT8(pvtFrame[98], packet.checksumA);
+  bench_report("ubx_calcChecksum_92", BENCH_ITERATIONS, cycles);
+}
+
+void test_ubx_checksum_per_byte() {
+  // The byte at a time checksum that calcChecksum used before fletcherChecksum
+  volatile uint8_t *payload = pvtPayload;
+  uint8_t a = 0, b = 0;
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_ITERATIONS; i++) {
+    a = 0;
+    b = 0;
+    for (int j = 2; j < 6; j++) {
+      a += pvtFrame[j];
+      b += a;
+    }
+    for (int j = 0; j < 92; j++) {
+      a += payload[j];
+      b += a;
+    }
+  }
+  uint32_t cycles = DWT->CYCCNT - start;
+  TEST_ASSERT_EQUAL_UINT8(pvtFrame[98], a);
+  TEST_ASSERT_EQUAL_UINT8(pvtFrame[99], b);
+  bench_report("ubx_checksum_per_byte_92", BENCH_ITERATIONS, cycles);
+}
+
+void test_ubx_process_pvt() {
+  // process() runs processUBX and addToChecksum for every byte
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_IO_ITERATIONS; i++) {
+    for (int j = 0; j < 100; j++)
+      gps.process(pvtFrame[j]);
+  }
+  uint32_t cycles = DWT->CYCCNT - start;
+  bench_report("ubx_process_navpvt_frame", BENCH_IO_ITERATIONS, cycles);
+  bench_report("ubx_process_byte", BENCH_IO_ITERATIONS * 100, cycles);
+}
+
+void test_ubx_process_pvt_block() {
+  // process(data,len) as used by checkUbloxI2C: payload checksummed and copied as a block
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_IO_ITERATIONS; i++)
+    gps.process(pvtFrame, 100);
+  uint32_t cycles = DWT->CYCCNT - start;
+  bench_report("ubx_process_block_navpvt_frame", BENCH_IO_ITERATIONS, cycles);
+}
+
+void test_ubx_send_frame() {
+  // One I2C write per frame with the checksum computed while sending.
+  // NAV-PVT polls are harmless; the answers are drained afterwards.
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_IO_ITERATIONS; i++)
+    gps.sendFrame(UBX_CLASS_NAV, UBX_NAV_PVT, NULL, 0);
+  uint32_t cycles = DWT->CYCCNT - start;
+  bench_report("ubx_send_frame_poll", BENCH_IO_ITERATIONS, cycles);
+  ThisThread::sleep_for(2s);
+  gps.checkUblox();
+}
+
+void test_nmea_parse_epoch() {
+  // Parser alone, then the full path through process() (sentence detection, echo check, copy to the PVT fields)
+  NMEAParser parser;
+  const int len = sizeof(nmeaEpoch) - 1;
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_IO_ITERATIONS; i++) {
+    for (int j = 0; j < len; j++)
+      parser.process(nmeaEpoch[j]);
+  }
+  uint32_t cycles = DWT->CYCCNT - start;
+  TEST_ASSERT_EQUAL(5 * BENCH_IO_ITERATIONS, parser.sentences());
+  TEST_ASSERT_EQUAL(0, parser.checksum_errors());
+  TEST_ASSERT_EQUAL(477543000, parser.fix().latitude);
+  bench_report("nmea_parse_epoch", BENCH_IO_ITERATIONS, cycles);
+  bench_report("nmea_parse_byte", BENCH_IO_ITERATIONS * len, cycles);
+
+  start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_IO_ITERATIONS; i++)
+    gps.process((const uint8_t *)nmeaEpoch, len);
+  cycles = DWT->CYCCNT - start;
+  TEST_ASSERT_EQUAL(25600000, gps.getAltitudeMSL());
+  bench_report("ubx_process_nmea_epoch", BENCH_IO_ITERATIONS, cycles);
+}
+
+void test_sbd_encoding() {
+  SBDmessage msg;
+  GPSFix fix = {true, 12, 1623500000, 477543000, -1174172000, 25600000, -5000, 7200, 9000000};
+  volatile float v = 7.4f, ti = 21.5f, te = -40.25f;
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_ITERATIONS; i++) {
+    msg.generateGPSBytes(fix);
+    msg.generateCommandModuleBytes(v, ti, te, 80);
+  }
+  uint32_t cycles = DWT->CYCCNT - start;
+  TEST_ASSERT_EQUAL(fix.altitudeMSL / 1000, ((uint8_t)msg.getByte(15) << 8) | (uint8_t)msg.getByte(16));
+  bench_report("sbd_encode_gps_cm", BENCH_ITERATIONS, cycles);
+}
+
+// Raw values are 13-bit two's complement (bit 12 is the sign), so the inputs
+// cover both branches of the conversion
+void test_adt7410_conversion() {
+  volatile float t = 0;
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+    t = tempSensor.temperatureconversion((uint16_t)((i * 13) & 0x1FFF));
+  uint32_t cycles = DWT->CYCCNT - start;
+  int last = ((BENCH_ITERATIONS - 1) * 13) & 0x1FFF;
+  if (last & 0x1000)
+    last -= 0x2000;
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, last / 16.0f, t);
+  bench_report("adt7410_temperatureconversion", BENCH_ITERATIONS, cycles);
+}
+
+void test_fram_read_write() {
+  char data[32];
+  for (int i = 0; i < 32; i++)
+    data[i] = i;
+  if (fram.write(0x7F00, data, 32) != FRAM_SUCCESS)
+    TEST_IGNORE_MESSAGE("FRAM not present");
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_IO_ITERATIONS; i++)
+    fram.write(0x7F00, data, 32);
+  uint32_t cycles = DWT->CYCCNT - start;
+  bench_report("fram_write_32", BENCH_IO_ITERATIONS, cycles);
+
+  start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_IO_ITERATIONS; i++)
+    fram.read(0x7F00, data, 32);
+  cycles = DWT->CYCCNT - start;
+  TEST_ASSERT_EQUAL_INT8(31, data[31]);
+  bench_report("fram_read_32", BENCH_IO_ITERATIONS, cycles);
+}
+
+void test_zilog_register_access() {
+  // Register reads go through reg_for_uart plus one I2C write/read pair
+  if (bridge.get_baud(0) == 0)
+    TEST_IGNORE_MESSAGE("Zilog serial bridge not present");
+  cycle_counter_start();
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < BENCH_IO_ITERATIONS; i++)
+    bridge.get_tx_watermark(i & 1);
+  uint32_t cycles = DWT->CYCCNT - start;
+  bench_report("zilog_get_tx_watermark", BENCH_IO_ITERATIONS, cycles);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  build_pvt_frame();
+  printf("bench,name,iterations,cycles,cycles_per_iteration\n");
+  UNITY_BEGIN();
+  RUN_TEST(test_ubx_calc_checksum);
+  RUN_TEST(test_ubx_checksum_per_byte);
+  RUN_TEST(test_ubx_process_pvt);
+  RUN_TEST(test_ubx_process_pvt_block);
+  RUN_TEST(test_ubx_send_frame);
+  RUN_TEST(test_nmea_parse_epoch);
+  RUN_TEST(test_sbd_encoding);
+  RUN_TEST(test_adt7410_conversion);
+  RUN_TEST(test_fram_read_write);
+  RUN_TEST(test_zilog_register_access);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,133 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+
+/* Equivalence of the block Fletcher checksum (fletcherChecksum, process(data,len))
+ * with the original byte at a time version. Runs without a GPS attached.
+ */
+
+I2C i2c(p9,p10);
+
+uint8_t data[MAX_PAYLOAD_SIZE + 8];
+
+// The original per-byte checksum (calcChecksum/addToChecksum before the block version)
+void reference_checksum(const uint8_t *d, uint16_t len, uint8_t &a, uint8_t &b) {
+  for (uint16_t i = 0; i < len; i++) {
+    a += d[i];
+    b += a;
+  }
+}
+
+void fill_data(uint32_t seed) {
+  for (unsigned int i = 0; i < sizeof(data); i++) {
+    seed = seed * 1664525 + 1013904223;
+    data[i] = seed >> 24;
+  }
+}
+
+// Every length up to MAX_PAYLOAD_SIZE at every alignment
+void test_all_lengths_and_alignments() {
+  fill_data(1);
+  for (uint16_t len = 0; len <= MAX_PAYLOAD_SIZE; len++) {
+    for (int offset = 0; offset < 4; offset++) {
+      uint8_t refA = 0, refB = 0, a = 0, b = 0;
+      reference_checksum(&data[offset], len, refA, refB);
+      Ublox_GPS::fletcherChecksum(&data[offset], len, a, b);
+      TEST_ASSERT_EQUAL_UINT8(refA, a);
+      TEST_ASSERT_EQUAL_UINT8(refB, b);
+    }
+  }
+}
+
+// Every starting (A, B) pair, as seen when a block continues a rolling checksum
+void test_all_starting_values() {
+  fill_data(2);
+  for (uint32_t start = 0; start < 0x10000; start++) {
+    uint8_t refA = start & 0xFF, refB = start >> 8;
+    uint8_t a = refA, b = refB;
+    reference_checksum(data, 13, refA, refB);
+    Ublox_GPS::fletcherChecksum(data, 13, a, b);
+    TEST_ASSERT_EQUAL_UINT8(refA, a);
+    TEST_ASSERT_EQUAL_UINT8(refB, b);
+  }
+}
+
+// Every byte value repeated over a full payload (largest accumulator values)
+void test_all_byte_values() {
+  for (int value = 0; value < 256; value++) {
+    memset(data, value, sizeof(data));
+    uint8_t refA = 0, refB = 0, a = 0, b = 0;
+    reference_checksum(data, sizeof(data), refA, refB);
+    Ublox_GPS::fletcherChecksum(data, sizeof(data), a, b);
+    TEST_ASSERT_EQUAL_UINT8(refA, a);
+    TEST_ASSERT_EQUAL_UINT8(refB, b);
+  }
+}
+
+// Block is the same as running it in two pieces split anywhere
+void test_incremental_split() {
+  fill_data(3);
+  uint8_t refA = 0, refB = 0;
+  reference_checksum(data, 200, refA, refB);
+  for (uint16_t split = 0; split <= 200; split++) {
+    uint8_t a = 0, b = 0;
+    Ublox_GPS::fletcherChecksum(data, split, a, b);
+    Ublox_GPS::fletcherChecksum(&data[split], 200 - split, a, b);
+    TEST_ASSERT_EQUAL_UINT8(refA, a);
+    TEST_ASSERT_EQUAL_UINT8(refB, b);
+  }
+}
+
+// A NAV-PVT frame fed through process(data,len) in two reads split at every
+// position is accepted; with one payload byte changed it is rejected
+void test_stream_split() {
+  uint8_t payload[92];
+  uint8_t frame[100];
+  fill_data(4);
+  memcpy(payload, data, 92);
+  payload[20] = 3; // 3D fix
+  ubxPacket packet = {UBX_CLASS_NAV, UBX_NAV_PVT, 92, 0, 0, payload, 0, 0, false};
+  Ublox_GPS gps(&i2c);
+  gps.calcChecksum(&packet);
+  frame[0] = UBX_SYNCH_1;
+  frame[1] = UBX_SYNCH_2;
+  frame[2] = UBX_CLASS_NAV;
+  frame[3] = UBX_NAV_PVT;
+  frame[4] = 92;
+  frame[5] = 0;
+  memcpy(&frame[6], payload, 92);
+  frame[98] = packet.checksumA;
+  frame[99] = packet.checksumB;
+
+  uint8_t refA = 0, refB = 0;
+  reference_checksum(&frame[2], 96, refA, refB);
+  TEST_ASSERT_EQUAL_UINT8(refA, frame[98]);
+  TEST_ASSERT_EQUAL_UINT8(refB, frame[99]);
+
+  int32_t expected = payload[28] | payload[29] << 8 | payload[30] << 16 | payload[31] << 24;
+  for (int split = 0; split <= 100; split++) {
+    Ublox_GPS parser(&i2c);
+    parser.latitude = expected + 1;
+    parser.process(frame, split);
+    parser.process(&frame[split], 100 - split);
+    TEST_ASSERT_EQUAL_INT32(expected, parser.latitude);
+  }
+
+  frame[50] ^= 0x01;
+  Ublox_GPS parser(&i2c);
+  parser.latitude = expected + 1;
+  parser.process(frame, 100);
+  TEST_ASSERT_EQUAL_INT32(expected + 1, parser.latitude);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_all_lengths_and_alignments);
+  RUN_TEST(test_all_starting_values);
+  RUN_TEST(test_all_byte_values);
+  RUN_TEST(test_incremental_split);
+  RUN_TEST(test_stream_split);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
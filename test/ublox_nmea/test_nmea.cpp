@@ -0,0 +1,168 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+#include "NMEAParser.h"
+
+/* NMEA fallback parsing.
+ * Everything except the last test runs without hardware. The last test
+ * turns UBX output off on the I2C port, reads a position from NMEA alone
+ * and then restores UBX output.
+ */
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+
+const char *gga = "$GNGGA,143000.50,4745.25800,N,11725.03200,W,1,11,0.92,25600.0,M,-18.7,M,,*76\r\n";
+const char *rmc = "$GNRMC,143000.00,A,4745.25800,N,11725.03200,W,14.021,87.32,120621,,,A*66\r\n";
+const char *vtg = "$GNVTG,87.32,T,,M,14.021,N,25.967,K,A*14\r\n";
+const char *gsa = "$GNGSA,A,3,02,05,12,13,15,18,20,25,29,,,,1.61,0.92,1.32*14\r\n";
+
+uint8_t feed(NMEAParser &parser, const char *s) {
+  uint8_t result = 0;
+  while (*s)
+    result |= parser.process(*s++);
+  return result;
+}
+
+void test_parse_decimal() {
+  int64_t v;
+  TEST_ASSERT_TRUE(NMEAParser::parse_decimal("25600.0", 7, 3, v));
+  TEST_ASSERT_EQUAL(25600000, v);
+  TEST_ASSERT_TRUE(NMEAParser::parse_decimal("-18.7", 5, 3, v));
+  TEST_ASSERT_EQUAL(-18700, v);
+  TEST_ASSERT_TRUE(NMEAParser::parse_decimal("1.23456", 7, 2, v));
+  TEST_ASSERT_EQUAL(123, v);
+  TEST_ASSERT_FALSE(NMEAParser::parse_decimal("", 0, 2, v));
+  TEST_ASSERT_FALSE(NMEAParser::parse_decimal("1.2.3", 5, 2, v));
+  TEST_ASSERT_FALSE(NMEAParser::parse_decimal("-", 1, 0, v));
+
+  int32_t c;
+  TEST_ASSERT_TRUE(NMEAParser::parse_coordinate("4745.25800", 10, c));
+  TEST_ASSERT_EQUAL(477543000, c);
+  TEST_ASSERT_TRUE(NMEAParser::parse_coordinate("11725.03200", 11, c));
+  TEST_ASSERT_EQUAL(1174172000, c);
+  TEST_ASSERT_FALSE(NMEAParser::parse_coordinate("4765.00000", 10, c));
+}
+
+void test_sentences() {
+  NMEAParser parser;
+  TEST_ASSERT_EQUAL(NMEA_GGA, feed(parser, gga));
+  const NMEAFix &fix = parser.fix();
+  TEST_ASSERT_TRUE(fix.timeValid);
+  TEST_ASSERT_EQUAL(14, fix.hour);
+  TEST_ASSERT_EQUAL(30, fix.minute);
+  TEST_ASSERT_EQUAL(0, fix.second);
+  TEST_ASSERT_EQUAL(500, fix.millisecond);
+  TEST_ASSERT_TRUE(fix.positionValid);
+  TEST_ASSERT_EQUAL(477543000, fix.latitude);
+  TEST_ASSERT_EQUAL(-1174172000, fix.longitude);
+  TEST_ASSERT_EQUAL(25600000, fix.altitudeMSL);
+  TEST_ASSERT_EQUAL(-18700, fix.geoidSeparation);
+  TEST_ASSERT_EQUAL(11, fix.SIV);
+  TEST_ASSERT_EQUAL(92, fix.hDOP);
+
+  TEST_ASSERT_EQUAL(NMEA_RMC, feed(parser, rmc));
+  TEST_ASSERT_TRUE(fix.dateValid);
+  TEST_ASSERT_EQUAL(2021, fix.year);
+  TEST_ASSERT_EQUAL(6, fix.month);
+  TEST_ASSERT_EQUAL(12, fix.day);
+  TEST_ASSERT_EQUAL(7213, fix.groundSpeed);   // 14.021 knots
+  TEST_ASSERT_EQUAL(8732000, fix.heading);
+
+  TEST_ASSERT_EQUAL(NMEA_VTG, feed(parser, vtg));
+  TEST_ASSERT_EQUAL(7213, fix.groundSpeed);   // 25.967 km/h
+
+  TEST_ASSERT_EQUAL(NMEA_GSA, feed(parser, gsa));
+  TEST_ASSERT_EQUAL(3, fix.fixType);
+  TEST_ASSERT_EQUAL(161, fix.pDOP);
+  TEST_ASSERT_EQUAL(132, fix.vDOP);
+  TEST_ASSERT_EQUAL(4, parser.sentences());
+}
+
+void test_bad_checksum() {
+  NMEAParser parser;
+  feed(parser, gga);
+  // One digit of the altitude changed, checksum left alone
+  TEST_ASSERT_EQUAL(0, feed(parser, "$GNGGA,143001.00,4745.25800,N,11725.03200,W,1,11,0.92,25699.0,M,-18.7,M,,*73\r\n"));
+  TEST_ASSERT_EQUAL(1, parser.checksum_errors());
+  TEST_ASSERT_EQUAL(25600000, parser.fix().altitudeMSL);
+  // Unknown types, missing checksums and a sentence cut short by another are ignored
+  TEST_ASSERT_EQUAL(0, feed(parser, "$GPGSV,1,1,01,02,42,061,38*40\r\n"));
+  TEST_ASSERT_EQUAL(0, feed(parser, "$GNVTG,87.32,T,,M,14.021,N,25.967,K,A\r\n"));
+  TEST_ASSERT_EQUAL(NMEA_VTG, feed(parser, "$GNGGA,1430$GNVTG,87.32,T,,M,14.021,N,25.967,K,A*14\r\n"));
+  TEST_ASSERT_EQUAL(2, parser.sentences());
+}
+
+void test_empty_fields() {
+  NMEAParser parser;
+  feed(parser, gga);
+  // Receiver lost the fix: position fields are empty
+  TEST_ASSERT_EQUAL(NMEA_RMC, feed(parser, "$GNRMC,143005.00,V,,,,,,,120621,,,N*66\r\n"));
+  TEST_ASSERT_FALSE(parser.fix().positionValid);
+  TEST_ASSERT_EQUAL(477543000, parser.fix().latitude);
+  TEST_ASSERT_EQUAL(5, parser.fix().second);
+}
+
+void test_ublox_fields() {
+  // Characters arriving through process() land in the NAV-PVT fields, so no poll is needed
+  gps.process((const uint8_t *)gga, strlen(gga));
+  gps.process((const uint8_t *)rmc, strlen(rmc));
+  gps.process((const uint8_t *)gsa, strlen(gsa));
+  TEST_ASSERT_EQUAL(477543000, gps.getLatitude(0));
+  TEST_ASSERT_EQUAL(-1174172000, gps.getLongitude(0));
+  TEST_ASSERT_EQUAL(25600000, gps.getAltitudeMSL(0));
+  TEST_ASSERT_EQUAL(25600000 - 18700, gps.getAltitude(0));
+  TEST_ASSERT_EQUAL(11, gps.getSIV(0));
+  TEST_ASSERT_EQUAL(3, gps.getFixType(0));
+  TEST_ASSERT_EQUAL(7213, gps.getGroundSpeed(0));
+  TEST_ASSERT_EQUAL(2021, gps.getYear(0));
+  TEST_ASSERT_EQUAL(161, gps.getPDOP(0));
+}
+
+void test_lost_fix() {
+  // Quality 0 and status V with the last position still filled in
+  const char *ggaLost = "$GNGGA,143010.00,4746.00000,N,11726.00000,W,0,00,99.99,25000.0,M,-18.7,M,,*40\r\n";
+  const char *rmcLost = "$GNRMC,143010.00,V,4746.00000,N,11726.00000,W,0.010,,120621,,,N*66\r\n";
+  gps.process((const uint8_t *)gga, strlen(gga));
+  gps.process((const uint8_t *)rmc, strlen(rmc));
+  gps.process((const uint8_t *)gsa, strlen(gsa));
+  gps.process((const uint8_t *)ggaLost, strlen(ggaLost));
+  TEST_ASSERT_EQUAL(0, gps.getFixType(0));
+  TEST_ASSERT_EQUAL(0, gps.getSIV(0));
+  TEST_ASSERT_EQUAL(477543000, gps.getLatitude(0));
+  TEST_ASSERT_EQUAL(25600000, gps.getAltitudeMSL(0));
+  gps.process((const uint8_t *)rmcLost, strlen(rmcLost));
+  TEST_ASSERT_EQUAL(-1174172000, gps.getLongitude(0));
+  TEST_ASSERT_EQUAL(7213, gps.getGroundSpeed(0));
+  TEST_ASSERT_EQUAL(10, gps.getSecond(0));
+}
+
+void test_nmea_only_receiver() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  TEST_ASSERT_TRUE(gps.setI2COutput(COM_TYPE_NMEA));
+  uint32_t before = gps.getNMEASentences();
+  Timer t;
+  t.start();
+  while ((gps.getNMEASentences() - before < 4) && (t.elapsed_time() < 3s)) {
+    gps.checkUblox();
+    ThisThread::sleep_for(100ms);
+  }
+  TEST_ASSERT_TRUE(gps.getNMEASentences() - before >= 4);
+  TEST_ASSERT_EQUAL(0, gps.getNMEAChecksumErrors());
+  TEST_ASSERT_TRUE(gps.setI2COutput(COM_TYPE_UBX));
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_parse_decimal);
+  RUN_TEST(test_sentences);
+  RUN_TEST(test_bad_checksum);
+  RUN_TEST(test_empty_fields);
+  RUN_TEST(test_ublox_fields);
+  RUN_TEST(test_lost_fix);
+  RUN_TEST(test_nmea_only_receiver);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
@@ -0,0 +1,426 @@
+// Generated by tools/ublox_emulator.py --rate 2 --duration 20 --quirk-7f 0.05 --quirk-bit15 0.05 --corrupt 0.05 --header ../test/ublox_replay/replay_stream.h
+// Do not edit; regenerate after changing the emulator or the driver
+
+#define REPLAY_CHUNKS 41
+#define REPLAY_FRAMES 75
+#define REPLAY_CHECKSUM_ERRORS 7
+
+const uint8_t replayStream[5938] = {
+  0xB5, 0x62, 0x05, 0x01, 0x02, 0x00, 0x06, 0x00, 0x0E, 0x37, 0xB5, 0x62, 0x0A, 0x04, 0xA0, 0x00,
+  0x52, 0x4F, 0x4D, 0x20, 0x53, 0x50, 0x47, 0x20, 0x34, 0x2E, 0x30, 0x34, 0x20, 0x28, 0x65, 0x6D,
+  0x75, 0x6C, 0x61, 0x74, 0x65, 0x64, 0x29, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30,
+  0x31, 0x39, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x46, 0x57, 0x56, 0x45, 0x52, 0x3D, 0x53, 0x50,
+  0x47, 0x20, 0x34, 0x2E, 0x30, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x52, 0x4F, 0x54, 0x56, 0x45, 0x52, 0x3D, 0x32, 0x37,
+  0x2E, 0x31, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x4D, 0x4F, 0x44, 0x3D, 0x5A, 0x45, 0x44, 0x2D, 0x46, 0x39, 0x50, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x47, 0x50, 0x53, 0x3B, 0x47, 0x4C, 0x4F, 0x3B, 0x47, 0x41, 0x4C, 0x3B, 0x42, 0x44,
+  0x53, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xFD, 0x6B, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x00, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0xA0, 0x8E, 0x03, 0xBA, 0x58, 0xBA, 0x76, 0x1C, 0x10, 0x6E, 0x09, 0x00, 0xC0, 0x27, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xEF, 0x00, 0x00, 0x00, 0xE0, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xE5, 0x15, 0x00, 0x00, 0xF0, 0x97, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xE5, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xA0, 0x8E, 0x03, 0xBA, 0x58, 0xBA, 0x76, 0x1C, 0x10, 0x6E, 0x09, 0x00,
+  0xC0, 0x27, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x24, 0x72, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xF4, 0x01, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x00, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x17, 0x90, 0x03, 0xBA, 0x62, 0xBA, 0x76, 0x1C, 0xD4, 0x77, 0x09, 0x00, 0x84, 0x31, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF0, 0x00, 0x00, 0x00, 0xE2, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xE7, 0x15, 0x00, 0x00, 0x68, 0x94, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x8D, 0x26, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xF4, 0x01, 0x00, 0x00, 0x17, 0x90, 0x03, 0xBA, 0x62, 0xBA, 0x76, 0x1C, 0xD4, 0x77, 0x09, 0x00,
+  0x84, 0x31, 0x09, 0x00, 0xB9, 0x50, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x40, 0x28, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xE8, 0x03, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x01, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x8D, 0x91, 0x03, 0xBA, 0x6D, 0xBA, 0x76, 0x1C, 0x98, 0x81, 0x09, 0x00, 0x48, 0x3B, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF1, 0x00, 0x00, 0x00, 0xE5, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xEA, 0x15, 0x00, 0x00, 0xE0, 0x90, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x1D, 0x35, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xE8, 0x03, 0x00, 0x00, 0x8D, 0x91, 0x03, 0xBA, 0x6D, 0xBA, 0x76, 0x1C, 0x98, 0x81, 0x09, 0x00,
+  0x48, 0x3B, 0x09, 0x00, 0xF7, 0x45, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x87, 0x44, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xDC, 0x05, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x01, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x04, 0x93, 0x03, 0xBA, 0x78, 0xBA, 0x76, 0x1C, 0x5C, 0x8B, 0x09, 0x00, 0x0C, 0x45, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF2, 0x00, 0x00, 0x00, 0xE7, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xEC, 0x15, 0x00, 0x00, 0x5A, 0x8D, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xAF, 0x84, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xDC, 0x05, 0x00, 0x00, 0x04, 0x93, 0x03, 0xBA, 0x78, 0xBA, 0x76, 0x1C, 0x5C, 0x8B, 0x09, 0x00,
+  0x0C, 0x45, 0x09, 0x00, 0xF3, 0x42, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x96, 0xD7, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xD0, 0x07, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x02, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x7C, 0x94, 0x03, 0xBA, 0x83, 0xBA, 0x76, 0x0C, 0x20, 0x95, 0x09, 0x00, 0xD0, 0x4E, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF3, 0x00, 0x00, 0x00, 0xEA, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xEF, 0x15, 0x00, 0x00, 0xD4, 0x89, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x42, 0x1C, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xD0, 0x07, 0x00, 0x00, 0x7C, 0x94, 0x03, 0xBA, 0x83, 0xBA, 0x76, 0x1C, 0x20, 0x95, 0x09, 0x00,
+  0xD0, 0x4E, 0x09, 0x00, 0xAC, 0x49, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x6B, 0xA6, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xC4, 0x09, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x02, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0xF3, 0x95, 0x03, 0xBA, 0x8E, 0xBA, 0x76, 0x1C, 0xE4, 0x9E, 0x09, 0x00, 0x94, 0x58, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF4, 0x00, 0x00, 0x00, 0xEC, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xF1, 0x15, 0x00, 0x00, 0x4F, 0x86, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xD3, 0x09, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xF3, 0x95, 0x03, 0xBA, 0x8E, 0xBA, 0x76, 0x1C, 0xE4, 0x9E, 0x09, 0x00,
+  0x94, 0x58, 0x09, 0x00, 0xEB, 0x58, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xCD, 0xF5, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xB8, 0x0B, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x03, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x6B, 0x97, 0x03, 0xBA, 0x9A, 0xBA, 0x76, 0x1C, 0xA8, 0xA8, 0x09, 0x00, 0x58, 0x62, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF5, 0x00, 0x00, 0x00, 0xEF, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xF4, 0x15, 0x00, 0x00, 0xCB, 0x82, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x6B, 0x93, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xB8, 0x0B, 0x00, 0x00, 0x6B, 0x97, 0x03, 0xBA, 0x9A, 0xBA, 0x76, 0x1C, 0xA8, 0xA8, 0x09, 0x00,
+  0x58, 0x62, 0x09, 0x00, 0xE7, 0x0D, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x96, 0xA4, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xAC, 0x0D, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x03, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0xE4, 0x98, 0x03, 0xBA, 0xA5, 0xBA, 0x76, 0x1C, 0x6C, 0xB2, 0x09, 0x00, 0x1C, 0x6C, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF6, 0x00, 0x00, 0x00, 0xF1, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xF6, 0x15, 0x00, 0x00, 0x48, 0x7F, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x01, 0x7B, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xAC, 0x0D, 0x00, 0x00, 0xE4, 0x98, 0x03, 0xBA, 0xA5, 0xBA, 0x76, 0x1C, 0x6C, 0xB2, 0x09, 0x00,
+  0x1C, 0x6C, 0x09, 0x00, 0xA1, 0x2E, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x88, 0xC8, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x04, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x5C, 0x9A, 0x03, 0xBA, 0xB0, 0xBA, 0x76, 0x1C, 0x30, 0xBC, 0x09, 0x00, 0xE0, 0x75, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF7, 0x00, 0x00, 0x00, 0xF4, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xF9, 0x15, 0x00, 0x00, 0xC6, 0x7B, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x99, 0xC6, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xA0, 0x0F, 0x00, 0x00, 0x5C, 0x9A, 0x03, 0xBA, 0xB0, 0xBA, 0x76, 0x1C, 0x30, 0xBC, 0x09, 0x00,
+  0xE0, 0x75, 0x09, 0x00, 0xDF, 0x58, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x06, 0x6F, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x94, 0x11, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x04, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0xD5, 0x9B, 0x03, 0xBA, 0xBC, 0xBA, 0x76, 0x1C, 0xF4, 0xC5, 0x09, 0x00, 0xA4, 0x7F, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0xF6, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xFB, 0x15, 0x00, 0x00, 0x45, 0x78, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x31, 0xEB, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x94, 0x11, 0x00, 0x00, 0xD5, 0x9B, 0x03, 0xBA, 0xBC, 0xBA, 0x76, 0x1C, 0xF4, 0xC5, 0x09, 0x00,
+  0xA4, 0x7F, 0x09, 0x00, 0xDC, 0x28, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xEA, 0x41, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x88, 0x13, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x05, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x4E, 0x9D, 0x03, 0xBA, 0xC7, 0xBA, 0x76, 0x1C, 0xB8, 0xCF, 0x09, 0x00, 0x68, 0x89, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xF9, 0x00, 0x00, 0x00, 0xF9, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0xFE, 0x15, 0x00, 0x00, 0xC4, 0x74, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xCC, 0xCD, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x88, 0x13, 0x00, 0x00, 0x4E, 0x9D, 0x03, 0xBA, 0xC7, 0xBA, 0x76, 0x1C, 0xB8, 0xCF, 0x09, 0x00,
+  0x68, 0x89, 0x09, 0x00, 0xF9, 0x63, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x5A, 0x42, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x7C, 0x15, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x05, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0xC8, 0x9E, 0x03, 0xBA, 0xD3, 0xBA, 0x76, 0x1C, 0x7C, 0xD9, 0x09, 0x00, 0x2C, 0x93, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xFA, 0x00, 0x00, 0x00, 0xFB, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x01, 0x16, 0x00, 0x00, 0x45, 0x71, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x6A, 0xE8, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x7C, 0x15, 0x00, 0x00, 0xC8, 0x9E, 0x03, 0xBA, 0xD3, 0xBA, 0x76, 0x1C, 0x7C, 0xD9, 0x09, 0x00,
+  0x2C, 0x93, 0x09, 0x00, 0xD4, 0x45, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x30, 0x71, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x70, 0x17, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x06, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x42, 0xA0, 0x03, 0xBA, 0xDF, 0xBA, 0x76, 0x1C, 0x40, 0xE3, 0x09, 0x00, 0xF0, 0x9C, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xFB, 0x00, 0x00, 0x00, 0xFE, 0x15, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x03, 0x16, 0x00, 0x00, 0xC6, 0x6D, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x07, 0x2F, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x70, 0x17, 0x00, 0x00, 0x42, 0xA0, 0x03, 0xBA, 0xDF, 0xBA, 0x76, 0x1C, 0x40, 0xE3, 0x09, 0x00,
+  0xE0, 0x9C, 0x09, 0x00, 0xD1, 0x2F, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x30, 0x9C, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x64, 0x19, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x06, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0xBC, 0xA1, 0x03, 0xBA, 0xEB, 0xBA, 0x76, 0x1C, 0x04, 0xED, 0x09, 0x00, 0xB4, 0xA6, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x06, 0x16, 0x00, 0x00, 0x48, 0x6A, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xA6, 0x6E, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x64, 0x19, 0x00, 0x00, 0xBC, 0xA1, 0x03, 0xBA, 0xEB, 0xBA, 0x76, 0x1C, 0x04, 0xED, 0x09, 0x00,
+  0xB4, 0xA6, 0x09, 0x00, 0xEF, 0x21, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x59, 0x9F, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x58, 0x1B, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x07, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x37, 0xA3, 0x03, 0xBA, 0xF7, 0xBA, 0x76, 0x1C, 0xC8, 0xF6, 0x09, 0x00, 0x78, 0xB0, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xFD, 0x00, 0x00, 0x00, 0x03, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x08, 0x16, 0x00, 0x00, 0xCB, 0x66, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x46, 0x2D, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x58, 0x1B, 0x00, 0x00, 0x37, 0xA3, 0x03, 0xBA, 0xF7, 0xBA, 0x76, 0x1C, 0xC8, 0xF6, 0x09, 0x00,
+  0x78, 0xB0, 0x09, 0x00, 0xCA, 0x1D, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x4A, 0x10, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x4C, 0x1D, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x07, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0xB2, 0xA4, 0x03, 0xBA, 0x03, 0xBB, 0x76, 0x1C, 0x8C, 0x00, 0x0A, 0x00, 0x3C, 0xBA, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xFE, 0x00, 0x00, 0x00, 0x05, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x0B, 0x16, 0x00, 0x00, 0x4F, 0x63, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xE9, 0x3A, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x4C, 0x1D, 0x00, 0x00, 0xB2, 0xA4, 0x03, 0xBA, 0x03, 0xBB, 0x76, 0x1C, 0x8C, 0x00, 0x0A, 0x00,
+  0x3C, 0xBA, 0x09, 0x00, 0xC6, 0x22, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x67, 0x91, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x40, 0x1F, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x08, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x2D, 0xA6, 0x03, 0xBA, 0x0F, 0xBB, 0x76, 0x1C, 0x50, 0x0A, 0x0A, 0x00, 0x00, 0xC4, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x08, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x0D, 0x16, 0x00, 0x00, 0xD4, 0x5F, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x8C, 0x6C, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x40, 0x1F, 0x00, 0x00, 0x2D, 0xA6, 0x03, 0xBA, 0x0F, 0xBB, 0x76, 0x1C, 0x50, 0x0A, 0x0A, 0x00,
+  0x00, 0xC4, 0x09, 0x00, 0xE5, 0x2F, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xAE, 0x00, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x34, 0x21, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x08, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0xA9, 0xA7, 0x03, 0xBA, 0x1B, 0xBB, 0x76, 0x1C, 0x14, 0x14, 0x0A, 0x00, 0xC4, 0xCD, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x0A, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x10, 0x16, 0x00, 0x00, 0x5A, 0x5C, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x30, 0x70, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x34, 0x21, 0x00, 0x00, 0xA9, 0xA7, 0x03, 0xBA, 0x1B, 0xBB, 0x76, 0x1C, 0x14, 0x14, 0x0A, 0x00,
+  0xC4, 0xCD, 0x09, 0x00, 0xC0, 0x46, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xBA, 0x9F, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x28, 0x23, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x09, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x25, 0xA9, 0x03, 0xBA, 0x28, 0xBB, 0x76, 0x1C, 0xD8, 0x1D, 0x0A, 0x00, 0x88, 0xD7, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x0D, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x12, 0x16, 0x00, 0x00, 0xE0, 0x58, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xD5, 0x07, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x28, 0x23, 0x00, 0x00, 0x25, 0xA9, 0x03, 0xBA, 0x28, 0xBB, 0x76, 0x1C, 0xD8, 0x1D, 0x0A, 0x00,
+  0x88, 0xD7, 0x09, 0x00, 0xBD, 0x01, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x8E, 0x11, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x1C, 0x25, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x09, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0xA1, 0xAA, 0x03, 0xBA, 0x34, 0xBB, 0x76, 0x1C, 0x9C, 0x27, 0x0A, 0x00, 0x4C, 0xF1, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x0F, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x15, 0x16, 0x00, 0x00, 0x68, 0x55, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x7B, 0x4F, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x1C, 0x25, 0x00, 0x00, 0xA1, 0xAA, 0x03, 0xBA, 0x34, 0xBB, 0x76, 0x1C, 0x9C, 0x27, 0x0A, 0x00,
+  0x4C, 0xE1, 0x09, 0x00, 0xDB, 0x29, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xEF, 0x9E, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x10, 0x27, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0A, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x1E, 0xAC, 0x03, 0xBA, 0x40, 0xBB, 0x76, 0x1C, 0x60, 0x31, 0x0A, 0x00, 0x10, 0xEB, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x03, 0x01, 0x00, 0x00, 0x12, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x17, 0x16, 0x00, 0x00, 0xF0, 0x51, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x23, 0x5D, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x10, 0x27, 0x00, 0x00, 0x1E, 0xAC, 0x03, 0xBA, 0x40, 0xBB, 0x76, 0x1C, 0x60, 0x31, 0x0A, 0x00,
+  0x10, 0xEB, 0x09, 0x00, 0xB7, 0x5A, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x19, 0xAD, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x04, 0x29, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0A, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x9B, 0xAD, 0x03, 0xBA, 0x4D, 0xBB, 0x76, 0x1C, 0x24, 0x3B, 0x0A, 0x00, 0xD4, 0xF4, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x14, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x1A, 0x16, 0x00, 0x00, 0x79, 0x4E, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xCB, 0x0E, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x04, 0x29, 0x00, 0x00, 0x9B, 0xAD, 0x03, 0xBA, 0x4D, 0xBB, 0x76, 0x1C, 0x24, 0x3B, 0x0A, 0x00,
+  0xD4, 0xF4, 0x09, 0x00, 0xB4, 0x30, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x08, 0x4D, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xF8, 0x2A, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0B, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x18, 0xAF, 0x03, 0xBA, 0x5A, 0xBB, 0x76, 0x1C, 0xE8, 0x44, 0x0A, 0x00, 0x98, 0xFE, 0x09, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x05, 0x01, 0x00, 0x00, 0x17, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x1D, 0x16, 0x00, 0x00, 0x03, 0x4B, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x76, 0x39, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xF8, 0x2A, 0x00, 0x00, 0x18, 0xAF, 0x03, 0xBA, 0x5A, 0xBB, 0x76, 0x1C, 0xE8, 0x44, 0x0A, 0x00,
+  0x98, 0xFE, 0x09, 0x00, 0xD2, 0x0F, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x21, 0xD4, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xEC, 0x2C, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0B, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x96, 0xB0, 0x03, 0xBA, 0x66, 0xBB, 0x76, 0x1C, 0xAC, 0x4E, 0x0A, 0x00, 0x5C, 0x08, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x06, 0x01, 0x00, 0x00, 0x19, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x1F, 0x16, 0x00, 0x00, 0x8E, 0x47, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x20, 0x58, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xEC, 0x2C, 0x00, 0x00, 0x96, 0xB0, 0x03, 0xBA, 0x66, 0xBB, 0x76, 0x1C, 0xAC, 0x4E, 0x0A, 0x00,
+  0x5C, 0x08, 0x0A, 0x00, 0xAE, 0x5B, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x67, 0x1B, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xE0, 0x2E, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0C, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x14, 0xB2, 0x03, 0xBA, 0x73, 0xBB, 0x76, 0x1C, 0x70, 0x58, 0x0A, 0x00, 0x20, 0x12, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x07, 0x01, 0x00, 0x00, 0x1C, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x22, 0x16, 0x00, 0x00, 0x19, 0x44, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xCF, 0x79, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xE0, 0x2E, 0x00, 0x00, 0x14, 0xB2, 0x03, 0xBA, 0x73, 0xBB, 0x76, 0x1C, 0x70, 0x58, 0x0A, 0x00,
+  0x20, 0x12, 0x0A, 0x00, 0xAC, 0x4C, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x75, 0x36, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xD4, 0x30, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0C, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x92, 0xB3, 0x03, 0xBA, 0x80, 0xBB, 0x76, 0x1C, 0x34, 0x62, 0x0A, 0x00, 0xE4, 0x1B, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x08, 0x01, 0x00, 0x00, 0x1E, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x24, 0x16, 0x00, 0x00, 0xA6, 0x40, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x7A, 0xA3, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xD4, 0x30, 0x00, 0x00, 0x92, 0xB3, 0x03, 0xBA, 0x80, 0xBB, 0x76, 0x1C, 0x34, 0x62, 0x0A, 0x00,
+  0xE4, 0x1B, 0x0A, 0x00, 0xCA, 0x46, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xAA, 0x0A, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xC8, 0x32, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0D, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x11, 0xB5, 0x03, 0xBA, 0x8D, 0xBB, 0x76, 0x1C, 0xF8, 0x6B, 0x0A, 0x00, 0xA8, 0x25, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x09, 0x01, 0x00, 0x00, 0x21, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x27, 0x16, 0x00, 0x00, 0x33, 0x3D, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x2B, 0x05, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xC8, 0x32, 0x00, 0x00, 0x11, 0xB5, 0x03, 0xBA, 0x8D, 0xBB, 0x76, 0x1C, 0xF8, 0x6B, 0x0A, 0x00,
+  0xB8, 0x25, 0x0A, 0x00, 0xA6, 0x48, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xA7, 0x51, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xBC, 0x34, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0D, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x90, 0xB6, 0x03, 0xBA, 0x9A, 0xBB, 0x76, 0x1C, 0xBC, 0x75, 0x0A, 0x00, 0x6C, 0x2F, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x0A, 0x01, 0x00, 0x00, 0x23, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x29, 0x16, 0x00, 0x00, 0xC2, 0x39, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xDA, 0xE2, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xBC, 0x34, 0x00, 0x00, 0x90, 0xB6, 0x03, 0xBA, 0x9A, 0xBB, 0x76, 0x1C, 0xBC, 0x75, 0x0A, 0x00,
+  0x6C, 0x2F, 0x0A, 0x00, 0xA4, 0x54, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xD0, 0x96, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xB0, 0x36, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0E, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x0F, 0xB8, 0x03, 0xBA, 0xA8, 0xBB, 0x76, 0x1C, 0x80, 0x7F, 0x0A, 0x00, 0x30, 0x39, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x0B, 0x01, 0x00, 0x00, 0x26, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x2C, 0x16, 0x00, 0x00, 0x51, 0x36, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x8F, 0xF7, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xB0, 0x36, 0x00, 0x00, 0x0F, 0xB8, 0x03, 0xBA, 0xA8, 0xBB, 0x76, 0x1C, 0x80, 0x7F, 0x0A, 0x00,
+  0x30, 0x39, 0x0A, 0x00, 0xC3, 0x04, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xC0, 0xA6, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0xA4, 0x38, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0E, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x8F, 0xB9, 0x03, 0xBA, 0xB5, 0xBB, 0x76, 0x1C, 0x44, 0x89, 0x0A, 0x00, 0xF4, 0x42, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x0C, 0x01, 0x00, 0x00, 0x28, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x2E, 0x16, 0x00, 0x00, 0xE1, 0x32, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x3F, 0xFD, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xA4, 0x38, 0x00, 0x00, 0x8F, 0xB9, 0x03, 0xBA, 0xB5, 0xBB, 0x76, 0x1C, 0x44, 0x89, 0x0A, 0x00,
+  0xF4, 0x42, 0x0A, 0x00, 0x9F, 0x21, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xD8, 0x1B, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x98, 0x3A, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0F, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x0F, 0xBB, 0x03, 0xBA, 0xC2, 0xBB, 0x76, 0x1C, 0x08, 0x93, 0x0A, 0x00, 0xB8, 0x4C, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x0D, 0x01, 0x00, 0x00, 0x2B, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x31, 0x16, 0x00, 0x00, 0x72, 0x2F, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xF6, 0x4E, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x98, 0x3A, 0x00, 0x00, 0x0F, 0xBB, 0x03, 0xBA, 0xC2, 0xBB, 0x76, 0x1C, 0x08, 0x93, 0x0A, 0x00,
+  0xB8, 0x4C, 0x0A, 0x00, 0x9D, 0x47, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x1D, 0xB5, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x8C, 0x3C, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x0F, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x8F, 0xBC, 0x03, 0xBA, 0xD0, 0xBB, 0x76, 0x1C, 0xCC, 0x9C, 0x0A, 0x00, 0x7C, 0x56, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x0E, 0x01, 0x00, 0x00, 0x2D, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x33, 0x16, 0x00, 0x00, 0x03, 0x2C, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xA9, 0xC7, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x8C, 0x3C, 0x00, 0x00, 0x8F, 0xBC, 0x03, 0xBA, 0xD0, 0xBB, 0x76, 0x1C, 0xCC, 0x9C, 0x0A, 0x00,
+  0x7C, 0x56, 0x0A, 0x00, 0xBC, 0x12, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x27, 0xDC, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x80, 0x3E, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x10, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x0F, 0xBE, 0x03, 0xBA, 0xDD, 0xBB, 0x76, 0x1C, 0x90, 0xA6, 0x0A, 0x00, 0x40, 0x60, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x0F, 0x01, 0x00, 0x00, 0x30, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x36, 0x16, 0x00, 0x00, 0x96, 0x28, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x61, 0x35, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x80, 0x3E, 0x00, 0x00, 0x0F, 0xBE, 0x03, 0xBA, 0xDD, 0xBB, 0x76, 0x1C, 0x90, 0xA6, 0x0A, 0x00,
+  0x40, 0x60, 0x0A, 0x00, 0xFC, 0x4A, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xC0, 0x54, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x74, 0x40, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x10, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x90, 0xBF, 0x03, 0xBA, 0xEB, 0xBB, 0x76, 0x1C, 0x54, 0xB0, 0x0A, 0x00, 0x04, 0x6A, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x10, 0x01, 0x00, 0x00, 0x32, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x39, 0x16, 0x00, 0x00, 0x29, 0x25, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x19, 0x85, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x74, 0x40, 0x00, 0x00, 0x90, 0xBF, 0x03, 0xBA, 0xEB, 0xBB, 0x76, 0x1C, 0x54, 0xB0, 0x0A, 0x00,
+  0x04, 0x6A, 0x0A, 0x00, 0xFA, 0x27, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0xBD, 0xE4, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x68, 0x42, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x11, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x12, 0xC1, 0x03, 0xBA, 0xF9, 0xBB, 0x76, 0x1C, 0x18, 0xBA, 0x0A, 0x00, 0xC8, 0x73, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x11, 0x01, 0x00, 0x00, 0x35, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x3B, 0x16, 0x00, 0x00, 0xBE, 0x21, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xD4, 0x9C, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x68, 0x42, 0x00, 0x00, 0x12, 0xC1, 0x03, 0xBA, 0xF9, 0xBB, 0x76, 0x1C, 0x18, 0xBA, 0x0A, 0x00,
+  0xC8, 0x73, 0x0A, 0x00, 0xB6, 0x0D, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x82, 0xE7, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x5C, 0x44, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x11, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x93, 0xC2, 0x03, 0xBA, 0x06, 0xBC, 0x76, 0x1C, 0xDC, 0xC3, 0x0A, 0x00, 0x8C, 0x7D, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x12, 0x01, 0x00, 0x00, 0x37, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x3E, 0x16, 0x00, 0x00, 0x53, 0x1E, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x8D, 0xE8, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x5C, 0x44, 0x00, 0x00, 0x93, 0xC2, 0x03, 0xBA, 0x06, 0xBC, 0x76, 0x1C, 0xDC, 0xC3, 0x0A, 0x00,
+  0x8C, 0x7D, 0x0A, 0x00, 0xF6, 0x5F, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x35, 0x82, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x50, 0x46, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x12, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x15, 0xC4, 0x03, 0xBA, 0x14, 0xBC, 0x76, 0x1C, 0xA0, 0xCD, 0x0A, 0x00, 0x50, 0x87, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x13, 0x01, 0x00, 0x00, 0x39, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x40, 0x16, 0x00, 0x00, 0xE9, 0x1A, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x49, 0x2A, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x50, 0x46, 0x00, 0x00, 0x15, 0xC4, 0x03, 0xBA, 0x14, 0xBC, 0x76, 0x1C, 0xA0, 0xCD, 0x0A, 0x00,
+  0x50, 0x87, 0x0A, 0x00, 0xF5, 0x57, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x50, 0x7E, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x44, 0x48, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x12, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x98, 0xC5, 0x03, 0xBA, 0x22, 0xBC, 0x76, 0x1C, 0x64, 0xD7, 0x0A, 0x00, 0x14, 0x81, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x14, 0x01, 0x00, 0x00, 0x3C, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x43, 0x16, 0x00, 0x00, 0x7F, 0x17, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x07, 0x7E, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x44, 0x48, 0x00, 0x00, 0x98, 0xC5, 0x03, 0xBA, 0x22, 0xBC, 0x76, 0x1C, 0x64, 0xD7, 0x0A, 0x00,
+  0x14, 0x91, 0x0A, 0x00, 0xB0, 0x57, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x2F, 0xA3, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x38, 0x4A, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x13, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x1A, 0xC7, 0x03, 0xBA, 0x30, 0xBC, 0x76, 0x1C, 0x28, 0xE1, 0x0A, 0x00, 0xD8, 0x9A, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x15, 0x01, 0x00, 0x00, 0x3F, 0x16, 0x00, 0x00,
+  0x68, 0xEC, 0xFF, 0xFF, 0x45, 0x16, 0x00, 0x00, 0x17, 0x14, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xC6, 0x04, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x38, 0x4A, 0x00, 0x00, 0x1A, 0xC7, 0x03, 0xBA, 0x30, 0xBC, 0x76, 0x1C, 0x28, 0xE1, 0x0A, 0x00,
+  0xD8, 0x9A, 0x0A, 0x00, 0xF1, 0x60, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x9C, 0x63, 0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x2C, 0x4C, 0x00, 0x00, 0xE5, 0x07, 0x06, 0x0C,
+  0x0A, 0x00, 0x13, 0x37, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xE0, 0x0C,
+  0x9D, 0xC8, 0x03, 0xBA, 0x3F, 0xBC, 0x76, 0x1C, 0xEC, 0xEA, 0x0A, 0x00, 0x9C, 0xA4, 0x0A, 0x00,
+  0xC4, 0x09, 0x00, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x16, 0x01, 0x00, 0x00, 0x41, 0x16, 0x00, 0x00,
+  0x78, 0xEC, 0xFF, 0xFF, 0x48, 0x16, 0x00, 0x00, 0xB0, 0x10, 0x85, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x20, 0xA1, 0x07, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x85, 0x6E, 0xB5, 0x62, 0x01, 0x14, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x2C, 0x4C, 0x00, 0x00, 0x9D, 0xC8, 0x03, 0xBA, 0x3F, 0xBC, 0x76, 0x1C, 0xEC, 0xEA, 0x0A, 0x00,
+  0x9C, 0xA4, 0x0A, 0x00, 0xEF, 0x0E, 0x00, 0x00, 0xA8, 0x61, 0x00, 0x00, 0x40, 0x9C, 0x00, 0x00,
+  0x6C, 0x2B,
+};
+
+// Chunk length, NAV-PVT latitude and NAV-HPPOSLLH latitude after the chunk
+const struct { uint16_t length; int32_t latitude; int32_t highResLatitude; } replayChunks[REPLAY_CHUNKS] = {
+  {256, 0, 0},
+  {66, 477543000, 477543000},
+  {144, 477543010, 477543010},
+  {144, 477543021, 477543021},
+  {144, 477543032, 477543032},
+  {144, 477543032, 477543043},
+  {144, 477543054, 477543054},
+  {144, 477543066, 477543066},
+  {144, 477543077, 477543077},
+  {144, 477543088, 477543088},
+  {144, 477543100, 477543100},
+  {144, 477543111, 477543111},
+  {144, 477543123, 477543123},
+  {144, 477543135, 477543123},
+  {144, 477543147, 477543147},
+  {144, 477543159, 477543159},
+  {144, 477543171, 477543171},
+  {144, 477543183, 477543183},
+  {144, 477543195, 477543195},
+  {144, 477543208, 477543208},
+  {144, 477543208, 477543208},
+  {144, 477543232, 477543232},
+  {144, 477543245, 477543245},
+  {144, 477543258, 477543258},
+  {144, 477543270, 477543270},
+  {144, 477543283, 477543283},
+  {144, 477543296, 477543296},
+  {144, 477543309, 477543296},
+  {144, 477543322, 477543322},
+  {144, 477543336, 477543336},
+  {144, 477543349, 477543349},
+  {144, 477543362, 477543362},
+  {144, 477543376, 477543376},
+  {144, 477543389, 477543389},
+  {144, 477543403, 477543403},
+  {144, 477543417, 477543417},
+  {144, 477543430, 477543430},
+  {144, 477543444, 477543444},
+  {144, 477543444, 477543458},
+  {144, 477543444, 477543472},
+  {144, 477543487, 477543487},
+};
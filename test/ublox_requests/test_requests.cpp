@@ -0,0 +1,118 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+
+/* Request pool. Needs the receiver on the I2C bus.
+ * Four bring-up queries are made one at a time and then all in flight at
+ * once; the times are printed as bench lines (microseconds).
+ */
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+
+const uint8_t prtPoll[1] = {COM_PORT_I2C};
+
+struct Query {
+  uint8_t cls;
+  uint8_t id;
+  const uint8_t *payload;
+  uint16_t len;
+};
+
+const Query bringUp[4] = {
+  {UBX_CLASS_CFG, UBX_CFG_RATE, NULL, 0},
+  {UBX_CLASS_CFG, UBX_CFG_NAV5, NULL, 0},
+  {UBX_CLASS_CFG, UBX_CFG_PRT, prtPoll, 1},
+  {UBX_CLASS_MON, UBX_MON_VER, NULL, 0},
+};
+
+void check_answer(int8_t token, const Query &q) {
+  TEST_ASSERT_EQUAL(UBLOX_STATUS_DATA_RECEIVED, gps.requestStatus(token));
+  ubxPacket *packet = gps.requestPacket(token);
+  TEST_ASSERT_NOT_NULL(packet);
+  TEST_ASSERT_EQUAL_UINT8(q.cls, packet->cls);
+  TEST_ASSERT_EQUAL_UINT8(q.id, packet->id);
+  TEST_ASSERT_TRUE(packet->len > 0);
+}
+
+void test_sequential_vs_batched() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  Timer t;
+
+  t.start();
+  for (int i = 0; i < 4; i++) {
+    int8_t token = gps.sendRequest(bringUp[i].cls, bringUp[i].id, bringUp[i].payload, bringUp[i].len);
+    TEST_ASSERT_TRUE(token >= 0);
+    gps.waitForRequests();
+    check_answer(token, bringUp[i]);
+    gps.releaseRequest(token);
+  }
+  t.stop();
+  long sequentialUs = t.elapsed_time().count();
+
+  int8_t tokens[4];
+  t.reset();
+  t.start();
+  for (int i = 0; i < 4; i++) {
+    tokens[i] = gps.sendRequest(bringUp[i].cls, bringUp[i].id, bringUp[i].payload, bringUp[i].len);
+    TEST_ASSERT_TRUE(tokens[i] >= 0);
+  }
+  TEST_ASSERT_EQUAL(UBLOX_STATUS_SUCCESS, gps.waitForRequests());
+  t.stop();
+  long batchedUs = t.elapsed_time().count();
+  for (int i = 0; i < 4; i++) {
+    check_answer(tokens[i], bringUp[i]);
+    gps.releaseRequest(tokens[i]);
+  }
+
+  printf("bench,gps_bringup_sequential_us,4,%ld,%ld\n", sequentialUs, sequentialUs / 4);
+  printf("bench,gps_bringup_batched_us,4,%ld,%ld\n", batchedUs, batchedUs / 4);
+}
+
+void test_pool_full() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  int8_t tokens[UBX_REQUEST_POOL_SIZE];
+  for (int i = 0; i < UBX_REQUEST_POOL_SIZE; i++)
+    tokens[i] = gps.sendRequest(UBX_CLASS_CFG, UBX_CFG_RATE);
+  TEST_ASSERT_EQUAL(-1, gps.sendRequest(UBX_CLASS_CFG, UBX_CFG_RATE));
+  gps.waitForRequests();
+  for (int i = 0; i < UBX_REQUEST_POOL_SIZE; i++) {
+    TEST_ASSERT_EQUAL(UBLOX_STATUS_DATA_RECEIVED, gps.requestStatus(tokens[i]));
+    gps.releaseRequest(tokens[i]);
+  }
+  TEST_ASSERT_EQUAL(0, gps.pendingRequests());
+}
+
+// Polls with a selector payload are answered with data as well as an ACK
+void test_config_polls() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  const uint8_t msgPoll[2] = {UBX_CLASS_NAV, UBX_NAV_PVT};
+  int8_t token = gps.sendRequest(UBX_CLASS_CFG, UBX_CFG_MSG, msgPoll, 2);
+  TEST_ASSERT_TRUE(token >= 0);
+  gps.waitForRequests();
+  TEST_ASSERT_EQUAL(UBLOX_STATUS_DATA_RECEIVED, gps.requestStatus(token));
+  ubxPacket *packet = gps.requestPacket(token);
+  TEST_ASSERT_EQUAL_UINT8(UBX_CLASS_NAV, packet->payload[0]);
+  TEST_ASSERT_EQUAL_UINT8(UBX_NAV_PVT, packet->payload[1]);
+  gps.releaseRequest(token);
+
+  // Long answers are cut to the pool's buffer
+  token = gps.sendRequest(UBX_CLASS_MON, UBX_MON_VER);
+  gps.waitForRequests();
+  TEST_ASSERT_EQUAL(UBLOX_STATUS_DATA_RECEIVED, gps.requestStatus(token));
+  TEST_ASSERT_TRUE(gps.requestPacket(token)->len <= UBX_REQUEST_PAYLOAD_SIZE);
+  gps.releaseRequest(token);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_sequential_vs_batched);
+  RUN_TEST(test_pool_full);
+  RUN_TEST(test_config_polls);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
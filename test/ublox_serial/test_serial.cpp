@@ -0,0 +1,57 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+
+/* UART transport. Needs the receiver's UART1 wired to GPS_TX/GPS_RX
+ * (receiver at its default 9600 baud). The link is raised to 115200 baud and
+ * NAV-PVT is streamed at 10 Hz.
+ */
+
+#define GPS_TX p13
+#define GPS_RX p14
+#define RUN_SECONDS 5
+
+BufferedSerial serial(GPS_TX, GPS_RX, 9600);
+Ublox_GPS gps(&serial);
+
+void test_connect() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present on UART");
+  TEST_ASSERT_TRUE(gps.setUART1Output(COM_TYPE_UBX));
+  TEST_ASSERT_TRUE(gps.setSerialRate(115200));
+  TEST_ASSERT_TRUE(gps.isConnected());
+}
+
+void test_pvt_10hz() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present on UART");
+  TEST_ASSERT_TRUE(gps.setNavigationFrequency(10));
+  TEST_ASSERT_TRUE(gps.setAutoPVT(true));
+
+  Timer t;
+  int solutions = 0;
+  uint32_t lastTOW = 0;
+  t.start();
+  while (t.elapsed_time() < std::chrono::seconds(RUN_SECONDS)) {
+    if (gps.getPVT()) {
+      uint32_t tow = gps.getTimeOfWeek();
+      if (tow != lastTOW)
+        solutions++;
+      lastTOW = tow;
+    }
+    ThisThread::sleep_for(5ms);
+  }
+  gps.setAutoPVT(false);
+  gps.setNavigationFrequency(1);
+  printf("bench,gps_uart_navpvt_10hz,%d,%d,%d\n", RUN_SECONDS, solutions, solutions / RUN_SECONDS);
+  TEST_ASSERT_TRUE(solutions >= 9 * RUN_SECONDS);
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_connect);
+  RUN_TEST(test_pvt_10hz);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
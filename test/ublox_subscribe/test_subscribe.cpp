@@ -0,0 +1,127 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+
+/* Auto-message registry. Needs the receiver on the I2C bus.
+ * NAV-DOP goes to a callback and NAV-STATUS to a storage slot, both at 1 Hz.
+ * The NAV-SAT test subscribes on the receiver but feeds its own frame.
+ */
+
+#define RUN_SECONDS 5
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+
+UBX_NAV_STATUS_data_t navStatus;
+int dopMessages = 0;
+uint16_t lastPDOP = 0;
+
+void on_nav_dop(const ubxPacket *msg) {
+  dopMessages++;
+  lastPDOP = msg->payload[6] | msg->payload[7] << 8;
+}
+
+void test_subscribe() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  TEST_ASSERT_TRUE(gps.subscribe(UBX_CLASS_NAV, UBX_NAV_DOP, on_nav_dop));
+  TEST_ASSERT_TRUE(gps.subscribe(UBX_CLASS_NAV, UBX_NAV_STATUS, &navStatus));
+
+  Timer t;
+  int freshSlots = 0;
+  t.start();
+  while (t.elapsed_time() < std::chrono::seconds(RUN_SECONDS)) {
+    gps.checkUblox();
+    if (gps.isMessageFresh(UBX_CLASS_NAV, UBX_NAV_STATUS))
+      freshSlots++;
+    ThisThread::sleep_for(20ms);
+  }
+
+  TEST_ASSERT_EQUAL(dopMessages, gps.getMessageCount(UBX_CLASS_NAV, UBX_NAV_DOP));
+  TEST_ASSERT_TRUE(gps.unsubscribe(UBX_CLASS_NAV, UBX_NAV_DOP));
+  TEST_ASSERT_TRUE(gps.unsubscribe(UBX_CLASS_NAV, UBX_NAV_STATUS));
+  TEST_ASSERT_EQUAL(0, gps.getMessageCount(UBX_CLASS_NAV, UBX_NAV_DOP));
+
+  TEST_ASSERT_TRUE(dopMessages >= RUN_SECONDS - 1);
+  TEST_ASSERT_TRUE(freshSlots >= RUN_SECONDS - 1);
+  TEST_ASSERT_TRUE(navStatus.msss > 0);
+  printf("NAV-DOP: %d messages, pDOP %u; NAV-STATUS: fix %u, msss %lu\n", dopMessages,
+    lastPDOP, navStatus.gpsFix, (unsigned long)navStatus.msss);
+}
+
+// Subscribed messages have their own receive buffer, so polls answered while
+// they stream come back intact
+void test_poll_while_subscribed() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  uint8_t version = gps.getProtocolVersionHigh();
+  TEST_ASSERT_TRUE(version > 0);
+  TEST_ASSERT_TRUE(gps.subscribe(UBX_CLASS_NAV, UBX_NAV_DOP, on_nav_dop, 1));
+  for (int i = 0; i < RUN_SECONDS; i++) {
+    TEST_ASSERT_TRUE(gps.getProtocolVersion());     // MON-VER poll, over 100 bytes
+    TEST_ASSERT_EQUAL(version, gps.getProtocolVersionHigh());
+    ThisThread::sleep_for(500ms);
+  }
+  TEST_ASSERT_TRUE(gps.unsubscribe(UBX_CLASS_NAV, UBX_NAV_DOP));
+}
+
+int satMessages = 0;
+uint16_t satLength = 0;
+uint8_t satCount = 0;
+uint8_t lastSvId = 0;
+
+void on_nav_sat(const ubxPacket *msg) {
+  satMessages++;
+  satLength = msg->len;
+  satCount = msg->payload[5];
+  lastSvId = msg->payload[8 + 12 * (satCount - 1) + 1];
+}
+
+// NAV-SAT grows by 12 bytes per satellite; a full sky must still reach the
+// subscriber. The receiver's own NAV-SAT is turned off (rate 0) and a 24 SV
+// frame is fed to the parser instead.
+void test_nav_sat_many_svs() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  const uint8_t numSvs = 24;
+  const uint16_t len = 8 + 12 * numSvs;
+  static uint8_t payload[len];
+  static uint8_t frame[len + 8];
+  memset(payload, 0, sizeof(payload));
+  payload[4] = 1;      // version
+  payload[5] = numSvs;
+  for (int i = 0; i < numSvs; i++) {
+    payload[8 + 12 * i] = 0;          // gnssId GPS
+    payload[8 + 12 * i + 1] = i + 1;  // svId
+    payload[8 + 12 * i + 2] = 30 + i; // cno
+  }
+  ubxPacket packet = {UBX_CLASS_NAV, UBX_NAV_SAT, len, 0, 0, payload, 0, 0, false};
+  gps.calcChecksum(&packet);
+  frame[0] = UBX_SYNCH_1;
+  frame[1] = UBX_SYNCH_2;
+  frame[2] = UBX_CLASS_NAV;
+  frame[3] = UBX_NAV_SAT;
+  frame[4] = len & 0xFF;
+  frame[5] = len >> 8;
+  memcpy(&frame[6], payload, len);
+  frame[len + 6] = packet.checksumA;
+  frame[len + 7] = packet.checksumB;
+
+  TEST_ASSERT_TRUE(gps.subscribe(UBX_CLASS_NAV, UBX_NAV_SAT, on_nav_sat, 0));
+  gps.process(frame, sizeof(frame));
+  TEST_ASSERT_EQUAL(1, satMessages);
+  TEST_ASSERT_EQUAL(len, satLength);
+  TEST_ASSERT_EQUAL(numSvs, satCount);
+  TEST_ASSERT_EQUAL(numSvs, lastSvId);
+  TEST_ASSERT_TRUE(gps.unsubscribe(UBX_CLASS_NAV, UBX_NAV_SAT));
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_subscribe);
+  RUN_TEST(test_poll_while_subscribed);
+  RUN_TEST(test_nav_sat_many_svs);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
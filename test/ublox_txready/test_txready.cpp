@@ -0,0 +1,84 @@
+#include <mbed.h>
+#include <unity/unity.h>
+#include "ublox.h"
+
+/* I2C traffic with and without the TX-ready pin.
+ *
+ * Needs the receiver on the I2C bus with its TX-ready PIO wired to
+ * GPS_TX_READY_PIN. The receiver streams NAV-PVT at 1 Hz (setAutoPVT) and
+ * checkUblox() is called every 10 ms, as a busy flight loop would. The bus
+ * counters for each mode are scaled to one hour and printed in the same CSV
+ * layout as test/benchmarks (bench,<name>,<hours>,<count>,<count per hour>).
+ */
+
+#define GPS_TX_READY_PIN p21
+#define GPS_TX_READY_PIO 6
+#define RUN_SECONDS 60
+
+I2C i2c(p9,p10);
+Ublox_GPS gps(&i2c);
+
+uint32_t perHour(uint32_t count) {
+  return count * (3600 / RUN_SECONDS);
+}
+
+UbloxBusCounters run_mode() {
+  Timer t;
+  gps.resetBusCounters();
+  t.start();
+  while (t.elapsed_time() < std::chrono::seconds(RUN_SECONDS)) {
+    gps.checkUblox();
+    ThisThread::sleep_for(10ms);
+  }
+  return gps.getBusCounters();
+}
+
+void test_bus_transactions() {
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  TEST_ASSERT_TRUE(gps.setAutoPVT(true));
+
+  UbloxBusCounters polled = run_mode();
+
+  TEST_ASSERT_TRUE(gps.setTxReady(GPS_TX_READY_PIN, GPS_TX_READY_PIO));
+  UbloxBusCounters txReady = run_mode();
+  TEST_ASSERT_TRUE(gps.disableTxReady());
+
+  // Every poll with TX-ready should find data
+  TEST_ASSERT_TRUE(txReady.polls > 0);
+  TEST_ASSERT_TRUE(txReady.emptyPolls * 10 < txReady.polls);
+  TEST_ASSERT_TRUE(txReady.transactions < polled.transactions);
+
+  printf("bench,gps_i2c_transactions_polled_per_hour,%d,%lu,%lu\n", 1,
+    (unsigned long)perHour(polled.transactions), (unsigned long)perHour(polled.transactions));
+  printf("bench,gps_i2c_transactions_txready_per_hour,%d,%lu,%lu\n", 1,
+    (unsigned long)perHour(txReady.transactions), (unsigned long)perHour(txReady.transactions));
+  printf("bench,gps_i2c_empty_polls_polled_per_hour,%d,%lu,%lu\n", 1,
+    (unsigned long)perHour(polled.emptyPolls), (unsigned long)perHour(polled.emptyPolls));
+  printf("bench,gps_i2c_polls_skipped_txready_per_hour,%d,%lu,%lu\n", 1,
+    (unsigned long)perHour(txReady.pollsSkipped), (unsigned long)perHour(txReady.pollsSkipped));
+}
+
+void test_ack_wait() {
+  // A CFG poll answered through waitForACKResponse while sleeping on the pin
+  if (!gps.isConnected())
+    TEST_IGNORE_MESSAGE("GPS not present");
+  TEST_ASSERT_TRUE(gps.setTxReady(GPS_TX_READY_PIN, GPS_TX_READY_PIO));
+  Timer t;
+  t.start();
+  uint8_t rate = gps.getNavigationFrequency();
+  t.stop();
+  TEST_ASSERT_TRUE(gps.disableTxReady());
+  TEST_ASSERT_TRUE(rate > 0);
+  printf("bench,gps_cfg_rate_poll_txready_us,1,%ld,%ld\n",
+    (long)t.elapsed_time().count(), (long)t.elapsed_time().count());
+}
+
+int main() {
+  ThisThread::sleep_for(3s);
+  UNITY_BEGIN();
+  RUN_TEST(test_bus_transactions);
+  RUN_TEST(test_ack_wait);
+  UNITY_END();
+  ThisThread::sleep_for(3s);
+}
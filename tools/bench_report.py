@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Collect benchmark results and flag regressions
+
+Reads the "bench,..." lines printed by test/benchmarks (and by
+test/RockBlock9603) from a PlatformIO test log, tags them with the current
+git commit and appends them to a CSV history. With --baseline the results are
+compared against a previous run and any benchmark that got slower by more than
+--threshold percent is reported (exit status 1).
+
+    pio test -e lpc1768 -f benchmarks -v | tee bench_output.txt
+    ./tools/bench_report.py bench_output.txt --history bench_history.csv \\
+        --baseline bench_baseline.csv
+
+--host adds the host-side results from tools/ublox_emulator.py --bench (DDC
+polling model, no target needed).
+
+    @author John M. Larkin (jlarkin@whitworth.edu)
+    @date 2021
+    @copyright MIT License
+"""
+
+import argparse
+import csv
+import os
+import subprocess
+import sys
+
+FIELDS = ["commit", "name", "iterations", "cycles", "cycles_per_iteration"]
+
+
+def git_commit():
+    try:
+        return subprocess.check_output(["git", "rev-parse", "--short", "HEAD"],
+                                       text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def parse_log(path):
+    results = []
+    with open(path, errors="replace") as f:
+        for line in f:
+            # PlatformIO may prefix lines, so search for the marker
+            i = line.find("bench,")
+            if i < 0:
+                continue
+            parts = line[i:].strip().split(",")
+            if len(parts) < 4 or parts[1] == "name":
+                continue
+            name, iterations, total = parts[1], parts[2], parts[3]
+            try:
+                iterations, total = int(iterations), int(total)
+            except ValueError:
+                continue
+            results.append({"name": name, "iterations": iterations, "cycles": total,
+                            "cycles_per_iteration": total / max(iterations, 1)})
+    return results
+
+
+def host_results():
+    script = os.path.join(os.path.dirname(os.path.abspath(__file__)), "ublox_emulator.py")
+    out = subprocess.check_output([sys.executable, script, "--bench", "--duration", "60"],
+                                  text=True)
+    rows = list(csv.DictReader(out.splitlines()))
+    results = []
+    for row in rows:
+        prefix = "host_ddc_" if row["mode"] == "poll" else "host_ddc_%s_" % row["mode"]
+        name = "%s%shz_bus_pct" % (prefix, row["rate_hz"])
+        # Store occupancy in hundredths of a percent so it fits the integer columns
+        value = int(float(row["bus_occupancy_pct"]) * 100)
+        results.append({"name": name, "iterations": 1, "cycles": value,
+                        "cycles_per_iteration": value})
+        value = int(row["transactions_per_hour"])
+        results.append({"name": "%s%shz_transactions_per_hour" % (prefix, row["rate_hz"]),
+                        "iterations": 1, "cycles": value, "cycles_per_iteration": value})
+    return results
+
+
+def load_baseline(path):
+    baseline = {}
+    with open(path) as f:
+        for row in csv.DictReader(f):
+            baseline[row["name"]] = float(row["cycles_per_iteration"])
+    return baseline
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    p.add_argument("log", nargs="?", help="test log containing bench lines")
+    p.add_argument("--history", help="CSV file to append results to")
+    p.add_argument("--baseline", help="CSV of earlier results to compare with")
+    p.add_argument("--threshold", type=float, default=5.0,
+                   help="allowed slow-down in percent (default %(default)s)")
+    p.add_argument("--host", action="store_true", help="include host-side results")
+    args = p.parse_args()
+
+    results = parse_log(args.log) if args.log else []
+    if args.host:
+        results += host_results()
+    if not results:
+        print("no benchmark results found", file=sys.stderr)
+        return 2
+
+    commit = git_commit()
+    writer = csv.DictWriter(sys.stdout, FIELDS)
+    writer.writeheader()
+    for r in results:
+        r["commit"] = commit
+        writer.writerow(r)
+
+    if args.history:
+        new_file = not os.path.exists(args.history)
+        with open(args.history, "a", newline="") as f:
+            w = csv.DictWriter(f, FIELDS)
+            if new_file:
+                w.writeheader()
+            w.writerows(results)
+
+    status = 0
+    if args.baseline:
+        baseline = load_baseline(args.baseline)
+        for r in results:
+            old = baseline.get(r["name"])
+            if not old:
+                continue
+            change = 100.0 * (r["cycles_per_iteration"] - old) / old
+            if change > args.threshold:
+                print("REGRESSION %s: %.1f -> %.1f (%+.1f%%)" % (
+                    r["name"], old, r["cycles_per_iteration"], change), file=sys.stderr)
+                status = 1
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+"""RockBLOCK 9603 modem emulator
+
+Presents the 9603 AT command set on a pseudo-terminal (Linux) so the SBD code
+can be exercised without a modem or sky view. The emulator prints the pty path
+on start-up; point the harness (rockblock_harness.py) or a terminal at it. With
+--serial the emulator instead talks through a real serial port (e.g. a USB
+serial adapter wired to the LPC1768 modem pins) for hardware-in-the-loop runs
+of the RockBlock9603 driver and IridiumScheduler (test/RockBlock9603_emulator).
+
+As on a real 9603 the MO buffer is kept after a session, successful or not,
+until AT+SBDD0/2 clears it or AT+SBDWB overwrites it, so another +SBDIX sends
+the same message again.
+
+Supported: AT, AT&K0, ATE0/1, AT*R0/1, AT+GMI/GMM/GMR/GSN, AT+CSQ, AT+CSQF,
+AT+SBDSX, AT+SBDWB, AT+SBDIX(A), AT+SBDRB, AT+SBDD0/1/2, AT+SBDMTA and
+unsolicited SBDRING when MT messages are queued.
+
+Sky conditions are a random walk in signal bars; session success probability
+and latency depend on the bars. --time-scale speeds the simulated clock up so
+an hour of flight can be run in a minute of CI time.
+
+    @author John M. Larkin (jlarkin@whitworth.edu)
+    @date 2021
+    @copyright MIT License
+"""
+
+import argparse
+import json
+import os
+import pty
+import random
+import select
+import sys
+import termios
+import time
+import tty
+
+# Probability that an SBD session succeeds at 0-5 bars
+SUCCESS_BY_BARS = [0.02, 0.25, 0.50, 0.75, 0.90, 0.97]
+
+IMEI = "300234010753370"
+
+
+def open_serial(path, baud=19200):
+    """Open a real serial port in raw mode (no pyserial needed)"""
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    speed = getattr(termios, "B%d" % baud)
+    attrs[4] = speed
+    attrs[5] = speed
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+class SimClock:
+    """Simulated time that can run faster than real time"""
+
+    def __init__(self, scale):
+        self.scale = scale
+        self.start = time.monotonic()
+
+    def now(self):
+        return (time.monotonic() - self.start) * self.scale
+
+    def sleep(self, sim_seconds):
+        time.sleep(sim_seconds / self.scale)
+
+
+class Sky:
+    """Signal bars as a random walk, updated once per simulated 10 s"""
+
+    def __init__(self, clock, bars, volatility, rng):
+        self.clock = clock
+        self.bars = bars
+        self.volatility = volatility
+        self.rng = rng
+        self.last = clock.now()
+
+    def current(self):
+        while self.clock.now() - self.last >= 10:
+            self.last += 10
+            if self.rng.random() < self.volatility:
+                self.bars = min(5, max(0, self.bars + self.rng.choice((-1, 1))))
+        return self.bars
+
+
+class Modem9603:
+    """AT command state machine for one 9603"""
+
+    def __init__(self, fd, args):
+        self.fd = fd
+        self.rng = random.Random(args.seed)
+        self.clock = SimClock(args.time_scale)
+        self.sky = Sky(self.clock, args.bars, args.volatility, self.rng)
+        self.fail_prob = args.fail_prob
+        self.latency = args.latency
+        self.echo = True
+        self.radio = True
+        self.mt_alert = True
+        self.line = b""
+        self.binary_needed = 0
+        self.binary = b""
+        self.mo_buffer = None
+        self.mo_loaded_at = 0.0
+        self.mt_buffer = None
+        self.mt_queue = [m.encode() for m in args.mt]
+        self.momsn = 0
+        self.mtmsn = 0
+        self.last_bars = self.sky.current()
+        self.last_bars_time = 0.0
+        self.next_ring = 0.0
+        self.stats = {"sessions": 0, "mo_delivered": 0, "mo_bytes": 0,
+                      "mt_delivered": 0, "latency": []}
+
+    # Output helpers
+    def write(self, data):
+        if isinstance(data, str):
+            data = data.encode()
+        os.write(self.fd, data)
+
+    def respond(self, *lines, ok=True):
+        for line in lines:
+            self.write("\r\n%s\r\n" % line)
+        if ok:
+            self.write("\r\nOK\r\n")
+
+    def error(self):
+        self.write("\r\nERROR\r\n")
+
+    # Input handling
+    def feed(self, data):
+        for b in data:
+            c = bytes([b])
+            if self.binary_needed:
+                self.binary += c
+                if len(self.binary) == self.binary_needed:
+                    self.finish_binary()
+                continue
+            if self.echo:
+                self.write(c)
+            if c in (b"\r", b"\n"):
+                if self.line:
+                    self.command(self.line.decode(errors="replace").strip())
+                self.line = b""
+            else:
+                self.line += c
+
+    def finish_binary(self):
+        data, cs = self.binary[:-2], self.binary[-2:]
+        self.binary_needed = 0
+        self.binary = b""
+        if (sum(data) & 0xFFFF) != int.from_bytes(cs, "big"):
+            self.respond("2")
+            return
+        self.mo_buffer = data
+        self.mo_loaded_at = self.clock.now()
+        self.respond("0")
+
+    def command(self, cmd):
+        up = cmd.upper()
+        if up in ("AT", "AT&K0", "AT&K3"):
+            self.respond()
+        elif up in ("ATE0", "ATE1"):
+            self.echo = up.endswith("1")
+            self.respond()
+        elif up in ("AT*R0", "AT*R1"):
+            self.radio = up.endswith("1")
+            self.respond()
+        elif up == "AT+GMI":
+            self.respond("Iridium")
+        elif up == "AT+GMM":
+            self.respond("IRIDIUM 9600 Family SBD Transceiver")
+        elif up == "AT+GMR":
+            self.respond("Call Processor Version: TA16005 (emulator)")
+        elif up in ("AT+GSN", "AT+CGSN"):
+            self.respond(IMEI)
+        elif up == "AT+CSQF":
+            # The modem refreshes its cached reading in the background
+            if self.radio and self.clock.now() - self.last_bars_time >= 20:
+                self.last_bars = self.sky.current()
+                self.last_bars_time = self.clock.now()
+            self.respond("+CSQF:%d" % self.last_bars)
+        elif up == "AT+CSQ":
+            self.clock.sleep(self.rng.uniform(2, 6))  # live measurement is slow
+            self.last_bars = self.sky.current() if self.radio else 0
+            self.respond("+CSQ:%d" % self.last_bars)
+        elif up == "AT+SBDSX":
+            self.respond("+SBDSX: %d, %d, %d, %d, %d, %d" % (
+                1 if self.mo_buffer else 0, self.momsn,
+                1 if self.mt_buffer else 0, self.mtmsn if self.mt_buffer else -1,
+                1 if self.mt_queue else 0, len(self.mt_queue)))
+        elif up.startswith("AT+SBDWB="):
+            n = int(up.split("=")[1])
+            if n < 1 or n > 340:
+                self.respond("3")
+                return
+            self.binary_needed = n + 2
+            self.write("\r\nREADY\r\n")
+        elif up in ("AT+SBDIX", "AT+SBDIXA"):
+            self.session()
+        elif up == "AT+SBDRB":
+            msg = self.mt_buffer or b""
+            cs = sum(msg) & 0xFFFF
+            self.write(len(msg).to_bytes(2, "big") + msg + cs.to_bytes(2, "big"))
+            self.write("\r\nOK\r\n")
+        elif up.startswith("AT+SBDD"):
+            which = up[-1]
+            if which in "02":
+                self.mo_buffer = None
+            if which in "12":
+                self.mt_buffer = None
+            self.respond("0")
+        elif up.startswith("AT+SBDMTA="):
+            self.mt_alert = up.endswith("1")
+            self.respond()
+        else:
+            self.error()
+
+    def session(self):
+        self.stats["sessions"] += 1
+        bars = self.sky.current() if self.radio else 0
+        self.last_bars = bars
+        # Sessions take longer when the signal is weak
+        duration = max(1.0, self.rng.gauss(self.latency + 4 * (5 - bars), 3))
+        self.clock.sleep(duration)
+        ok = self.radio and self.rng.random() < SUCCESS_BY_BARS[bars] * (1 - self.fail_prob)
+        if not ok:
+            self.respond("+SBDIX: 32, %d, 2, %d, 0, %d" % (self.momsn, self.mtmsn, len(self.mt_queue)))
+            return
+        mo_status = 0
+        if self.mo_buffer:
+            self.momsn = (self.momsn + 1) % 65536
+            self.stats["mo_delivered"] += 1
+            self.stats["mo_bytes"] += len(self.mo_buffer)
+            self.stats["latency"].append(self.clock.now() - self.mo_loaded_at)
+        mt_status, mt_len = 0, 0
+        if self.mt_queue:
+            self.mt_buffer = self.mt_queue.pop(0)
+            self.mtmsn += 1
+            mt_status, mt_len = 1, len(self.mt_buffer)
+            self.stats["mt_delivered"] += 1
+        self.respond("+SBDIX: %d, %d, %d, %d, %d, %d" % (
+            mo_status, self.momsn, mt_status, self.mtmsn, mt_len, len(self.mt_queue)))
+
+    def poll_ring(self):
+        """Unsolicited ring alert while MT messages wait at the gateway"""
+        if self.mt_queue and self.mt_alert and self.clock.now() >= self.next_ring:
+            self.write("\r\nSBDRING\r\n")
+            self.next_ring = self.clock.now() + 60
+
+    def summary(self):
+        hours = max(self.clock.now(), 1e-9) / 3600.0
+        lat = sorted(self.stats["latency"])
+        return {
+            "sim_seconds": round(self.clock.now(), 1),
+            "sessions": self.stats["sessions"],
+            "mo_delivered": self.stats["mo_delivered"],
+            "mo_bytes": self.stats["mo_bytes"],
+            "mt_delivered": self.stats["mt_delivered"],
+            "messages_per_hour": round(self.stats["mo_delivered"] / hours, 2),
+            "latency_mean_s": round(sum(lat) / len(lat), 1) if lat else None,
+            "latency_max_s": round(lat[-1], 1) if lat else None,
+        }
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    p.add_argument("--serial", help="use a real serial port instead of a pty")
+    p.add_argument("--link", default="/tmp/rockblock9603",
+                   help="symlink created to the pty (default %(default)s)")
+    p.add_argument("--bars", type=int, default=4, help="initial signal bars")
+    p.add_argument("--volatility", type=float, default=0.3,
+                   help="chance per 10 s that the bars change")
+    p.add_argument("--fail-prob", type=float, default=0.0,
+                   help="extra session failure probability")
+    p.add_argument("--latency", type=float, default=10.0,
+                   help="session time at full signal (s)")
+    p.add_argument("--mt", action="append", default=[],
+                   help="MT message text to queue at the gateway (repeatable)")
+    p.add_argument("--time-scale", type=float, default=1.0,
+                   help="simulated seconds per real second")
+    p.add_argument("--duration", type=float, default=0,
+                   help="stop after this many simulated seconds (0 = forever)")
+    p.add_argument("--stats", help="write JSON summary to this file on exit")
+    p.add_argument("--seed", type=int, default=None)
+    args = p.parse_args()
+
+    if args.serial:
+        fd = open_serial(args.serial)
+        print("RockBLOCK emulator on %s" % args.serial, flush=True)
+    else:
+        fd, slave = pty.openpty()
+        tty.setraw(slave)
+        name = os.ttyname(slave)
+        if args.link:
+            if os.path.islink(args.link):
+                os.unlink(args.link)
+            os.symlink(name, args.link)
+        print("RockBLOCK emulator on %s (%s)" % (name, args.link), flush=True)
+
+    modem = Modem9603(fd, args)
+    try:
+        while not args.duration or modem.clock.now() < args.duration:
+            r, _, _ = select.select([fd], [], [], 0.05)
+            if r:
+                try:
+                    modem.feed(os.read(fd, 512))
+                except OSError:
+                    time.sleep(0.05)  # pty not opened by the other side yet
+            modem.poll_ring()
+    except KeyboardInterrupt:
+        pass
+    summary = modem.summary()
+    print(json.dumps(summary))
+    if args.stats:
+        with open(args.stats, "w") as f:
+            json.dump(summary, f, indent=2)
+    if not args.serial and args.link and os.path.islink(args.link):
+        os.unlink(args.link)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
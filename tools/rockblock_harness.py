@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""Throughput harness for the RockBLOCK 9603 emulator
+
+Plays the part of the command module: builds SBD frames, loads them with
+AT+SBDWB and sends them with AT+SBDIX using the same command sequence as
+RockBlock9603::write_binary_message/transmit_message. Session timing follows
+the IridiumScheduler policy (CSQF samples, pull forward/defer within a window)
+or, with --fixed, the plain fixed-period schedule.
+
+Prints one CSV line per session and a summary of messages per hour and
+delivery latency (both in simulated time).
+
+This is a model, not a test of the firmware. The AT command sequence and the
+scheduler policy are re-implemented here in Python and have to be kept in
+step with RockBlock9603.cpp and IridiumScheduler.cpp by hand; the harness
+compares scheduling policies against the emulator but does not run the C++.
+The firmware itself is run against the emulator by the on-target test in
+test/RockBlock9603_emulator (emulator started with --serial).
+
+    ./rockblock_emulator.py --time-scale 60 --duration 3600 &
+    ./rockblock_harness.py --time-scale 60 --duration 3600 --period 60
+
+    @author John M. Larkin (jlarkin@whitworth.edu)
+    @date 2021
+    @copyright MIT License
+"""
+
+import argparse
+import os
+import select
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from rockblock_emulator import SimClock, open_serial  # noqa: E402
+
+# Must match IridiumScheduler.h
+PULL_FORWARD_PROB = 0.8
+DEFER_PROB = 0.3
+MAX_BARS = 5
+
+WRITE_RETRY_S = 5  # simulated wait before reloading a frame the modem refused
+
+
+class Port:
+    """Line-oriented access to the modem (like ATLineReader)"""
+
+    def __init__(self, fd, clock):
+        self.fd = fd
+        self.clock = clock
+        self.buf = b""
+
+    def send(self, cmd):
+        self.buf = b""
+        os.write(self.fd, cmd.encode() + b"\r")
+
+    def write(self, data):
+        os.write(self.fd, data)
+
+    def read_line(self, timeout):
+        # Never wait less than 0.5 s of real time, however fast the clock runs
+        end = time.monotonic() + max(timeout / self.clock.scale, 0.5)
+        while True:
+            while b"\n" in self.buf or b"\r" in self.buf:
+                i = min(x for x in (self.buf.find(b"\r"), self.buf.find(b"\n")) if x >= 0)
+                line, self.buf = self.buf[:i], self.buf[i + 1:]
+                if line.strip():
+                    return line.decode(errors="replace").strip()
+            left = end - time.monotonic()
+            if left <= 0:
+                return None
+            r, _, _ = select.select([self.fd], [], [], left)
+            if r:
+                self.buf += os.read(self.fd, 512)
+
+    def wait_for(self, prefix, timeout=5):
+        while True:
+            line = self.read_line(timeout)
+            if line is None or line.startswith("ERROR"):
+                return None
+            if line.startswith(prefix):
+                return line[len(prefix):].strip()
+
+
+class Scheduler:
+    """Python model of IridiumScheduler::should_transmit"""
+
+    def __init__(self, period, slack):
+        self.period = period
+        self.slack = slack if slack is not None else period / 4
+        self.samples = []
+        self.history = []  # (bars, success)
+        self.last = 0.0
+
+    def estimate(self, bars):
+        prior = (bars + 0.5) / (MAX_BARS + 1)
+        hits = [s for b, s in self.history[-16:] if b == bars]
+        return (sum(hits) + 2 * prior) / (len(hits) + 2)
+
+    def bars(self):
+        # Integer rounding as in IridiumScheduler::current_bars
+        recent = self.samples[-3:]
+        n = len(recent)
+        return (sum(recent) + n // 2) // n if recent else -1
+
+    def should_transmit(self, now):
+        since = now - self.last
+        if since < self.period - self.slack:
+            return False
+        if since >= self.period:
+            return True
+        middle = self.period - self.slack / 2
+        b = self.bars()
+        if b < 0:
+            return since >= middle
+        p = self.estimate(b)
+        return p >= PULL_FORWARD_PROB or (since >= middle and p >= DEFER_PROB)
+
+    def record(self, now, success, bars):
+        self.history.append((max(bars, 0), success))
+        self.last = now
+
+
+def write_binary(port, data):
+    port.send("AT+SBDWB=%d" % len(data))
+    if port.wait_for("READY") is None:
+        return -2
+    port.write(data + (sum(data) & 0xFFFF).to_bytes(2, "big"))
+    line = port.read_line(5)
+    if line is None or not line.lstrip("-").isdigit():
+        return -3
+    port.wait_for("OK")
+    return int(line)
+
+
+def transmit(port):
+    port.send("AT+SBDIX")
+    field = port.wait_for("+SBDIX:", timeout=60)
+    if field is None:
+        return None
+    values = [int(v) for v in field.replace(" ", "").split(",")]
+    port.wait_for("OK")
+    return values
+
+
+def run(args, clock, port, sched, stats):
+    frame_built = clock.now()
+    seq = 0
+    while clock.now() < args.duration:
+        if not args.fixed:
+            port.send("AT+CSQF")
+            field = port.wait_for("+CSQF:")
+            if field is not None:
+                sched.samples.append(int(field))
+                port.wait_for("OK")
+        if not sched.should_transmit(clock.now()):
+            clock.sleep(min(5, args.period / 4))
+            continue
+        frame = bytes((seq + i) & 0xFF for i in range(args.length))
+        if write_binary(port, frame) != 0:
+            clock.sleep(WRITE_RETRY_S)
+            continue
+        start = clock.now()
+        bars = sched.bars()
+        result = transmit(port)
+        stats["sessions"] += 1
+        now = clock.now()
+        success = result is not None and 0 <= result[0] <= 4
+        sched.record(now, success, bars)
+        latency = now - frame_built
+        if success:
+            stats["latency"].append(latency)
+            frame_built = now  # next frame holds newer data
+            seq += 1
+        print("%.1f,%d,%d,%d,%.1f,%.1f" % (now, seq, bars,
+              result[0] if result else -1, now - start, latency), flush=True)
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    p.add_argument("--port", default="/tmp/rockblock9603")
+    p.add_argument("--period", type=float, default=60, help="transmit period (s)")
+    p.add_argument("--slack", type=float, default=None, help="scheduler slack (s)")
+    p.add_argument("--fixed", action="store_true", help="ignore signal quality")
+    p.add_argument("--length", type=int, default=100, help="frame length (bytes)")
+    p.add_argument("--time-scale", type=float, default=1.0)
+    p.add_argument("--duration", type=float, default=3600, help="simulated seconds")
+    args = p.parse_args()
+
+    fd = open_serial(args.port)
+    clock = SimClock(args.time_scale)
+    port = Port(fd, clock)
+    sched = Scheduler(args.period, 0 if args.fixed else args.slack)
+    stats = {"sessions": 0, "latency": []}
+
+    port.send("AT&K0")
+    port.wait_for("OK")
+
+    print("sim_time,seq,bars,mo_status,session_s,latency_s")
+    try:
+        run(args, clock, port, sched, stats)
+    except OSError:
+        pass  # emulator went away
+
+    lat = stats["latency"]
+    hours = max(clock.now(), 1e-9) / 3600.0
+    print("# sessions=%d delivered=%d messages_per_hour=%.1f mean_latency_s=%.1f" % (
+        stats["sessions"], len(lat), len(lat) / hours,
+        sum(lat) / len(lat) if lat else float("nan")))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
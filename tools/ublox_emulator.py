@@ -0,0 +1,444 @@
+#!/usr/bin/env python3
+"""u-blox receiver (DDC/I2C) emulator
+
+Model of the u-blox DDC interface as seen by Ublox_GPS::checkUbloxI2C:
+  - register 0xFD/0xFE: number of bytes waiting (MSB/LSB)
+  - register 0xFF: the UBX output stream (0xFF when empty)
+  - writes starting at 0xFF are UBX commands to the receiver
+The receiver answers polls and configuration (NAV-PVT, NAV-HPPOSLLH, MON-VER,
+ACK/NAK) and streams NAV-PVT and NAV-HPPOSLLH at 1-25 Hz from a scripted
+balloon flight (ascent, burst, descent under parachute).
+
+The quirks handled in checkUbloxI2C can be injected with a given probability:
+  --quirk-ff     0xFF in the LSB of the byte count
+  --quirk-7f     0x7F returned instead of data (module not ready)
+  --quirk-bit15  bit 15 set in the byte count
+
+--tx-ready models the receiver's TX-ready output (Ublox_GPS::setTxReady):
+the driver only touches the bus when at least --tx-ready-threshold bytes wait.
+
+  --bench        sweep several rates, polled and with TX-ready, and print CSV
+                 (frames delivered, checksum errors, drops, bytes per poll,
+                 I2C transactions and bus occupancy)
+
+  --header FILE  write the byte chunks the polling loop hands to process(),
+                 with the position expected after each chunk, as a C header
+                 for the replay test in test/ublox_replay
+  --corrupt P    flip one byte of a navigation frame with probability P
+
+The driver side here is a Python port of the checkUbloxI2C polling loop and
+the UBX framing, kept in step with ublox.cpp by hand. The --header stream is
+what keeps it honest: test/ublox_replay feeds the same chunks to the real
+Ublox_GPS::process() and checks it ends each chunk where this model does.
+Regenerate the test's header after changing either side:
+
+    ./ublox_emulator.py --rate 2 --duration 20 --quirk-7f 0.05 --quirk-bit15 0.05 \
+        --corrupt 0.05 --header ../test/ublox_replay/replay_stream.h
+
+    @author John M. Larkin (jlarkin@whitworth.edu)
+    @date 2021
+    @copyright MIT License
+"""
+
+import argparse
+import math
+import random
+import struct
+import sys
+
+UBX_SYNC = b"\xb5\x62"
+CLASS_NAV, CLASS_ACK, CLASS_CFG, CLASS_MON = 0x01, 0x05, 0x06, 0x0A
+NAV_PVT, NAV_HPPOSLLH, MON_VER = 0x07, 0x14, 0x04
+ACK_ACK, ACK_NAK = 0x01, 0x00
+
+I2C_BIT_RATE = 400000    # fast mode
+DDC_BUFFER = 4096        # receiver drops messages that do not fit
+POLL_INTERVAL = 0.100    # i2cPollingWait in Ublox_GPS
+MAX_PAYLOAD_SIZE = 256   # chunk size used by checkUbloxI2C
+
+
+def checksum(data):
+    """8-bit Fletcher over class, id, length and payload"""
+    a = b = 0
+    for c in data:
+        a = (a + c) & 0xFF
+        b = (b + a) & 0xFF
+    return bytes((a, b))
+
+
+def ubx_frame(cls, msg_id, payload=b""):
+    body = struct.pack("<BBH", cls, msg_id, len(payload)) + payload
+    return UBX_SYNC + body + checksum(body)
+
+
+class Trajectory:
+    """Balloon flight: 5 m/s ascent to burst, then parachute descent"""
+
+    def __init__(self, lat=47.7543, lon=-117.4172, ground=600.0, burst=30000.0):
+        self.lat0, self.lon0, self.ground, self.burst = lat, lon, ground, burst
+        self.ascent = 5.0
+        self.t_burst = (burst - ground) / self.ascent
+
+    def state(self, t):
+        """Returns lat, lon (deg), altitude (m), velN, velE, velD (m/s)"""
+        if t <= self.t_burst:
+            alt = self.ground + self.ascent * t
+            vd = -self.ascent
+        else:
+            # Descent rate v = 5 exp((h - ground)/14 km) grows with thinner air;
+            # u = exp(-(h - ground)/14 km) then increases linearly with time
+            u = math.exp(-(self.burst - self.ground) / 14000.0) + 5.0 * (t - self.t_burst) / 14000.0
+            if u >= 1.0:
+                alt, vd = self.ground, 0.0
+            else:
+                alt = self.ground - 14000.0 * math.log(u)
+                vd = 5.0 / u
+        wind_e = 5.0 + alt / 1000.0          # stronger aloft
+        wind_n = 2.0 * math.sin(alt / 5000.0)
+        if alt <= self.ground and t > self.t_burst:
+            wind_e = wind_n = 0.0
+        east = wind_e * t
+        north = wind_n * t
+        lat = self.lat0 + north / 111320.0
+        lon = self.lon0 + east / (111320.0 * math.cos(math.radians(self.lat0)))
+        return lat, lon, alt, wind_n, wind_e, vd
+
+
+def nav_pvt(t, traj):
+    lat, lon, alt, vn, ve, vd = traj.state(t)
+    itow = int(t * 1000) % (7 * 86400 * 1000)
+    secs = int(t)
+    gspeed = math.hypot(vn, ve)
+    head = math.degrees(math.atan2(ve, vn)) % 360
+    payload = struct.pack(
+        "<IHBBBBBBIiBBBBiiiiIIiiiiiIIHB5siHH",
+        itow, 2021, 6, 12, (10 + secs // 3600) % 24, (secs // 60) % 60, secs % 60,
+        0x37, 50, 0, 3, 0x01, 0xE0, 12,
+        int(lon * 1e7), int(lat * 1e7), int(alt * 1000 + 18000), int(alt * 1000),
+        2500, 4000,
+        int(vn * 1000), int(ve * 1000), int(vd * 1000), int(gspeed * 1000),
+        int(head * 1e5), 300, 500000, 120, 0, b"\x00" * 5, 0, 0, 0)
+    assert len(payload) == 92
+    return ubx_frame(CLASS_NAV, NAV_PVT, payload)
+
+
+def nav_hpposllh(t, traj):
+    lat, lon, alt, _, _, _ = traj.state(t)
+    itow = int(t * 1000) % (7 * 86400 * 1000)
+    lon_i, lat_i = int(lon * 1e7), int(lat * 1e7)
+    lon_hp = int(round((lon * 1e7 - lon_i) * 100))
+    lat_hp = int(round((lat * 1e7 - lat_i) * 100))
+    lon_hp, lat_hp = max(-99, min(99, lon_hp)), max(-99, min(99, lat_hp))
+    payload = struct.pack("<B3sIiiiibbbbII", 0, b"\x00" * 3, itow, lon_i, lat_i,
+                          int(alt * 1000 + 18000), int(alt * 1000), lon_hp, lat_hp,
+                          0, 0, 25000, 40000)
+    assert len(payload) == 36
+    return ubx_frame(CLASS_NAV, NAV_HPPOSLLH, payload)
+
+
+def mon_ver(protver="27.11"):
+    payload = b"ROM SPG 4.04 (emulated)".ljust(30, b"\x00")
+    payload += b"00190000".ljust(10, b"\x00")
+    for ext in ("FWVER=SPG 4.04", "PROTVER=" + protver, "MOD=ZED-F9P", "GPS;GLO;GAL;BDS"):
+        payload += ext.encode().ljust(30, b"\x00")
+    return ubx_frame(CLASS_MON, MON_VER, payload)
+
+
+class Receiver:
+    """DDC register model plus the receiver's message generation"""
+
+    def __init__(self, rate, quirks, rng, protver="27.11", nak_prob=0.0, corrupt=0.0):
+        self.rate = rate
+        self.quirks = quirks
+        self.corrupt = corrupt
+        self.rng = rng
+        self.protver = protver
+        self.nak_prob = nak_prob
+        self.traj = Trajectory()
+        self.stream = bytearray()
+        self.register = 0xFF
+        self.rx = bytearray()
+        self.next_epoch = 0.0
+        self.frames_out = 0
+        self.frames_dropped = 0
+        self.bus_bytes = 0
+        self.transactions = 0
+
+    def queue(self, frame):
+        if len(self.stream) + len(frame) > DDC_BUFFER:
+            self.frames_dropped += 1
+            return
+        self.stream += frame
+        self.frames_out += 1
+
+    def advance(self, t):
+        """Produce navigation epochs up to time t"""
+        while self.next_epoch <= t:
+            self.queue(self.damage(nav_pvt(self.next_epoch, self.traj)))
+            self.queue(self.damage(nav_hpposllh(self.next_epoch, self.traj)))
+            self.next_epoch += 1.0 / self.rate
+
+    def damage(self, frame):
+        """Flip one payload byte (a bus error the checksum has to catch)"""
+        if self.rng.random() >= self.corrupt:
+            return frame
+        frame = bytearray(frame)
+        frame[self.rng.randrange(6, len(frame) - 2)] ^= 0x10
+        return bytes(frame)
+
+    # I2C transactions (data excludes the address byte)
+    def write(self, data):
+        self.bus_bytes += len(data) + 1
+        self.transactions += 1
+        self.register = data[0]
+        if self.register == 0xFF and len(data) > 1:
+            self.rx += bytes(data[1:])
+            self.handle_commands()
+
+    def read(self, n):
+        self.bus_bytes += n + 1
+        self.transactions += 1
+        out = bytearray()
+        if self.register in (0xFD, 0xFE):
+            count = len(self.stream)
+            if self.rng.random() < self.quirks.get("ff", 0):
+                count = (count & 0xFF00) | 0xFF
+            if self.rng.random() < self.quirks.get("bit15", 0):
+                count |= 0x8000
+            regs = {0xFD: count >> 8, 0xFE: count & 0xFF}
+            while len(out) < n and self.register in regs:
+                out.append(regs[self.register])
+                self.register += 1
+        if len(out) < n:
+            if self.stream and self.rng.random() < self.quirks.get("7f", 0):
+                return bytes(out) + b"\x7f" * (n - len(out))  # nothing consumed
+            take = min(n - len(out), len(self.stream))
+            out += self.stream[:take]
+            del self.stream[:take]
+            out += b"\xff" * (n - len(out))
+        return bytes(out)
+
+    def handle_commands(self):
+        while True:
+            start = self.rx.find(UBX_SYNC)
+            if start < 0 or len(self.rx) < start + 8:
+                return
+            length = self.rx[start + 4] | (self.rx[start + 5] << 8)
+            end = start + 8 + length
+            if len(self.rx) < end:
+                return
+            cls, msg_id = self.rx[start + 2], self.rx[start + 3]
+            body, cs = self.rx[start + 2:end - 2], self.rx[end - 2:end]
+            del self.rx[:end]
+            if checksum(body) != cs:
+                continue
+            self.command(cls, msg_id, body[4:])
+
+    def command(self, cls, msg_id, payload):
+        t = self.next_epoch
+        if cls == CLASS_NAV and msg_id == NAV_PVT and not payload:
+            self.queue(nav_pvt(t, self.traj))
+        elif cls == CLASS_NAV and msg_id == NAV_HPPOSLLH and not payload:
+            self.queue(nav_hpposllh(t, self.traj))
+        elif cls == CLASS_MON and msg_id == MON_VER:
+            self.queue(mon_ver(self.protver))
+        elif cls == CLASS_CFG:
+            if payload and self.rng.random() >= self.nak_prob:
+                self.queue(ubx_frame(CLASS_ACK, ACK_ACK, bytes((cls, msg_id))))
+            elif payload:
+                self.queue(ubx_frame(CLASS_ACK, ACK_NAK, bytes((cls, msg_id))))
+            else:
+                # Poll of a configuration message: echo empty config then ACK
+                self.queue(ubx_frame(cls, msg_id, b""))
+                self.queue(ubx_frame(CLASS_ACK, ACK_ACK, bytes((cls, msg_id))))
+
+
+class UbxFramer:
+    """Python model of Ublox_GPS::process()/processUBX() framing"""
+
+    def __init__(self):
+        self.frames = 0
+        self.checksum_errors = 0
+        self.by_id = {}
+        self.buf = bytearray()
+        self.state = 0
+        self.latitude = 0          # from the last valid NAV-PVT
+        self.high_res_latitude = 0 # from the last valid NAV-HPPOSLLH
+
+    def feed(self, byte):
+        if self.state == 0:
+            if byte == 0xB5:
+                self.buf = bytearray((byte,))
+                self.state = 1
+            return
+        self.buf.append(byte)
+        if self.state == 1:
+            if byte != 0x62:
+                self.state = 0
+            else:
+                self.state = 2
+            return
+        if len(self.buf) >= 6:
+            length = self.buf[4] | (self.buf[5] << 8)
+            if length > MAX_PAYLOAD_SIZE:
+                self.state = 0  # too big for payloadCfg
+                return
+            if len(self.buf) == 8 + length:
+                if checksum(self.buf[2:-2]) == bytes(self.buf[-2:]):
+                    self.frames += 1
+                    key = (self.buf[2], self.buf[3])
+                    self.by_id[key] = self.by_id.get(key, 0) + 1
+                    if key == (CLASS_NAV, NAV_PVT) and length == 92:
+                        self.latitude = struct.unpack_from("<i", self.buf, 6 + 28)[0]
+                    elif key == (CLASS_NAV, NAV_HPPOSLLH) and length == 36:
+                        self.high_res_latitude = struct.unpack_from("<i", self.buf, 6 + 12)[0]
+                else:
+                    self.checksum_errors += 1
+                self.state = 0
+
+
+def check_ublox_i2c(rx, framer, stats, chunks=None):
+    """Python port of the checkUbloxI2C polling algorithm
+
+    chunks, if given, collects (bytes, latitude, high-res latitude) for every
+    chunk passed to process()
+    """
+    rx.write(b"\xfd")
+    cmd = rx.read(2)
+    stats["polls"] += 1
+    if cmd[1] == 0xFF:
+        stats["ff"] += 1
+        return False
+    available = (cmd[0] << 8) | cmd[1]
+    if available == 0:
+        return False
+    if available & 0x8000:
+        stats["bit15"] += 1
+        available &= 0x7FFF
+    first = True
+    while available:
+        n = min(available, MAX_PAYLOAD_SIZE)
+        if first:
+            rx.write(b"\xff")  # the address stays at 0xFF for later chunks
+        data = rx.read(n)
+        if data[0] == 0x7F and (first or framer.state == 0):
+            stats["7f"] += 1
+            return False
+        for b in data:
+            framer.feed(b)
+        if chunks is not None:
+            chunks.append((data, framer.latitude, framer.high_res_latitude))
+        stats["max_bytes_per_poll"] = max(stats["max_bytes_per_poll"], n)
+        first = False
+        available -= n
+    return True
+
+
+def simulate(rate, duration, quirks, seed, poll=POLL_INTERVAL, tx_ready=0, corrupt=0.0,
+             chunks=None):
+    """tx_ready is the TX-ready threshold in bytes (0 = plain polling)"""
+    rng = random.Random(seed)
+    rx = Receiver(rate, quirks, rng, corrupt=corrupt)
+    framer = UbxFramer()
+    stats = {"polls": 0, "ff": 0, "bit15": 0, "7f": 0, "max_bytes_per_poll": 0,
+             "skipped": 0}
+    # Configure and query the receiver like begin()/getProtocolVersion() do
+    rx.write(b"\xff" + ubx_frame(CLASS_CFG, 0x00, b"\x00" * 20))
+    rx.write(b"\xff" + ubx_frame(CLASS_MON, MON_VER))
+    t = 0.0
+    while t < duration:
+        rx.advance(t)
+        if tx_ready and len(rx.stream) < tx_ready:
+            stats["skipped"] += 1  # pin not asserted, no bus traffic
+        else:
+            check_ublox_i2c(rx, framer, stats, chunks)
+        t += poll
+    bus_seconds = rx.bus_bytes * 9 / I2C_BIT_RATE
+    return {
+        "mode": "txready" if tx_ready else "poll",
+        "rate_hz": rate,
+        "frames_sent": rx.frames_out,
+        "frames_parsed": framer.frames,
+        "checksum_errors": framer.checksum_errors,
+        "frames_dropped": rx.frames_dropped,
+        "polls": stats["polls"],
+        "quirk_ff": stats["ff"],
+        "quirk_7f": stats["7f"],
+        "quirk_bit15": stats["bit15"],
+        "max_bytes_per_poll": stats["max_bytes_per_poll"],
+        "polls_skipped": stats["skipped"],
+        "transactions_per_hour": int(rx.transactions * 3600 / duration),
+        "bus_occupancy_pct": round(100.0 * bus_seconds / duration, 2),
+    }
+
+
+def write_header(path, chunks, result, argv):
+    """C header of the chunks seen by process(), for test/ublox_replay"""
+    stream = b"".join(c[0] for c in chunks)
+    with open(path, "w") as f:
+        f.write("// Generated by tools/ublox_emulator.py %s\n" % " ".join(argv))
+        f.write("// Do not edit; regenerate after changing the emulator or the driver\n\n")
+        f.write("#define REPLAY_CHUNKS %d\n" % len(chunks))
+        f.write("#define REPLAY_FRAMES %d\n" % result["frames_parsed"])
+        f.write("#define REPLAY_CHECKSUM_ERRORS %d\n\n" % result["checksum_errors"])
+        f.write("const uint8_t replayStream[%d] = {\n" % len(stream))
+        for i in range(0, len(stream), 16):
+            f.write("  " + ", ".join("0x%02X" % b for b in stream[i:i + 16]) + ",\n")
+        f.write("};\n\n")
+        f.write("// Chunk length, NAV-PVT latitude and NAV-HPPOSLLH latitude after the chunk\n")
+        f.write("const struct { uint16_t length; int32_t latitude; int32_t highResLatitude; }"
+                " replayChunks[REPLAY_CHUNKS] = {\n")
+        for data, lat, hp_lat in chunks:
+            f.write("  {%d, %d, %d},\n" % (len(data), lat, hp_lat))
+        f.write("};\n")
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    p.add_argument("--rate", type=float, default=1.0, help="navigation rate (Hz)")
+    p.add_argument("--duration", type=float, default=60.0, help="simulated seconds")
+    p.add_argument("--quirk-ff", type=float, default=0.0)
+    p.add_argument("--quirk-7f", type=float, default=0.0)
+    p.add_argument("--quirk-bit15", type=float, default=0.0)
+    p.add_argument("--poll-ms", type=float, default=POLL_INTERVAL * 1000)
+    p.add_argument("--tx-ready", action="store_true", help="model the TX-ready pin")
+    p.add_argument("--tx-ready-threshold", type=int, default=8,
+                   help="TX-ready threshold in bytes (default %(default)s)")
+    p.add_argument("--bench", action="store_true",
+                   help="sweep 1-25 Hz, polled and TX-ready, and print CSV")
+    p.add_argument("--corrupt", type=float, default=0.0,
+                   help="probability of a damaged navigation frame")
+    p.add_argument("--header", metavar="FILE",
+                   help="write the chunks seen by process() as a C header")
+    p.add_argument("--seed", type=int, default=1)
+    args = p.parse_args()
+
+    quirks = {"ff": args.quirk_ff, "7f": args.quirk_7f, "bit15": args.quirk_bit15}
+    if args.header:
+        chunks = []
+        tx_ready = args.tx_ready_threshold if args.tx_ready else 0
+        result = simulate(args.rate, args.duration, quirks, args.seed, args.poll_ms / 1000,
+                          tx_ready, args.corrupt, chunks)
+        write_header(args.header, chunks, result, sys.argv[1:])
+        print("%d chunks, %d frames, %d checksum errors" % (
+            len(chunks), result["frames_parsed"], result["checksum_errors"]))
+        return 0
+    rates = (1, 2, 5, 10, 25) if args.bench else (args.rate,)
+    if args.bench:
+        modes = (0, args.tx_ready_threshold)
+    else:
+        modes = (args.tx_ready_threshold if args.tx_ready else 0,)
+    keys = None
+    for tx_ready in modes:
+        for rate in rates:
+            result = simulate(rate, args.duration, quirks, args.seed, args.poll_ms / 1000,
+                              tx_ready, args.corrupt)
+            if keys is None:
+                keys = list(result)
+                print(",".join(keys))
+            print(",".join(str(result[k]) for k in keys))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())